@@ -27,12 +27,14 @@
  * STD
  */
 
+#include "chrono"
 #include "cstdint"
 #include "iostream"
 #include "vector"
 #include "functional"
 #include "memory"
 #include "exception"
+#include "map"
 #include "utility"
 
 /*******************************************************************************
@@ -40,16 +42,28 @@
  */
 #include "mvp_msgs/ControlProcess.h"
 #include "mvp_msgs/ControlMode.h"
+#include "behavior_interface/behavior_descriptor.h"
+#include "behavior_interface/memory_resource.h"
+
+/*******************************************************************************
+ * ROS
+ */
+#include "ros/node_handle.h"
+#include "ros/this_node.h"
 
 namespace helm
 {
     class Helm;
 
+    class Shadow;
+
     class BehaviorBase {
     private:
 
         friend class Helm;
 
+        friend class Shadow;
+
         friend class BehaviorContainer;
 
         /**
@@ -77,6 +91,11 @@ namespace helm
          */
         std::vector<int> m_active_dofs;
 
+        /**
+         * @brief Helm sets this to false when it is shedding load
+         */
+        bool m_visualization_enabled = true;
+
         /**
          * @brief Behaviors calls this function to request a state change from
          *        MVP-Helm.
@@ -86,6 +105,78 @@ namespace helm
          */
         std::function<bool(const std::string&)> f_change_state;
 
+        /**
+         * @brief Queues a job to the worker pool of the MVP-Helm.
+         *
+         * This function is set during the runtime to map one of the functions
+         * from MVP-Helm.
+         */
+        std::function<bool(std::function<void()>)> f_submit_work;
+
+        /**
+         * @brief The time #BehaviorBase::request_set_point should return by
+         */
+        std::chrono::steady_clock::time_point m_deadline;
+
+        /**
+         * @brief Function pointer to report the path of the behavior
+         *
+         * This function is set during the runtime to map one of the functions
+         * from MVP-Helm.
+         */
+        std::function<void(const std::vector<double>&,
+                           const std::vector<double>&, double)> f_report_path;
+
+        /**
+         * @brief Function pointer to report the waypoint the behavior heads to
+         *
+         * This function is set during the runtime to map one of the functions
+         * from MVP-Helm.
+         */
+        std::function<void(size_t)> f_report_path_target;
+
+        /**
+         * @brief Function pointer to hand a path to another behavior
+         *
+         * This function is set during the runtime to map one of the functions
+         * from MVP-Helm.
+         */
+        std::function<bool(const std::string&, const std::string&,
+                           const std::vector<double>&,
+                           const std::vector<double>&)> f_send_path;
+
+        /**
+         * @brief Function pointers to schedule and cancel the timers
+         *
+         * These functions are set during the runtime to map the timing wheel
+         * of MVP-Helm.
+         */
+        std::function<uint64_t(double, std::function<void()>, double)>
+            f_schedule_timer;
+
+        std::function<bool(uint64_t)> f_cancel_timer;
+
+        /**
+         * @brief Arena of the behavior, set by the helm before
+         *        #BehaviorBase::initialize
+         */
+        MemoryResource* m_memory_resource = nullptr;
+
+        /**
+         * @brief Queue that serves the callbacks of the node handles created
+         *        by #BehaviorBase::create_node_handle, null for the global one
+         */
+        ros::CallbackQueueInterface* m_callback_queue = nullptr;
+
+        /**
+         * @brief Parameters declared by #BehaviorBase::get_descriptor, read
+         *        by the helm before #BehaviorBase::initialize
+         */
+        std::map<std::string, parameter_value_t> m_parameters;
+
+        const parameter_value_t& f_get_parameter(
+            const std::string& name) const;
+
         void f_set_active_state(const std::string& state) {
             m_active_state = state;
             state_changed(state);
@@ -159,13 +250,285 @@ namespace helm
         */
         virtual void state_changed(const std::string& state_name) {}
 
+        /**
+         * @brief This function is triggered when the helm frequency changes
+         *
+         * The frequency is the rate the behavior is called at, it is lower
+         * than the helm's while the overload governor decimates the behavior.
+         * It is called from the helm thread before the next
+         * #BehaviorBase::request_set_point, #BehaviorBase::get_helm_frequency
+         * already returns the new value. A plugin may or may not override
+         * this function.
+         *
+         * @param frequency New helm frequency in hertz
+         */
+        virtual void helm_frequency_changed(double frequency) {}
+
+        /**
+         * @brief Writes the progress of the behavior for a standby helm
+         *
+         * Called from the helm thread after every iteration when the status
+         * page is enabled, it must only copy a few fields. A standby helm
+         * passes the bytes to #BehaviorBase::load_checkpoint of its own
+         * instance. A plugin may or may not override this function.
+         *
+         * @param data Output
+         * @param size Capacity of @p data in bytes
+         * @return Number of bytes written, 0 if there is no checkpoint
+         */
+        virtual size_t save_checkpoint(uint8_t* data, size_t size) {
+            return 0;
+        }
+
+        /**
+         * @brief Restores the progress saved by the behavior of the primary
+         *        helm
+         *
+         * Called from the helm thread of a standby helm when the checkpoint
+         * changes and after the behavior is activated. A plugin may or may
+         * not override this function.
+         *
+         * @param data
+         * @param size Number of bytes
+         */
+        virtual void load_checkpoint(const uint8_t* data, size_t size) {}
+
         virtual auto change_state(const std::string& state) -> bool final {
             return f_change_state(state);
         }
 
         virtual double get_helm_frequency() final { return m_helm_frequency; }
 
-        virtual auto configure_dofs() -> decltype(m_dofs) {return decltype(m_dofs)();};
+        /**
+         * @brief Remaining time budget of the current iteration in seconds
+         *
+         * Helm gives each behavior a share of its period before calling
+         * #BehaviorBase::request_set_point. A behavior with heavy computation,
+         * such as a planner, can refine its solution incrementally while the
+         * budget is positive and then return the best answer it has so far.
+         *
+         * @code{.cpp}
+         * while(get_time_budget() > 0 && m_planner.refine()) {}
+         * *set_point = m_planner.best();
+         * @endcode
+         *
+         * @return seconds, negative if the budget is already exceeded
+         */
+        virtual double get_time_budget() final {
+            return std::chrono::duration<double>(
+                m_deadline - std::chrono::steady_clock::now()).count();
+        }
+
+        /**
+         * @brief Hands a job to the worker pool shared by all behaviors
+         *
+         * Jobs run on low priority threads between and during the helm
+         * iterations. A behavior may use it to keep working on a solution
+         * after #BehaviorBase::request_set_point returns. Synchronization of
+         * the data shared with the job is the behavior's responsibility.
+         *
+         * @param job
+         * @return false if the job is not accepted, e.g. the pool is disabled
+         *         or busy. Behavior should do the work in its own budget then.
+         */
+        virtual bool submit_work(std::function<void()> job) final {
+            if(!f_submit_work) {
+                return false;
+            }
+            return f_submit_work(std::move(job));
+        }
+
+        /**
+         * @brief Whether the behavior may spend time on visualization and
+         *        logging.
+         *
+         * Helm turns this off when iterations overrun the helm period. A
+         * behavior should skip its visualization and verbose logging while
+         * this returns false.
+         */
+        virtual bool visualization_enabled() final {
+            return m_visualization_enabled;
+        }
+
+        /**
+         * @brief Report the path that the behavior follows
+         *
+         * Helm estimates the distance, time and energy left on the last
+         * reported path. Path should be reported when it changes, it is
+         * copied.
+         *
+         * @param x Waypoints in the frame of the controller
+         * @param y Waypoints in the frame of the controller
+         * @param speed Planned speed in m/s
+         */
+        virtual void report_path(const std::vector<double>& x,
+                                 const std::vector<double>& y,
+                                 double speed) final {
+            if(f_report_path) {
+                f_report_path(x, y, speed);
+            }
+        }
+
+        /**
+         * @brief Report the index of the waypoint that the vehicle heads to
+         *
+         * @param index Index in the last reported path
+         */
+        virtual void report_path_target(size_t index) final {
+            if(f_report_path_target) {
+                f_report_path_target(index);
+            }
+        }
+
+        /**
+         * @brief Hands a path to another behavior of the same helm
+         *
+         * The path is passed in the calling thread, the receiving behavior
+         * has it when this function returns. A state change requested right
+         * after it activates the receiver on the new path.
+         *
+         * @param behavior Name of the receiving behavior in the configuration
+         * @param frame_id Frame of the waypoints
+         * @param x Waypoints
+         * @param y Waypoints
+         * @return false if there is no such behavior or it doesn't accept
+         *         the path
+         */
+        virtual bool send_path(const std::string& behavior,
+                               const std::string& frame_id,
+                               const std::vector<double>& x,
+                               const std::vector<double>& y) final {
+            if(!f_send_path) {
+                return false;
+            }
+            return f_send_path(behavior, frame_id, x, y);
+        }
+
+        /**
+         * @brief Receives a path from #BehaviorBase::send_path of another
+         *        behavior
+         *
+         * Called from the thread of the sender, usually the helm thread. A
+         * path following behavior replaces its waypoints with the path. A
+         * plugin may or may not override this function.
+         *
+         * @param frame_id Frame of the waypoints
+         * @param x Waypoints
+         * @param y Waypoints
+         * @return true if the path is accepted
+         */
+        virtual bool path_received(const std::string& frame_id,
+                                   const std::vector<double>& x,
+                                   const std::vector<double>& y) {
+            return false;
+        }
+
+        /**
+         * @brief Schedules a timer on the timing wheel of the helm
+         *
+         * Callback is called from the helm thread at the first tick after the
+         * delay, before the set points are requested. A behavior should use
+         * it rather than checking the clock at every
+         * #BehaviorBase::request_set_point.
+         *
+         * @code{.cpp}
+         * m_timer = schedule_timer(m_duration, [this] {
+         *     change_state(m_transition_to);
+         * });
+         * @endcode
+         *
+         * @param delay Seconds until the first call
+         * @param callback
+         * @param period Seconds between the calls, 0 for a single call
+         * @return Identifier of the timer, 0 if the helm doesn't provide
+         *         timers
+         */
+        virtual uint64_t schedule_timer(double delay,
+                                        std::function<void()> callback,
+                                        double period = 0) final {
+            if(!f_schedule_timer) {
+                return 0;
+            }
+            return f_schedule_timer(delay, std::move(callback), period);
+        }
+
+        /**
+         * @brief Cancels a timer scheduled by #BehaviorBase::schedule_timer
+         *
+         * @param id Identifier of the timer, 0 is ignored
+         * @return false if there is no such timer, e.g. it already fired
+         */
+        virtual bool cancel_timer(uint64_t id) final {
+            if(!f_cancel_timer || id == 0) {
+                return false;
+            }
+            return f_cancel_timer(id);
+        }
+
+        /**
+         * @brief Memory resource of the behavior
+         *
+         * Helm gives each behavior its own arena and reports its usage and
+         * high water mark on the status page. Containers that hold the state
+         * of the behavior, such as paths and samples, should allocate from
+         * it so that the memory of each plugin can be told apart. The arena
+         * is released after the behavior is destroyed. It is available from
+         * #BehaviorBase::initialize on, global heap is returned before that.
+         *
+         * @code{.cpp}
+         * m_samples = decltype(m_samples)(get_memory_resource());
+         * @endcode
+         *
+         * @return never null
+         */
+        virtual MemoryResource* get_memory_resource() final {
+            return m_memory_resource ?
+                m_memory_resource : new_delete_resource();
+        }
+
+        /**
+         * @brief Creates a node handle for the topics, services and timers of
+         *        the behavior
+         *
+         * Callbacks of a live behavior are served by the spin thread of the
+         * helm. A shadow behavior gets the queue of the shadow thread, so
+         * that its callbacks never delay the live helm. Behaviors must use
+         * this function rather than constructing #ros::NodeHandle directly.
+         *
+         * @param ns Namespace of the node handle
+         */
+        virtual ros::NodeHandlePtr create_node_handle(
+            const std::string& ns) final
+        {
+            ros::NodeHandlePtr nh(new ros::NodeHandle(ns));
+            if(m_callback_queue != nullptr) {
+                nh->setCallbackQueue(m_callback_queue);
+            }
+            return nh;
+        }
+
+        /**
+         * @brief Creates a node handle in the namespace of the behavior,
+         *        "<helm node>/<behavior name>"
+         */
+        virtual ros::NodeHandlePtr create_node_handle() final {
+            return create_node_handle(
+                ros::this_node::getName() + "/" + m_name);
+        }
+
+        /**
+         * @brief Value of a parameter declared by the descriptor
+         *
+         * Parameters are read and checked by the helm before
+         * #BehaviorBase::initialize, see #helm::behavior_descriptor_t.
+         *
+         * @tparam T bool, int, double or std::string, as declared
+         * @param name
+         * @return value, or the default if it is not set
+         * @throws BehaviorException if the parameter is not declared
+         */
+        template<typename T>
+        T get_parameter(const std::string& name) const;
 
     public:
 
@@ -186,6 +549,18 @@ namespace helm
 
         virtual auto get_name() -> std::string final { return m_name; }
 
+        /**
+         * @brief Compile time description of the behavior
+         *
+         * A behavior that provides it doesn't fill #BehaviorBase::m_dofs or
+         * read its parameters itself, see #helm::behavior_descriptor_t.
+         *
+         * @return null if the behavior has no descriptor
+         */
+        virtual const behavior_descriptor_t* get_descriptor() const {
+            return nullptr;
+        }
+
         virtual ~BehaviorBase() = default;
 
         /**
@@ -240,4 +615,43 @@ namespace helm
         }
 
     };
+
+    inline const parameter_value_t& BehaviorBase::f_get_parameter(
+        const std::string& name) const
+    {
+        auto it = m_parameters.find(name);
+        if(it == m_parameters.end()) {
+            throw BehaviorException("Parameter '" + name + "' is not declared"
+                " by the behavior");
+        }
+        return it->second;
+    }
+
+    template<>
+    inline bool BehaviorBase::get_parameter<bool>(
+        const std::string& name) const
+    {
+        return f_get_parameter(name).number != 0;
+    }
+
+    template<>
+    inline int BehaviorBase::get_parameter<int>(
+        const std::string& name) const
+    {
+        return static_cast<int>(f_get_parameter(name).number);
+    }
+
+    template<>
+    inline double BehaviorBase::get_parameter<double>(
+        const std::string& name) const
+    {
+        return f_get_parameter(name).number;
+    }
+
+    template<>
+    inline std::string BehaviorBase::get_parameter<std::string>(
+        const std::string& name) const
+    {
+        return f_get_parameter(name).string;
+    }
 }
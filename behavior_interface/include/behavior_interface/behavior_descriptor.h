@@ -0,0 +1,326 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#pragma once
+
+/*******************************************************************************
+ * STD
+ */
+#include "cstddef"
+#include "cstdint"
+#include "limits"
+#include "map"
+#include "stdexcept"
+#include "string"
+#include "vector"
+
+/*******************************************************************************
+ * ROS
+ */
+#include "ros/node_handle.h"
+
+namespace helm
+{
+    enum class ParameterType : uint8_t {
+        BOOL,
+        INT,
+        DOUBLE,
+        STRING
+    };
+
+    /**
+     * @brief A parameter of a behavior, read from the namespace of the
+     *        behavior, e.g. `/helm/bhv_depth/desired_depth`
+     */
+    struct parameter_descriptor_t {
+        //! @brief Name relative to the behavior, may contain '/'
+        const char* name;
+        ParameterType type;
+        //! @brief Default of the bool, int and double parameters
+        double default_value;
+        //! @brief Default of the string parameters
+        const char* default_string;
+        //! @brief Smallest value of the int and double parameters
+        double min;
+        //! @brief Largest value of the int and double parameters
+        double max;
+        const char* description;
+    };
+
+    constexpr parameter_descriptor_t parameter_bool(
+        const char* name, bool default_value, const char* description)
+    {
+        return {name, ParameterType::BOOL, default_value ? 1.0 : 0.0, "",
+            0, 1, description};
+    }
+
+    constexpr parameter_descriptor_t parameter_int(
+        const char* name, int default_value, int min, int max,
+        const char* description)
+    {
+        return {name, ParameterType::INT, static_cast<double>(default_value),
+            "", static_cast<double>(min), static_cast<double>(max),
+            description};
+    }
+
+    constexpr parameter_descriptor_t parameter_double(
+        const char* name, double default_value,
+        double min, double max, const char* description)
+    {
+        return {name, ParameterType::DOUBLE, default_value, "", min, max,
+            description};
+    }
+
+    constexpr parameter_descriptor_t parameter_double(
+        const char* name, double default_value, const char* description)
+    {
+        return parameter_double(name, default_value,
+            -std::numeric_limits<double>::infinity(),
+            std::numeric_limits<double>::infinity(), description);
+    }
+
+    constexpr parameter_descriptor_t parameter_string(
+        const char* name, const char* default_value, const char* description)
+    {
+        return {name, ParameterType::STRING, 0, default_value, 0, 0,
+            description};
+    }
+
+    enum class TopicDirection : uint8_t {
+        INPUT,
+        OUTPUT
+    };
+
+    /**
+     * @brief A topic that the behavior subscribes or publishes, relative to
+     *        the namespace of the behavior
+     *
+     * Name of the topic is either fixed or set by a string parameter of the
+     * behavior. Helm validates the configured name of the latter before the
+     * behavior subscribes to it, an empty name means the topic is not used.
+     */
+    struct topic_descriptor_t {
+        //! @brief Fixed name, empty if #topic_descriptor_t::parameter is set
+        const char* name;
+        //! @brief String parameter that holds the name, empty if it is fixed
+        const char* parameter;
+        //! @brief Message type, e.g. "std_msgs/Float64"
+        const char* type;
+        TopicDirection direction;
+        const char* description;
+    };
+
+    constexpr topic_descriptor_t input_topic(
+        const char* name, const char* type, const char* description)
+    {
+        return {name, "", type, TopicDirection::INPUT, description};
+    }
+
+    constexpr topic_descriptor_t output_topic(
+        const char* name, const char* type, const char* description)
+    {
+        return {name, "", type, TopicDirection::OUTPUT, description};
+    }
+
+    //! @brief Input topic named by the string parameter @p parameter
+    constexpr topic_descriptor_t configured_input_topic(
+        const char* parameter, const char* type, const char* description)
+    {
+        return {"", parameter, type, TopicDirection::INPUT, description};
+    }
+
+    //! @brief Output topic named by the string parameter @p parameter
+    constexpr topic_descriptor_t configured_output_topic(
+        const char* parameter, const char* type, const char* description)
+    {
+        return {"", parameter, type, TopicDirection::OUTPUT, description};
+    }
+
+    /**
+     * @brief Bit mask of the DOFs, indexed as mvp_msgs::ControlMode::DOF_*
+     *
+     * @code{.cpp}
+     * dof_mask(mvp_msgs::ControlMode::DOF_Z, mvp_msgs::ControlMode::DOF_PITCH)
+     * @endcode
+     */
+    constexpr uint16_t dof_mask() {
+        return 0;
+    }
+
+    template<typename... Dofs>
+    constexpr uint16_t dof_mask(int dof, Dofs... dofs) {
+        return static_cast<uint16_t>((1u << dof) | dof_mask(dofs...));
+    }
+
+    /**
+     * @brief Interface of a behavior that is known at compile time
+     *
+     * Helm reads it right after the plugin is loaded and before
+     * #BehaviorBase::initialize. It sets the DOFs of the behavior, reads and
+     * checks the parameters, and checks the arbitration of every state.
+     * Mistakes in the mission configuration are then reported at the start
+     * rather than when a state is entered. The descriptor is built with
+     * #helm::make_descriptor, which refuses to compile if a default is out
+     * of its range, a parameter is declared twice or a topic is named by a
+     * parameter that is not a declared string.
+     *
+     * @code{.cpp}
+     * // depth_tracking.h
+     * static constexpr parameter_descriptor_t PARAMETERS[] = {
+     *     parameter_double("max_pitch", M_PI_2, 0, M_PI_2, "radians")
+     * };
+     *
+     * static constexpr behavior_descriptor_t DESCRIPTOR = make_descriptor(
+     *     dof_mask(mvp_msgs::ControlMode::DOF_Z), PARAMETERS);
+     *
+     * const behavior_descriptor_t* get_descriptor() const override {
+     *     return &DESCRIPTOR;
+     * }
+     *
+     * // depth_tracking.cpp
+     * constexpr parameter_descriptor_t DepthTracking::PARAMETERS[];
+     *
+     * constexpr behavior_descriptor_t DepthTracking::DESCRIPTOR;
+     * @endcode
+     */
+    struct behavior_descriptor_t {
+        uint16_t dofs;
+        const parameter_descriptor_t* parameters;
+        size_t parameter_count;
+        const topic_descriptor_t* topics;
+        size_t topic_count;
+    };
+
+    namespace detail {
+
+        /**
+         * Single return statements, the plugins built as C++11 include this
+         * header as well
+         */
+        constexpr bool equal(const char* a, const char* b) {
+            return *a == *b && (*a == '\0' || equal(a + 1, b + 1));
+        }
+
+        constexpr bool in_range(const parameter_descriptor_t& p) {
+            return p.type == ParameterType::STRING ||
+                (p.default_value >= p.min && p.default_value <= p.max);
+        }
+
+        //! @brief True if parameter @p i is named unlike the first @p j
+        constexpr bool unique(const parameter_descriptor_t* parameters,
+                              size_t i, size_t j) {
+            return j == 0 ||
+                (!equal(parameters[i].name, parameters[j - 1].name) &&
+                    unique(parameters, i, j - 1));
+        }
+
+        constexpr bool check_parameters(
+            const parameter_descriptor_t* parameters, size_t count)
+        {
+            return count == 0 ||
+                (check_parameters(parameters, count - 1) &&
+                    in_range(parameters[count - 1]) &&
+                    unique(parameters, count - 1, count - 1));
+        }
+
+        //! @brief True if one of the first @p count is a string @p name
+        constexpr bool declares_string(
+            const parameter_descriptor_t* parameters, size_t count,
+            const char* name)
+        {
+            return count != 0 &&
+                ((parameters[count - 1].type == ParameterType::STRING &&
+                    equal(parameters[count - 1].name, name)) ||
+                        declares_string(parameters, count - 1, name));
+        }
+
+        constexpr bool check_topics(
+            const topic_descriptor_t* topics, size_t count,
+            const parameter_descriptor_t* parameters, size_t parameter_count)
+        {
+            return count == 0 ||
+                (check_topics(topics, count - 1, parameters, parameter_count)
+                    && (*topics[count - 1].parameter == '\0' ||
+                        declares_string(parameters, parameter_count,
+                            topics[count - 1].parameter)));
+        }
+
+    }
+
+    template<size_t P, size_t T>
+    constexpr behavior_descriptor_t make_descriptor(
+        uint16_t dofs,
+        const parameter_descriptor_t (&parameters)[P],
+        const topic_descriptor_t (&topics)[T])
+    {
+        return detail::check_parameters(parameters, P) &&
+            detail::check_topics(topics, T, parameters, P) ?
+                behavior_descriptor_t{dofs, parameters, P, topics, T} :
+                throw std::invalid_argument("parameter default is out of its"
+                    " range, parameter is declared twice or topic is named by"
+                    " an undeclared string parameter");
+    }
+
+    template<size_t P>
+    constexpr behavior_descriptor_t make_descriptor(
+        uint16_t dofs,
+        const parameter_descriptor_t (&parameters)[P])
+    {
+        return detail::check_parameters(parameters, P) ?
+            behavior_descriptor_t{dofs, parameters, P, nullptr, 0} :
+            throw std::invalid_argument("parameter default is out of its"
+                " range or parameter is declared twice");
+    }
+
+    constexpr behavior_descriptor_t make_descriptor(uint16_t dofs) {
+        return behavior_descriptor_t{dofs, nullptr, 0, nullptr, 0};
+    }
+
+    /**
+     * @brief Value of a parameter, #parameter_value_t::number holds the
+     *        bool, int and double parameters
+     */
+    struct parameter_value_t {
+        double number;
+        std::string string;
+    };
+
+    /**
+     * @brief Reads the parameters of a descriptor
+     *
+     * Missing parameters take their defaults. Parameters in the namespace
+     * that the descriptor doesn't declare are warned about, they are
+     * usually misspelled.
+     *
+     * @param nh Node handle in the namespace of the behavior
+     * @param descriptor
+     * @param values Output, by parameter name
+     * @return Parameters of a wrong type or out of range, empty if all of
+     *         them are valid
+     */
+    std::vector<std::string> load_parameters(
+        const ros::NodeHandle& nh,
+        const behavior_descriptor_t& descriptor,
+        std::map<std::string, parameter_value_t>* values);
+
+}
@@ -0,0 +1,277 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#pragma once
+
+/*******************************************************************************
+ * STD
+ */
+#include "array"
+#include "cstddef"
+#include "cstdint"
+#include "limits"
+#include "memory"
+#include "mutex"
+#include "new"
+#include "type_traits"
+
+namespace helm
+{
+    /**
+     * @brief Source of memory for the containers of a behavior
+     *
+     * Same interface as `std::pmr::memory_resource` of C++17, which is not
+     * available to the C++14 packages.
+     */
+    class MemoryResource {
+    public:
+
+        virtual ~MemoryResource() = default;
+
+        void* allocate(size_t bytes,
+                       size_t alignment = alignof(std::max_align_t)) {
+            return do_allocate(bytes, alignment);
+        }
+
+        void deallocate(void* p, size_t bytes,
+                        size_t alignment = alignof(std::max_align_t)) {
+            do_deallocate(p, bytes, alignment);
+        }
+
+        bool is_equal(const MemoryResource& other) const noexcept {
+            return do_is_equal(other);
+        }
+
+    protected:
+
+        virtual void* do_allocate(size_t bytes, size_t alignment) = 0;
+
+        virtual void do_deallocate(
+            void* p, size_t bytes, size_t alignment) = 0;
+
+        virtual bool do_is_equal(const MemoryResource& other) const noexcept {
+            return this == &other;
+        }
+
+    };
+
+    inline bool operator==(const MemoryResource& a, const MemoryResource& b) {
+        return &a == &b || a.is_equal(b);
+    }
+
+    inline bool operator!=(const MemoryResource& a, const MemoryResource& b) {
+        return !(a == b);
+    }
+
+    /**
+     * @brief Resource that uses the global operator new and delete
+     */
+    MemoryResource* new_delete_resource() noexcept;
+
+    /**
+     * @brief Allocation counters of a #helm::ArenaResource
+     */
+    struct memory_stats_t {
+        //! @brief Bytes allocated and not deallocated yet
+        uint64_t in_use;
+        //! @brief Highest #memory_stats_t::in_use since the construction
+        uint64_t high_water;
+        //! @brief Bytes taken from the upstream resource, including the
+        //!        free blocks kept for reuse
+        uint64_t reserved;
+        //! @brief Number of allocations since the construction
+        uint64_t allocations;
+    };
+
+    /**
+     * @brief Arena that keeps the memory of one behavior together
+     *
+     * Helm gives each behavior its own arena, see
+     * #BehaviorBase::get_memory_resource. Small blocks are carved from
+     * 64 KiB chunks and recycled by size class, larger ones go to the
+     * upstream resource. Everything is returned to the upstream resource at
+     * once when the arena is released or destroyed, after the behavior is
+     * unloaded. It is thread safe, behaviors may allocate from their
+     * subscriber callbacks and worker jobs as well.
+     */
+    class ArenaResource : public MemoryResource {
+    public:
+
+        typedef std::shared_ptr<ArenaResource> Ptr;
+
+        //! @brief Blocks larger than this are allocated from upstream
+        static constexpr size_t MAX_BLOCK = 4096;
+
+        //! @brief Size of the chunks that the small blocks are carved from
+        static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+        explicit ArenaResource(
+            MemoryResource* upstream = new_delete_resource());
+
+        ArenaResource(const ArenaResource&) = delete;
+
+        ArenaResource& operator=(const ArenaResource&) = delete;
+
+        ~ArenaResource() override;
+
+        /**
+         * @brief Returns all the memory to the upstream resource
+         *
+         * Every block allocated from the arena becomes invalid. High water
+         * mark and allocation count are kept.
+         */
+        void release();
+
+        memory_stats_t get_stats() const;
+
+    protected:
+
+        void* do_allocate(size_t bytes, size_t alignment) override;
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+
+    private:
+
+        //! @brief Size classes are 16, 32, ... #ArenaResource::MAX_BLOCK
+        static constexpr size_t CLASS_COUNT = 9;
+
+        struct free_block_t {
+            free_block_t* next;
+        };
+
+        //! @brief Header of the chunks and the large blocks
+        struct upstream_block_t {
+            upstream_block_t* prev;
+            upstream_block_t* next;
+            size_t size;
+            size_t alignment;
+        };
+
+        MemoryResource* m_upstream;
+
+        mutable std::mutex m_mutex;
+
+        std::array<free_block_t*, CLASS_COUNT> m_free;
+
+        //! @brief Chunks and large blocks taken from upstream
+        upstream_block_t* m_blocks;
+
+        //! @brief Unused part of the last chunk
+        char* m_cursor;
+
+        char* m_end;
+
+        memory_stats_t m_stats;
+
+        /**
+         * @brief Index of the size class, #ArenaResource::CLASS_COUNT if the
+         *        block is large
+         */
+        static size_t f_size_class(size_t bytes, size_t alignment);
+
+        static size_t f_header_size(size_t alignment);
+
+        void* f_allocate_upstream(size_t bytes, size_t alignment);
+
+        void f_deallocate_upstream(void* p, size_t alignment);
+
+    };
+
+    /**
+     * @brief Allocator of the standard containers that draws from a
+     *        #helm::MemoryResource
+     *
+     * Same as `std::pmr::polymorphic_allocator` of C++17, except that the
+     * resource follows the container on assignment and swap. A member can
+     * then be moved to the arena of the behavior in
+     * #BehaviorBase::initialize:
+     *
+     * @code{.cpp}
+     * std::vector<double, PolymorphicAllocator<double>> m_samples;
+     *
+     * m_samples = decltype(m_samples)(get_memory_resource());
+     * @endcode
+     */
+    template<typename T>
+    class PolymorphicAllocator {
+    public:
+
+        typedef T value_type;
+
+        typedef std::true_type propagate_on_container_copy_assignment;
+
+        typedef std::true_type propagate_on_container_move_assignment;
+
+        typedef std::true_type propagate_on_container_swap;
+
+        /**
+         * @brief Rebinding of the pre C++11 allocators, the generated ROS
+         *        messages use it for their fields
+         */
+        template<typename U>
+        struct rebind {
+            typedef PolymorphicAllocator<U> other;
+        };
+
+        PolymorphicAllocator() noexcept
+            : m_resource(new_delete_resource()) {}
+
+        PolymorphicAllocator(MemoryResource* resource) noexcept
+            : m_resource(resource ? resource : new_delete_resource()) {}
+
+        template<typename U>
+        PolymorphicAllocator(const PolymorphicAllocator<U>& other) noexcept
+            : m_resource(other.resource()) {}
+
+        T* allocate(size_t n) {
+            if(n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T*>(
+                m_resource->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* p, size_t n) {
+            m_resource->deallocate(p, n * sizeof(T), alignof(T));
+        }
+
+        MemoryResource* resource() const noexcept { return m_resource; }
+
+    private:
+
+        MemoryResource* m_resource;
+
+    };
+
+    template<typename T, typename U>
+    bool operator==(const PolymorphicAllocator<T>& a,
+                    const PolymorphicAllocator<U>& b) {
+        return *a.resource() == *b.resource();
+    }
+
+    template<typename T, typename U>
+    bool operator!=(const PolymorphicAllocator<T>& a,
+                    const PolymorphicAllocator<U>& b) {
+        return !(a == b);
+    }
+}
@@ -0,0 +1,146 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#pragma once
+
+/*******************************************************************************
+ * STD
+ */
+#include "cstddef"
+#include "memory"
+#include "utility"
+#include "vector"
+
+/*******************************************************************************
+ * Behavior Interface
+ */
+#include "behavior_interface/memory_resource.h"
+
+namespace helm
+{
+    /**
+     * @brief Streaming Douglas-Peucker simplification of uploaded paths
+     *
+     * Planners may send very dense paths in chunks. Every point that is
+     * dropped is within the tolerance of the simplified path, measured as the
+     * distance to the closest segment.
+     *
+     * Vertices of the simplified path are committed as the chunks arrive,
+     * except the last segment which may still be replaced when the next
+     * chunk extends it. Only the original points of that segment are kept,
+     * so the memory is proportional to the simplified path.
+     */
+    class PathSimplifier {
+    public:
+
+        typedef std::shared_ptr<PathSimplifier> Ptr;
+
+        struct point_t {
+            double x;
+            double y;
+        };
+
+        typedef std::vector<point_t, PolymorphicAllocator<point_t>> path_t;
+
+        /**
+         * @brief Original points of the open segment are committed as they
+         *        are once there are more than this many of them
+         */
+        static constexpr size_t MAX_TAIL = 4096;
+
+        PathSimplifier();
+
+        /**
+         * @brief Sets the tolerance
+         *
+         * @param tolerance Maximum distance of a dropped point to the path in
+         *                  meters. Points are kept as they are if it is not
+         *                  positive.
+         */
+        void set_tolerance(double tolerance);
+
+        double get_tolerance() const { return m_tolerance; }
+
+        /**
+         * @brief Keeps the points in the given resource, e.g. the arena of
+         *        the behavior. The path is cleared.
+         *
+         * @param resource
+         */
+        void set_memory_resource(MemoryResource* resource);
+
+        /**
+         * @brief Removes every point
+         */
+        void clear();
+
+        /**
+         * @brief Appends points to the end of the path
+         *
+         * @param points
+         * @param fixed Points are kept as they are if true, e.g. the
+         *              waypoints written by hand
+         */
+        void append(const std::vector<point_t>& points, bool fixed = false);
+
+        /**
+         * @brief Simplified path
+         *
+         * Vertices before #PathSimplifier::get_committed never change until
+         * the path is cleared.
+         */
+        const path_t& get_path() const { return m_path; }
+
+        //! @brief Number of vertices that won't change with the next append
+        size_t get_committed() const { return m_committed; }
+
+        //! @brief Number of points received since the last clear
+        size_t get_received() const { return m_received; }
+
+    private:
+
+        double m_tolerance;
+
+        path_t m_path;
+
+        size_t m_committed;
+
+        //! @brief Original points from the last committed vertex
+        path_t m_tail;
+
+        size_t m_received;
+
+        //! @brief Indices of the tail points that the simplified tail keeps
+        std::vector<size_t, PolymorphicAllocator<size_t>> m_keep;
+
+        std::vector<std::pair<size_t, size_t>,
+                    PolymorphicAllocator<std::pair<size_t, size_t>>> m_stack;
+
+        /**
+         * @brief Douglas-Peucker on #PathSimplifier::m_tail, fills
+         *        #PathSimplifier::m_keep in ascending order
+         */
+        void f_simplify_tail();
+
+    };
+}
@@ -0,0 +1,170 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#pragma once
+
+/*******************************************************************************
+ * STD
+ */
+#include "cstddef"
+#include "memory"
+#include "vector"
+
+namespace helm
+{
+    /**
+     * @brief Surge speed schedule for time tagged waypoints
+     *
+     * Some waypoints of a path may have a deadline, the time that the vehicle
+     * should be at that waypoint. The schedule keeps the arc length of the
+     * path from the first waypoint as a prefix table, and the index of the
+     * next waypoint with a deadline for each waypoint. The speed needed for
+     * the next deadline is then found in constant time at every iteration
+     * from the distance to the waypoint the vehicle heads to.
+     *
+     * Waypoints after the last deadline are run at the nominal speed. A
+     * deadline that has already passed is run at the maximum speed.
+     */
+    class SpeedSchedule {
+    public:
+
+        typedef std::shared_ptr<SpeedSchedule> Ptr;
+
+        /**
+         * @brief A deadline that can't be met within the speed limits
+         */
+        struct violation_t {
+            //! @brief Index of the waypoint
+            size_t index;
+            //! @brief Speed that would meet the deadline, in m/s
+            double required_speed;
+        };
+
+        SpeedSchedule();
+
+        /**
+         * @brief Sets the speed limits
+         *
+         * @param nominal Speed used when there is no deadline ahead, in m/s
+         * @param min Minimum surge speed of the vehicle, in m/s
+         * @param max Maximum surge speed of the vehicle, in m/s
+         */
+        void set_limits(double nominal, double min, double max);
+
+        /**
+         * @brief Builds the tables for a path
+         *
+         * @param x Waypoints
+         * @param y Waypoints
+         * @param deadlines Time of each waypoint in seconds, NaN if the
+         *                  waypoint has no deadline. It can be shorter than
+         *                  the path, missing ones have no deadline.
+         */
+        void set_path(const std::vector<double>& x,
+                      const std::vector<double>& y,
+                      const std::vector<double>& deadlines);
+
+        /**
+         * @brief Shifts all the deadlines by the same amount
+         *
+         * Used to start a schedule relative to the activation.
+         *
+         * @param offset seconds
+         */
+        void shift(double offset);
+
+        //! @brief True if at least one waypoint has a deadline
+        bool has_deadlines() const { return m_has_deadlines; }
+
+        /**
+         * @brief Speed to meet the next deadline, clamped to the limits
+         *
+         * Constant time, it is meant to be called at every iteration.
+         *
+         * @param target Index of the waypoint that the vehicle heads to
+         * @param distance Distance to the target waypoint in meters
+         * @param now Current time in seconds
+         * @return speed in m/s
+         */
+        double speed(size_t target, double distance, double now);
+
+        /**
+         * @brief Index of the deadline that the last speed is computed for
+         *
+         * @return index of the waypoint, or the path size if there was none
+         */
+        size_t get_deadline_index() const { return m_deadline_index; }
+
+        /**
+         * @brief Speed that the last deadline requires before the clamping
+         */
+        double get_required_speed() const { return m_required_speed; }
+
+        /**
+         * @brief True if the last speed can't meet its deadline
+         */
+        bool is_late() const { return m_late; }
+
+        /**
+         * @brief Checks every deadline ahead of the vehicle
+         *
+         * Each deadline is checked assuming the previous one is met on time.
+         * It runs in linear time, call it when the path or the target
+         * changes rather than every iteration.
+         *
+         * @param target Index of the waypoint that the vehicle heads to
+         * @param distance Distance to the target waypoint in meters
+         * @param now Current time in seconds
+         * @return deadlines that need a speed out of the limits
+         */
+        std::vector<violation_t> check(
+            size_t target, double distance, double now) const;
+
+    private:
+
+        //! @brief Arc length from the first waypoint to each waypoint
+        std::vector<double> m_arc;
+
+        //! @brief Deadline of each waypoint, NaN if there is none
+        std::vector<double> m_deadlines;
+
+        //! @brief Index of the first waypoint at or after each waypoint with
+        //!        a deadline, path size if there is none
+        std::vector<size_t> m_next;
+
+        bool m_has_deadlines;
+
+        double m_nominal;
+
+        double m_min;
+
+        double m_max;
+
+        size_t m_deadline_index;
+
+        double m_required_speed;
+
+        bool m_late;
+
+    };
+}
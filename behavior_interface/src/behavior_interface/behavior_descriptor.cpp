@@ -0,0 +1,141 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#include "behavior_interface/behavior_descriptor.h"
+
+#include "sstream"
+
+using namespace helm;
+
+namespace {
+
+    const char* type_name(ParameterType type) {
+        switch(type) {
+            case ParameterType::BOOL:
+                return "bool";
+            case ParameterType::INT:
+                return "int";
+            case ParameterType::DOUBLE:
+                return "double";
+            case ParameterType::STRING:
+                return "string";
+        }
+        return "";
+    }
+
+    /**
+     * @brief Converts a value from the parameter server
+     *
+     * @return false if the value is not of the given type. Integers are
+     *         accepted as double.
+     */
+    bool convert(XmlRpc::XmlRpcValue& value, ParameterType type,
+                 parameter_value_t* out)
+    {
+        switch(type) {
+            case ParameterType::BOOL:
+                if(value.getType() != XmlRpc::XmlRpcValue::TypeBoolean) {
+                    return false;
+                }
+                out->number = static_cast<bool>(value) ? 1.0 : 0.0;
+                return true;
+            case ParameterType::INT:
+                if(value.getType() != XmlRpc::XmlRpcValue::TypeInt) {
+                    return false;
+                }
+                out->number = static_cast<int>(value);
+                return true;
+            case ParameterType::DOUBLE:
+                if(value.getType() == XmlRpc::XmlRpcValue::TypeInt) {
+                    out->number = static_cast<int>(value);
+                    return true;
+                }
+                if(value.getType() != XmlRpc::XmlRpcValue::TypeDouble) {
+                    return false;
+                }
+                out->number = static_cast<double>(value);
+                return true;
+            case ParameterType::STRING:
+                if(value.getType() != XmlRpc::XmlRpcValue::TypeString) {
+                    return false;
+                }
+                out->string = static_cast<std::string>(value);
+                return true;
+        }
+        return false;
+    }
+
+}
+
+std::vector<std::string> helm::load_parameters(
+    const ros::NodeHandle& nh,
+    const behavior_descriptor_t& descriptor,
+    std::map<std::string, parameter_value_t>* values)
+{
+    std::vector<std::string> errors;
+
+    values->clear();
+
+    for(size_t i = 0 ; i < descriptor.parameter_count ; i++) {
+        const auto& p = descriptor.parameters[i];
+
+        parameter_value_t value{p.default_value, p.default_string};
+
+        XmlRpc::XmlRpcValue xml;
+        if(nh.getParam(p.name, xml)) {
+            if(!convert(xml, p.type, &value)) {
+                errors.emplace_back(std::string(p.name) + " must be a " +
+                    type_name(p.type));
+            } else if(p.type != ParameterType::STRING &&
+                (value.number < p.min || value.number > p.max)) {
+                std::stringstream ss;
+                ss << p.name << " is " << value.number << ", it must be"
+                   " between " << p.min << " and " << p.max;
+                errors.emplace_back(ss.str());
+            }
+        }
+
+        (*values)[p.name] = value;
+    }
+
+    /**
+     * Anything else in the namespace of the behavior is most likely a typo
+     */
+    std::vector<std::string> names;
+    auto prefix = nh.getNamespace() + "/";
+    if(descriptor.parameter_count > 0 && nh.getParamNames(names)) {
+        for(const auto& name : names) {
+            if(name.compare(0, prefix.size(), prefix) != 0) {
+                continue;
+            }
+            auto relative = name.substr(prefix.size());
+            if(!values->count(relative)) {
+                ROS_WARN_STREAM(nh.getNamespace() << ": parameter '" <<
+                    relative << "' is not declared by the behavior, it is"
+                    " ignored");
+            }
+        }
+    }
+
+    return errors;
+}
@@ -0,0 +1,234 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#include "behavior_interface/memory_resource.h"
+
+#include "algorithm"
+
+using namespace helm;
+
+namespace {
+
+    constexpr size_t MIN_ALIGNMENT = alignof(std::max_align_t);
+
+    constexpr size_t MIN_BLOCK = 16;
+
+    size_t round_up(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    /**
+     * @brief Global operator new, over-aligned blocks keep the pointer that
+     *        operator new returned right before them
+     */
+    class NewDeleteResource : public MemoryResource {
+    protected:
+
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            if(alignment <= MIN_ALIGNMENT) {
+                return ::operator new(bytes);
+            }
+
+            auto raw = static_cast<char*>(
+                ::operator new(bytes + alignment));
+            auto p = reinterpret_cast<char*>(round_up(
+                reinterpret_cast<uintptr_t>(raw) + sizeof(void*), alignment));
+            reinterpret_cast<void**>(p)[-1] = raw;
+            return p;
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+            if(alignment <= MIN_ALIGNMENT) {
+                ::operator delete(p);
+            } else {
+                ::operator delete(static_cast<void**>(p)[-1]);
+            }
+        }
+
+    };
+
+}
+
+MemoryResource* helm::new_delete_resource() noexcept {
+    static NewDeleteResource resource;
+    return &resource;
+}
+
+constexpr size_t ArenaResource::MAX_BLOCK;
+
+constexpr size_t ArenaResource::CHUNK_SIZE;
+
+constexpr size_t ArenaResource::CLASS_COUNT;
+
+ArenaResource::ArenaResource(MemoryResource *upstream) :
+    m_upstream(upstream ? upstream : new_delete_resource()),
+    m_free{},
+    m_blocks(nullptr),
+    m_cursor(nullptr),
+    m_end(nullptr),
+    m_stats{}
+{
+    static_assert(MIN_BLOCK << (CLASS_COUNT - 1) == MAX_BLOCK,
+        "size classes must end at MAX_BLOCK");
+}
+
+ArenaResource::~ArenaResource() {
+    release();
+}
+
+void ArenaResource::release() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    while(m_blocks != nullptr) {
+        auto block = m_blocks;
+        m_blocks = block->next;
+        m_upstream->deallocate(block, block->size, block->alignment);
+    }
+
+    m_free.fill(nullptr);
+    m_cursor = m_end = nullptr;
+    m_stats.in_use = 0;
+    m_stats.reserved = 0;
+}
+
+memory_stats_t ArenaResource::get_stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+size_t ArenaResource::f_size_class(size_t bytes, size_t alignment) {
+    if(bytes > MAX_BLOCK || alignment > MIN_ALIGNMENT) {
+        return CLASS_COUNT;
+    }
+
+    size_t c = 0;
+    while((MIN_BLOCK << c) < bytes) {
+        c++;
+    }
+    return c;
+}
+
+size_t ArenaResource::f_header_size(size_t alignment) {
+    return round_up(sizeof(upstream_block_t),
+        std::max(alignment, MIN_ALIGNMENT));
+}
+
+void* ArenaResource::f_allocate_upstream(size_t bytes, size_t alignment) {
+    alignment = std::max(alignment, MIN_ALIGNMENT);
+    auto header = f_header_size(alignment);
+
+    auto block = static_cast<upstream_block_t*>(
+        m_upstream->allocate(header + bytes, alignment));
+    block->prev = nullptr;
+    block->next = m_blocks;
+    block->size = header + bytes;
+    block->alignment = alignment;
+    if(m_blocks != nullptr) {
+        m_blocks->prev = block;
+    }
+    m_blocks = block;
+
+    m_stats.reserved += block->size;
+
+    return reinterpret_cast<char*>(block) + header;
+}
+
+void ArenaResource::f_deallocate_upstream(void *p, size_t alignment) {
+    auto block = reinterpret_cast<upstream_block_t*>(
+        static_cast<char*>(p) - f_header_size(alignment));
+
+    if(block->prev != nullptr) {
+        block->prev->next = block->next;
+    } else {
+        m_blocks = block->next;
+    }
+    if(block->next != nullptr) {
+        block->next->prev = block->prev;
+    }
+
+    m_stats.reserved -= block->size;
+
+    m_upstream->deallocate(block, block->size, block->alignment);
+}
+
+void* ArenaResource::do_allocate(size_t bytes, size_t alignment) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto c = f_size_class(bytes, alignment);
+
+    void* p;
+    if(c == CLASS_COUNT) {
+        p = f_allocate_upstream(bytes, alignment);
+    } else if(m_free[c] != nullptr) {
+        p = m_free[c];
+        m_free[c] = m_free[c]->next;
+    } else {
+        auto size = MIN_BLOCK << c;
+        if(static_cast<size_t>(m_end - m_cursor) < size) {
+            /**
+             * Leftover of the last chunk goes to the free lists
+             */
+            for(size_t k = CLASS_COUNT ; k-- > 0 ; ) {
+                while(static_cast<size_t>(m_end - m_cursor) >=
+                        (MIN_BLOCK << k)) {
+                    auto block = reinterpret_cast<free_block_t*>(m_cursor);
+                    block->next = m_free[k];
+                    m_free[k] = block;
+                    m_cursor += MIN_BLOCK << k;
+                }
+            }
+
+            m_cursor = static_cast<char*>(
+                f_allocate_upstream(CHUNK_SIZE, MIN_ALIGNMENT));
+            m_end = m_cursor + CHUNK_SIZE;
+        }
+        p = m_cursor;
+        m_cursor += size;
+    }
+
+    m_stats.in_use += bytes;
+    m_stats.high_water = std::max(m_stats.high_water, m_stats.in_use);
+    m_stats.allocations++;
+
+    return p;
+}
+
+void ArenaResource::do_deallocate(void *p, size_t bytes, size_t alignment) {
+    if(p == nullptr) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto c = f_size_class(bytes, alignment);
+
+    if(c == CLASS_COUNT) {
+        f_deallocate_upstream(p, alignment);
+    } else {
+        auto block = static_cast<free_block_t*>(p);
+        block->next = m_free[c];
+        m_free[c] = block;
+    }
+
+    m_stats.in_use -= std::min<uint64_t>(bytes, m_stats.in_use);
+}
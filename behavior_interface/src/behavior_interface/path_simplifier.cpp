@@ -0,0 +1,173 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#include "behavior_interface/path_simplifier.h"
+
+#include "algorithm"
+#include "cmath"
+
+using namespace helm;
+
+constexpr size_t PathSimplifier::MAX_TAIL;
+
+namespace {
+
+    /**
+     * @brief Distance from p to the segment between a and b
+     */
+    double segment_distance(const PathSimplifier::point_t& p,
+                            const PathSimplifier::point_t& a,
+                            const PathSimplifier::point_t& b) {
+        double dx = b.x - a.x;
+        double dy = b.y - a.y;
+        double l2 = dx * dx + dy * dy;
+
+        double t = l2 > 0 ?
+            ((p.x - a.x) * dx + (p.y - a.y) * dy) / l2 : 0.0;
+        t = std::min(std::max(t, 0.0), 1.0);
+
+        return std::hypot(p.x - (a.x + t * dx), p.y - (a.y + t * dy));
+    }
+
+}
+
+PathSimplifier::PathSimplifier() :
+    m_tolerance(0),
+    m_committed(0),
+    m_received(0)
+{
+
+}
+
+void PathSimplifier::set_tolerance(double tolerance) {
+    m_tolerance = tolerance;
+}
+
+void PathSimplifier::set_memory_resource(MemoryResource *resource) {
+
+    m_path = decltype(m_path)(resource);
+    m_tail = decltype(m_tail)(resource);
+    m_keep = decltype(m_keep)(resource);
+    m_stack = decltype(m_stack)(resource);
+    m_committed = 0;
+    m_received = 0;
+
+}
+
+void PathSimplifier::clear() {
+
+    m_path.clear();
+    m_tail.clear();
+    m_committed = 0;
+    m_received = 0;
+
+}
+
+void PathSimplifier::append(const std::vector<point_t>& points, bool fixed) {
+
+    if(points.empty()) {
+        return;
+    }
+
+    m_received += points.size();
+
+    if(fixed || m_tolerance <= 0) {
+        m_path.insert(m_path.end(), points.begin(), points.end());
+        m_committed = m_path.size();
+        m_tail.assign(1, m_path.back());
+        return;
+    }
+
+    auto begin = points.begin();
+
+    // First point of a path is always a vertex
+    if(m_path.empty()) {
+        m_path.push_back(*begin);
+        m_committed = 1;
+        m_tail.assign(1, *begin);
+        ++begin;
+    }
+
+    m_tail.insert(m_tail.end(), begin, points.end());
+
+    f_simplify_tail();
+
+    m_path.resize(m_committed);
+    for(size_t k = 1 ; k < m_keep.size() ; k++) {
+        m_path.push_back(m_tail[m_keep[k]]);
+    }
+
+    /**
+     * Every segment but the last one is final. The last one may be merged
+     * with the points of the next chunk, so its original points are kept.
+     */
+    if(m_tail.size() > MAX_TAIL) {
+        m_committed = m_path.size();
+        m_tail.assign(1, m_path.back());
+    } else if(m_keep.size() > 2) {
+        m_committed = m_path.size() - 1;
+        m_tail.erase(m_tail.begin(), m_tail.begin() + m_keep[m_keep.size() - 2]);
+    }
+
+}
+
+void PathSimplifier::f_simplify_tail() {
+
+    m_keep.clear();
+    m_keep.push_back(0);
+
+    if(m_tail.size() < 2) {
+        return;
+    }
+
+    /**
+     * Splits are visited first half first, so the vertices are found in
+     * ascending order.
+     */
+    m_stack.clear();
+    m_stack.emplace_back(0, m_tail.size() - 1);
+
+    while(!m_stack.empty()) {
+        auto range = m_stack.back();
+        m_stack.pop_back();
+
+        double max_distance = 0;
+        size_t index = range.first;
+        for(size_t i = range.first + 1 ; i < range.second ; i++) {
+            auto d = segment_distance(
+                m_tail[i], m_tail[range.first], m_tail[range.second]);
+            if(d > max_distance) {
+                max_distance = d;
+                index = i;
+            }
+        }
+
+        if(max_distance > m_tolerance) {
+            m_stack.emplace_back(index, range.second);
+            m_stack.emplace_back(range.first, index);
+        } else {
+            m_keep.push_back(range.second);
+        }
+    }
+
+}
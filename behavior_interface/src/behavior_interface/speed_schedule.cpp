@@ -0,0 +1,153 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#include "behavior_interface/speed_schedule.h"
+
+#include "algorithm"
+#include "cmath"
+#include "limits"
+
+using namespace helm;
+
+SpeedSchedule::SpeedSchedule() :
+    m_has_deadlines(false),
+    m_nominal(0),
+    m_min(0),
+    m_max(std::numeric_limits<double>::infinity()),
+    m_deadline_index(0),
+    m_required_speed(0),
+    m_late(false)
+{
+
+}
+
+void SpeedSchedule::set_limits(double nominal, double min, double max) {
+
+    m_min = std::max(min, 0.0);
+
+    m_max = std::max(max, m_min);
+
+    m_nominal = std::min(std::max(nominal, m_min), m_max);
+
+}
+
+void SpeedSchedule::set_path(const std::vector<double>& x,
+                             const std::vector<double>& y,
+                             const std::vector<double>& deadlines) {
+
+    auto n = std::min(x.size(), y.size());
+
+    m_arc.assign(n, 0.0);
+    for(size_t i = 1 ; i < n ; i++) {
+        m_arc[i] = m_arc[i - 1] + std::hypot(x[i] - x[i - 1], y[i] - y[i - 1]);
+    }
+
+    m_deadlines.assign(n, std::numeric_limits<double>::quiet_NaN());
+    std::copy_n(deadlines.begin(), std::min(n, deadlines.size()),
+        m_deadlines.begin());
+
+    m_has_deadlines = false;
+
+    m_next.assign(n + 1, n);
+    for(size_t i = n ; i-- > 0 ;) {
+        if(std::isfinite(m_deadlines[i])) {
+            m_next[i] = i;
+            m_has_deadlines = true;
+        } else {
+            m_next[i] = m_next[i + 1];
+        }
+    }
+
+    m_deadline_index = n;
+
+    m_late = false;
+
+}
+
+void SpeedSchedule::shift(double offset) {
+
+    for(auto& t : m_deadlines) {
+        t += offset;
+    }
+
+}
+
+double SpeedSchedule::speed(size_t target, double distance, double now) {
+
+    auto n = m_arc.size();
+
+    m_deadline_index = target < n ? m_next[target] : n;
+
+    if(m_deadline_index == n) {
+        m_required_speed = m_nominal;
+        m_late = false;
+        return m_nominal;
+    }
+
+    auto remaining = distance + m_arc[m_deadline_index] - m_arc[target];
+
+    auto time = m_deadlines[m_deadline_index] - now;
+
+    m_required_speed = time > 0 ?
+        remaining / time : std::numeric_limits<double>::infinity();
+
+    m_late = m_required_speed > m_max;
+
+    return std::min(std::max(m_required_speed, m_min), m_max);
+
+}
+
+std::vector<SpeedSchedule::violation_t> SpeedSchedule::check(
+    size_t target, double distance, double now) const {
+
+    std::vector<violation_t> violations;
+
+    auto n = m_arc.size();
+    if(target >= n) {
+        return violations;
+    }
+
+    /**
+     * The first leg starts at the vehicle, every other leg starts at the
+     * previous deadline.
+     */
+    double arc = m_arc[target] - distance;
+    double time = now;
+
+    for(auto j = m_next[target] ; j < n ; j = m_next[j + 1]) {
+        auto dt = m_deadlines[j] - time;
+
+        auto required = dt > 0 ? (m_arc[j] - arc) / dt :
+            std::numeric_limits<double>::infinity();
+
+        if(required > m_max || required < m_min) {
+            violations.push_back({j, required});
+        }
+
+        arc = m_arc[j];
+        time = std::max(time, m_deadlines[j]);
+    }
+
+    return violations;
+
+}
@@ -0,0 +1,321 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#include "adaptive_sampling.h"
+#include "pluginlib/class_list_macros.h"
+
+#include "cmath"
+#include "limits"
+
+using namespace helm;
+
+constexpr parameter_descriptor_t AdaptiveSampling::PARAMETERS[];
+
+constexpr topic_descriptor_t AdaptiveSampling::TOPICS[];
+
+constexpr behavior_descriptor_t AdaptiveSampling::DESCRIPTOR;
+
+AdaptiveSampling::AdaptiveSampling() : BehaviorBase() {
+
+    m_position_valid = false;
+
+    m_next_valid = false;
+
+    m_evaluating = false;
+
+    m_target_valid = false;
+
+    m_active = false;
+
+}
+
+AdaptiveSampling::~AdaptiveSampling() {
+
+    m_sample_sub.shutdown();
+
+    m_scalar_sub.shutdown();
+
+}
+
+void AdaptiveSampling::initialize() {
+
+    m_pnh = create_node_handle();
+
+    auto sample_topic = get_parameter<std::string>("sample_topic");
+
+    auto scalar_topic = get_parameter<std::string>("scalar_topic");
+
+    m_uncertainty_weight = get_parameter<double>("uncertainty_weight");
+
+    m_gradient_weight = get_parameter<double>("gradient_weight");
+
+    m_distance_weight = get_parameter<double>("distance_weight");
+
+    m_acceptance_radius = get_parameter<double>("acceptance_radius");
+
+    m_surge_velocity = get_parameter<double>("surge_velocity");
+
+    f_configure_model();
+
+    m_sample_sub = m_pnh->subscribe(
+        sample_topic, 100, &AdaptiveSampling::f_sample_cb, this);
+
+    if(!scalar_topic.empty()) {
+        m_scalar_sub = m_pnh->subscribe(
+            scalar_topic, 100, &AdaptiveSampling::f_scalar_cb, this);
+    }
+
+}
+
+void AdaptiveSampling::f_configure_model() {
+
+    auto length_scale = get_parameter<double>("length_scale");
+
+    m_model.configure(length_scale,
+        get_parameter<double>("signal_variance"),
+        get_parameter<double>("noise_variance"));
+
+    // Survey area in the frame of the controller
+    auto min_x = get_parameter<double>("min_x");
+    auto max_x = get_parameter<double>("max_x");
+    auto min_y = get_parameter<double>("min_y");
+    auto max_y = get_parameter<double>("max_y");
+
+    // Spacings follow the length scale unless they are given
+    auto inducing_spacing = get_parameter<double>("inducing_spacing");
+    if(inducing_spacing <= 0) {
+        inducing_spacing = length_scale;
+    }
+
+    auto max_inducing = get_parameter<int>("max_inducing");
+
+    auto candidate_spacing = get_parameter<double>("candidate_spacing");
+    if(candidate_spacing <= 0) {
+        candidate_spacing = length_scale / 2.0;
+    }
+
+    auto grid = [&](double spacing) {
+        auto nx = std::max(1,
+            static_cast<int>(std::floor((max_x - min_x) / spacing)) + 1);
+        auto ny = std::max(1,
+            static_cast<int>(std::floor((max_y - min_y) / spacing)) + 1);
+
+        Eigen::Matrix2Xd points(2, nx * ny);
+        for(int i = 0 ; i < nx ; i++) {
+            for(int j = 0 ; j < ny ; j++) {
+                points(0, i * ny + j) = min_x + i * spacing;
+                points(1, i * ny + j) = min_y + j * spacing;
+            }
+        }
+        return points;
+    };
+
+    // Inducing points are spread out until they fit in the bound
+    auto area = std::max((max_x - min_x) * (max_y - min_y), 1.0);
+    inducing_spacing = std::max(inducing_spacing,
+        std::sqrt(area / std::max(max_inducing, 1)) * 1.01);
+
+    m_model.set_inducing_points(grid(inducing_spacing));
+
+    m_candidates = grid(candidate_spacing);
+
+    ROS_INFO_STREAM(get_name() << ": sparse GP with "
+        << m_model.get_inducing_count() << " inducing points and "
+        << m_candidates.cols() << " candidates");
+
+}
+
+void AdaptiveSampling::f_sample_cb(
+        const geometry_msgs::PointStamped::ConstPtr& m)
+{
+
+    if(!std::isfinite(m->point.x) || !std::isfinite(m->point.y) ||
+        !std::isfinite(m->point.z)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Samples in another frame would land at the wrong place
+    if(!m->header.frame_id.empty() && !m_frame_id.empty() &&
+        m->header.frame_id != m_frame_id) {
+        ROS_WARN_STREAM_THROTTLE(10, get_name() << ": sample in frame '"
+            << m->header.frame_id << "' is dropped, expected '"
+            << m_frame_id << "'");
+        return;
+    }
+
+    m_model.update(m->point.x, m->point.y, m->point.z);
+
+}
+
+void AdaptiveSampling::f_scalar_cb(const std_msgs::Float64::ConstPtr& m) {
+
+    if(!std::isfinite(m->data)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(!m_position_valid) {
+        return;
+    }
+
+    m_model.update(m_position.x(), m_position.y(), m->data);
+
+}
+
+void AdaptiveSampling::f_request_evaluation() {
+
+    if(m_evaluating.exchange(true)) {
+        return;
+    }
+
+    if(!submit_work([this] { f_evaluate(); })) {
+        m_evaluating = false;
+        ROS_WARN_STREAM_THROTTLE(10, get_name() << ": evaluation can not be"
+            " queued, helm needs at least one worker thread");
+    }
+
+}
+
+void AdaptiveSampling::f_evaluate() {
+
+    /**
+     * Model is copied so that samples keep coming in during the evaluation.
+     * Copy is O(M^2), same as a single sample.
+     */
+    SparseGP model;
+    Eigen::Vector2d position;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        model = m_model;
+        position = m_position;
+    }
+
+    model.freeze();
+
+    double best_score = -std::numeric_limits<double>::infinity();
+    Eigen::Vector2d best = position;
+    bool found = false;
+
+    for(Eigen::Index i = 0 ; i < m_candidates.cols() ; i++) {
+        Eigen::Vector2d c = m_candidates.col(i);
+
+        auto distance = (c - position).norm();
+        if(distance < m_acceptance_radius) {
+            continue;
+        }
+
+        double mean, variance;
+        Eigen::Vector2d gradient;
+        model.predict(c.x(), c.y(), &mean, &variance, &gradient);
+
+        auto score = m_uncertainty_weight * std::sqrt(variance) +
+            m_gradient_weight * gradient.norm() -
+            m_distance_weight * distance;
+
+        if(score > best_score) {
+            best_score = score;
+            best = c;
+            found = true;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_next = best;
+        m_next_valid = found;
+    }
+
+    m_evaluating = false;
+
+}
+
+void AdaptiveSampling::activated() {
+
+    m_active = true;
+
+    m_target_valid = false;
+
+    // A result computed before the activation is out of date
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_next_valid = false;
+
+}
+
+void AdaptiveSampling::disabled() {
+
+    m_active = false;
+
+}
+
+bool AdaptiveSampling::request_set_point(mvp_msgs::ControlProcess *set_point) {
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Samples are tagged with the position even if the behavior is idle
+        m_position.x() = m_process_values.position.x;
+        m_position.y() = m_process_values.position.y;
+        m_position_valid = true;
+        m_frame_id = m_process_values.header.frame_id;
+
+        if(!m_active) {
+            return false;
+        }
+
+        if(!m_target_valid && m_next_valid) {
+            m_target = m_next;
+            m_target_valid = true;
+            m_next_valid = false;
+        }
+    }
+
+    if(!m_target_valid) {
+        f_request_evaluation();
+        return false;
+    }
+
+    auto dist_x = m_target.x() - m_process_values.position.x;
+    auto dist_y = m_target.y() - m_process_values.position.y;
+
+    if(std::hypot(dist_x, dist_y) < m_acceptance_radius) {
+        m_target_valid = false;
+
+        f_request_evaluation();
+
+        // skip for this loop
+        return false;
+    }
+
+    set_point->orientation.z = std::atan2(dist_y, dist_x);
+    set_point->velocity.x = m_surge_velocity;
+
+    return true;
+}
+
+/**
+ * @brief Behavior must export the class to the Plugin library.
+ */
+PLUGINLIB_EXPORT_CLASS(helm::AdaptiveSampling, helm::BehaviorBase)
@@ -0,0 +1,248 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#pragma once
+
+#include "behavior_interface/behavior_base.h"
+#include "ros/ros.h"
+#include "std_msgs/Float64.h"
+#include "geometry_msgs/PointStamped.h"
+
+#include "atomic"
+#include "limits"
+#include "mutex"
+
+#include "sparse_gp.h"
+
+namespace helm {
+
+    /**
+     * @brief Adaptive sampling behavior
+     *
+     * Samples of a scalar field, e.g. temperature or turbidity, are folded
+     * into a sparse Gaussian process at the position they are taken. A sample
+     * either carries its own position, or it is tagged with the vehicle
+     * position of the last helm iteration, which is up to one helm period
+     * old.
+     * Next waypoint is the candidate with the highest acquisition score,
+     *
+     *     uncertainty_weight * stddev + gradient_weight * |gradient|
+     *         - distance_weight * distance
+     *
+     * evaluated on a grid over the survey area. Evaluation runs on the worker
+     * threads of the helm, the behavior keeps steering to its current target
+     * in the meantime.
+     */
+    class AdaptiveSampling : public BehaviorBase {
+    private:
+
+        void initialize() override;
+
+        /**
+         * @brief Trivial node handler
+         */
+        ros::NodeHandlePtr m_pnh;
+
+        /**
+         * @brief Positioned sample subscriber
+         */
+        ros::Subscriber m_sample_sub;
+
+        /**
+         * @brief Scalar sample subscriber, tagged with #m_position
+         */
+        ros::Subscriber m_scalar_sub;
+
+        /**
+         * @brief Field model, guarded by #m_mutex
+         */
+        SparseGP m_model;
+
+        /**
+         * @brief Candidate waypoints, one per column
+         */
+        Eigen::Matrix2Xd m_candidates;
+
+        std::mutex m_mutex;
+
+        /**
+         * @brief Last known vehicle position, guarded by #m_mutex
+         */
+        Eigen::Vector2d m_position;
+
+        bool m_position_valid;
+
+        /**
+         * @brief Frame of the process values, guarded by #m_mutex
+         */
+        std::string m_frame_id;
+
+        /**
+         * @brief Waypoint picked by the last evaluation, guarded by #m_mutex
+         */
+        Eigen::Vector2d m_next;
+
+        bool m_next_valid;
+
+        /**
+         * @brief True while an evaluation is queued or running
+         */
+        std::atomic<bool> m_evaluating;
+
+        /**
+         * @brief Waypoint that the vehicle is steering to
+         */
+        Eigen::Vector2d m_target;
+
+        bool m_target_valid;
+
+        /**
+         * @brief True while the behavior is active
+         */
+        bool m_active;
+
+        double m_uncertainty_weight;
+
+        double m_gradient_weight;
+
+        double m_distance_weight;
+
+        /**
+         * @brief Acceptance radius in meters
+         */
+        double m_acceptance_radius;
+
+        /**
+         * @brief Surge velocity for the behavior
+         */
+        double m_surge_velocity;
+
+        /**
+         * @brief Creates the inducing points and the candidates over the
+         *        survey area
+         */
+        void f_configure_model();
+
+        /**
+         * @brief Folds in a sample taken at the given position
+         *
+         * x and y are the position in the frame of the controller, z is the
+         * sampled value.
+         */
+        void f_sample_cb(const geometry_msgs::PointStamped::ConstPtr& m);
+
+        /**
+         * @brief Folds in a sample at the last known vehicle position
+         */
+        void f_scalar_cb(const std_msgs::Float64::ConstPtr& m);
+
+        /**
+         * @brief Queues an evaluation of the acquisition function
+         */
+        void f_request_evaluation();
+
+        /**
+         * @brief Evaluates the acquisition function on the candidates
+         */
+        void f_evaluate();
+
+        void activated() override;
+
+        void disabled() override;
+
+    public:
+
+        static constexpr parameter_descriptor_t PARAMETERS[] = {
+            parameter_string("sample_topic", "sample",
+                "Positioned samples, z is the sampled value"),
+            parameter_string("scalar_topic", "",
+                "Samples at the vehicle position, empty if none"),
+            parameter_double("uncertainty_weight", 1.0,
+                "Weight of the standard deviation in the acquisition"),
+            parameter_double("gradient_weight", 1.0,
+                "Weight of the gradient in the acquisition"),
+            parameter_double("distance_weight", 0.01,
+                "Weight of the distance in the acquisition, per meter"),
+            parameter_double("acceptance_radius", 2.0, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Waypoint is reached within it, in meters"),
+            parameter_double("surge_velocity", 0.5, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Surge velocity, in m/s"),
+            parameter_double("length_scale", 10.0, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Length scale of the kernel, in meters"),
+            parameter_double("signal_variance", 1.0, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Signal variance of the kernel"),
+            parameter_double("noise_variance", 0.01, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Noise variance of the samples"),
+            parameter_double("min_x", -50.0, "Survey area, in meters"),
+            parameter_double("max_x", 50.0, "Survey area, in meters"),
+            parameter_double("min_y", -50.0, "Survey area, in meters"),
+            parameter_double("max_y", 50.0, "Survey area, in meters"),
+            parameter_double("inducing_spacing", 0.0, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Grid of the inducing points in meters, 0 is length_scale"),
+            parameter_int("max_inducing", 200, 1,
+                std::numeric_limits<int>::max(),
+                "Upper bound of the inducing points"),
+            parameter_double("candidate_spacing", 0.0, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Grid of the candidates in meters, 0 is half length_scale")
+        };
+
+        static constexpr topic_descriptor_t TOPICS[] = {
+            configured_input_topic("sample_topic",
+                "geometry_msgs/PointStamped", "Positioned samples"),
+            configured_input_topic("scalar_topic", "std_msgs/Float64",
+                "Samples tagged with the vehicle position")
+        };
+
+        static constexpr behavior_descriptor_t DESCRIPTOR = make_descriptor(
+            dof_mask(
+                mvp_msgs::ControlMode::DOF_SURGE,
+                mvp_msgs::ControlMode::DOF_YAW
+            ),
+            PARAMETERS,
+            TOPICS
+        );
+
+        const behavior_descriptor_t* get_descriptor() const override {
+            return &DESCRIPTOR;
+        }
+
+        AdaptiveSampling();
+
+        ~AdaptiveSampling() override;
+
+        /**
+         * @brief This function is inherited from #BehaviorBase
+         * @param msg
+         * @return
+         */
+        bool request_set_point(mvp_msgs::ControlProcess *msg) override;
+
+    };
+}
@@ -0,0 +1,159 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#include "sparse_gp.h"
+
+#include "algorithm"
+#include "cmath"
+
+using namespace helm;
+
+SparseGP::SparseGP() {
+
+    m_length_scale = 10.0;
+
+    m_signal_variance = 1.0;
+
+    m_noise_variance = 0.01;
+
+    m_sum = 0;
+
+    m_count = 0;
+
+}
+
+void SparseGP::configure(double length_scale, double signal_variance,
+                         double noise_variance) {
+
+    m_length_scale = length_scale;
+
+    m_signal_variance = signal_variance;
+
+    m_noise_variance = noise_variance;
+
+}
+
+Eigen::VectorXd SparseGP::f_kernel(double x, double y) const {
+
+    Eigen::Vector2d p(x, y);
+
+    auto d2 = (m_inducing.colwise() - p).colwise().squaredNorm();
+
+    return (m_signal_variance * (-0.5 * d2.array() /
+        (m_length_scale * m_length_scale)).exp()).matrix().transpose();
+
+}
+
+void SparseGP::set_inducing_points(const Eigen::Matrix2Xd& inducing) {
+
+    m_inducing = inducing;
+
+    auto m = m_inducing.cols();
+
+    Eigen::MatrixXd kmm(m, m);
+    for(Eigen::Index i = 0 ; i < m ; i++) {
+        kmm.col(i) = f_kernel(m_inducing(0, i), m_inducing(1, i));
+    }
+
+    // Jitter keeps the factorization stable for close inducing points
+    kmm.diagonal().array() += 1e-6 * m_signal_variance;
+
+    m_kmm.compute(kmm);
+
+    m_a.compute(kmm);
+
+    m_b = Eigen::VectorXd::Zero(m);
+
+    m_s = Eigen::VectorXd::Zero(m);
+
+    m_alpha = Eigen::VectorXd::Zero(m);
+
+    m_sum = 0;
+
+    m_count = 0;
+
+}
+
+void SparseGP::update(double x, double y, double value) {
+
+    if(m_inducing.cols() == 0) {
+        return;
+    }
+
+    auto k = f_kernel(x, y);
+
+    m_a.rankUpdate(k, 1.0 / m_noise_variance);
+
+    m_b += k * (value / m_noise_variance);
+
+    m_s += k / m_noise_variance;
+
+    m_sum += value;
+
+    m_count++;
+
+}
+
+void SparseGP::freeze() {
+
+    if(m_inducing.cols() == 0) {
+        return;
+    }
+
+    double mean = m_count ? m_sum / static_cast<double>(m_count) : 0.0;
+
+    m_alpha = m_a.solve(m_b - mean * m_s);
+
+}
+
+void SparseGP::predict(double x, double y, double* mean, double* variance,
+                       Eigen::Vector2d* gradient) const {
+
+    double prior = m_count ? m_sum / static_cast<double>(m_count) : 0.0;
+
+    if(m_inducing.cols() == 0) {
+        *mean = prior;
+        *variance = m_signal_variance;
+        gradient->setZero();
+        return;
+    }
+
+    auto k = f_kernel(x, y);
+
+    *mean = prior + k.dot(m_alpha);
+
+    /**
+     * Variance of the DTC approximation:
+     *     k** - k*' Kmm^-1 k* + k*' A^-1 k*
+     */
+    double q = m_kmm.matrixL().solve(k).squaredNorm();
+    double r = m_a.matrixL().solve(k).squaredNorm();
+    *variance = std::max(m_signal_variance - q + r, 0.0);
+
+    // d k(x, z) / dx = k(x, z) (z - x) / l^2
+    Eigen::Vector2d p(x, y);
+    Eigen::VectorXd w = k.cwiseProduct(m_alpha);
+    *gradient = ((m_inducing.colwise() - p) * w) /
+        (m_length_scale * m_length_scale);
+
+}
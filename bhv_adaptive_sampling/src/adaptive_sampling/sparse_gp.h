@@ -0,0 +1,133 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#pragma once
+
+#include "Eigen/Dense"
+
+namespace helm {
+
+    /**
+     * @brief Sparse Gaussian process over a two dimensional scalar field
+     *
+     * Field is approximated with a bounded set of inducing points (DTC
+     * approximation) and a squared exponential kernel. Samples are not
+     * stored, each of them is folded into the information matrix
+     *
+     *     A = Kmm + Kmn Knm / noise_variance
+     *
+     * with a rank one update of its Cholesky factor. Cost of a sample is
+     * O(M^2) for M inducing points, no matter how many samples are taken.
+     *
+     * Prior mean is the running average of the samples.
+     */
+    class SparseGP {
+    private:
+
+        double m_length_scale;
+
+        double m_signal_variance;
+
+        double m_noise_variance;
+
+        //! @brief Inducing points, one per column
+        Eigen::Matrix2Xd m_inducing;
+
+        //! @brief Cholesky factor of Kmm
+        Eigen::LLT<Eigen::MatrixXd> m_kmm;
+
+        //! @brief Cholesky factor of A
+        Eigen::LLT<Eigen::MatrixXd> m_a;
+
+        //! @brief Sum of k(x) * y / noise_variance
+        Eigen::VectorXd m_b;
+
+        //! @brief Sum of k(x) / noise_variance, used to apply the prior mean
+        Eigen::VectorXd m_s;
+
+        //! @brief A^-1 (b - mean * s), valid after #SparseGP::freeze
+        Eigen::VectorXd m_alpha;
+
+        double m_sum;
+
+        size_t m_count;
+
+        /**
+         * @brief Kernel vector between a point and the inducing points
+         */
+        Eigen::VectorXd f_kernel(double x, double y) const;
+
+    public:
+
+        SparseGP();
+
+        /**
+         * @brief Set the hyper parameters
+         *
+         * @param length_scale Length scale of the kernel in meters
+         * @param signal_variance Variance of the field
+         * @param noise_variance Variance of the sensor noise
+         */
+        void configure(double length_scale, double signal_variance,
+                       double noise_variance);
+
+        /**
+         * @brief Set the inducing points. Resets the model.
+         *
+         * @param inducing Inducing points, one per column
+         */
+        void set_inducing_points(const Eigen::Matrix2Xd& inducing);
+
+        /**
+         * @brief Fold a sample into the model
+         *
+         * @param x Position of the sample
+         * @param y Position of the sample
+         * @param value Measured value
+         */
+        void update(double x, double y, double value);
+
+        /**
+         * @brief Solve for the weights. Must be called before predicting.
+         */
+        void freeze();
+
+        /**
+         * @brief Predict the field at a point
+         *
+         * @param x Position
+         * @param y Position
+         * @param mean Output, predicted mean
+         * @param variance Output, predicted variance
+         * @param gradient Output, gradient of the mean
+         */
+        void predict(double x, double y, double* mean, double* variance,
+                     Eigen::Vector2d* gradient) const;
+
+        size_t get_sample_count() const { return m_count; }
+
+        size_t get_inducing_count() const { return m_inducing.cols(); }
+
+    };
+
+}
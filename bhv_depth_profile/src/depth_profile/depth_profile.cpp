@@ -0,0 +1,218 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#include "depth_profile.h"
+#include "pluginlib/class_list_macros.h"
+
+#include "cmath"
+#include "limits"
+
+using namespace helm;
+
+namespace {
+
+    bool parse_number(XmlRpc::XmlRpcValue& v, const std::string& key,
+                      double* out) {
+
+        if(!v.hasMember(key)) {
+            return false;
+        }
+
+        if(v[key].getType() == XmlRpc::XmlRpcValue::TypeDouble) {
+            *out = static_cast<double>(v[key]);
+        } else if(v[key].getType() == XmlRpc::XmlRpcValue::TypeInt) {
+            *out = static_cast<int>(v[key]);
+        } else {
+            return false;
+        }
+
+        return true;
+    }
+
+}
+
+DepthProfile::DepthProfile() : BehaviorBase() {
+
+    m_active = false;
+
+    m_done = false;
+
+    m_distance = 0;
+
+    m_last_x = 0;
+
+    m_last_y = 0;
+
+}
+
+void DepthProfile::initialize() {
+
+    m_pnh = create_node_handle();
+
+    BehaviorBase::m_dofs = decltype(m_dofs){
+        mvp_msgs::ControlMode::DOF_PITCH,
+        mvp_msgs::ControlMode::DOF_Z
+    };
+
+    m_pnh->param("forward_distance", m_fwd_distance, 3.0);
+
+    m_pnh->param<double>("max_pitch", m_max_pitch, M_PI_2);
+
+    // String: A state to be requested when the profile ends
+    m_pnh->param<std::string>("state_done", m_state_done, "");
+
+    f_parse_param_profile();
+
+}
+
+void DepthProfile::f_parse_param_profile() {
+
+    std::string index;
+    m_pnh->param<std::string>("index", index, "time");
+
+    if(index == "time") {
+        m_index_type = Index::TIME;
+    } else if(index == "distance") {
+        m_index_type = Index::DISTANCE;
+    } else {
+        ROS_ERROR_STREAM(get_name() << ": unknown profile index '" << index
+            << "', it must be 'time' or 'distance'");
+        m_index_type = Index::TIME;
+    }
+
+    bool loop;
+    m_pnh->param("loop", loop, false);
+
+    XmlRpc::XmlRpcValue l;
+    if(!m_pnh->getParam("profile", l)) {
+        ROS_ERROR_STREAM(get_name() << ": no profile is defined");
+        return;
+    }
+
+    if(l.getType() != XmlRpc::XmlRpcValue::TypeArray) {
+        ROS_ERROR("profile is not in type array format.");
+        return;
+    }
+
+    std::vector<ProfileTable::row_t> rows;
+    for(int32_t i = 0 ; i < l.size() ; i++) {
+        ProfileTable::row_t row;
+        row.pitch = std::numeric_limits<double>::quiet_NaN();
+
+        if(l[i].getType() != XmlRpc::XmlRpcValue::TypeStruct ||
+            !parse_number(l[i], "at", &row.index) ||
+            !parse_number(l[i], "depth", &row.depth)) {
+            ROS_ERROR_STREAM(get_name() << ": profile row " << i
+                << " must have 'at' and 'depth'");
+            return;
+        }
+
+        parse_number(l[i], "pitch", &row.pitch);
+
+        rows.emplace_back(row);
+    }
+
+    if(!m_table.compile(rows, loop)) {
+        ROS_ERROR_STREAM(get_name() << ": profile rows must be in increasing"
+            " order of 'at'");
+    }
+
+}
+
+void DepthProfile::activated() {
+
+    m_active = true;
+
+    m_done = false;
+
+    m_table.reset();
+
+    m_start_time = ros::Time::now();
+
+    m_distance = 0;
+
+    m_last_x = m_process_values.position.x;
+
+    m_last_y = m_process_values.position.y;
+
+}
+
+void DepthProfile::disabled() {
+
+    m_active = false;
+
+}
+
+double DepthProfile::f_index() {
+
+    if(m_index_type == Index::TIME) {
+        return (ros::Time::now() - m_start_time).toSec();
+    }
+
+    m_distance += std::hypot(
+        m_process_values.position.x - m_last_x,
+        m_process_values.position.y - m_last_y);
+
+    m_last_x = m_process_values.position.x;
+
+    m_last_y = m_process_values.position.y;
+
+    return m_distance;
+}
+
+bool DepthProfile::request_set_point(mvp_msgs::ControlProcess *set_point) {
+
+    if(!m_active || m_table.empty()) {
+        return false;
+    }
+
+    auto index = f_index();
+
+    if(!m_done && m_table.finished(index)) {
+        m_done = true;
+
+        if(!m_state_done.empty()) {
+            change_state(m_state_done);
+        }
+    }
+
+    double depth, pitch;
+    if(!m_table.sample(index, &depth, &pitch)) {
+        pitch = atan(
+            (BehaviorBase::m_process_values.position.z - depth) /
+                m_fwd_distance);
+    }
+
+    if(fabs(pitch) > m_max_pitch) {
+        pitch = pitch >= 0 ? m_max_pitch : -m_max_pitch;
+    }
+
+    set_point->orientation.y = pitch;
+
+    set_point->position.z = depth;
+
+    return true;
+}
+
+
+PLUGINLIB_EXPORT_CLASS(helm::DepthProfile, helm::BehaviorBase)
@@ -0,0 +1,129 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#pragma once
+
+#include "behavior_interface/behavior_base.h"
+#include "ros/ros.h"
+
+#include "profile_table.h"
+
+namespace helm {
+
+    /**
+     * @brief Executes a vertical profile defined as a table
+     *
+     * Rows of the table are indexed with seconds since the activation or with
+     * meters travelled along the track since the activation. Depth and pitch
+     * are interpolated between rows. Rows without a pitch leave it to a depth
+     * tracking law, the same one #DepthTracking uses.
+     *
+     * Yo-yo, periodic surfacing and depth change plans can all be written as
+     * a profile.
+     */
+    class DepthProfile : public BehaviorBase {
+    private:
+
+        enum class Index : int {
+            TIME,
+            DISTANCE
+        };
+
+        void initialize() override;
+
+        /**
+         * @brief Trivial node handler
+         */
+        ros::NodeHandlePtr m_pnh;
+
+        /**
+         * @brief Compiled profile
+         */
+        ProfileTable m_table;
+
+        /**
+         * @brief What the rows of the profile are indexed with
+         */
+        Index m_index_type;
+
+        /**
+         * @brief Forward distance of the depth tracking law, in meters
+         */
+        double m_fwd_distance;
+
+        /**
+         * @brief maximum pitch that the behavior will command. in radians
+         */
+        double m_max_pitch;
+
+        /**
+         * @brief State to be requested when a non looping profile ends
+         */
+        std::string m_state_done;
+
+        bool m_active;
+
+        bool m_done;
+
+        /**
+         * @brief Time of the activation
+         */
+        ros::Time m_start_time;
+
+        /**
+         * @brief Distance travelled since the activation, in meters
+         */
+        double m_distance;
+
+        double m_last_x;
+
+        double m_last_y;
+
+        /**
+         * @brief Reads the profile from the parameter server and compiles it
+         */
+        void f_parse_param_profile();
+
+        /**
+         * @brief Index of the profile in this iteration
+         */
+        double f_index();
+
+        /**
+         * @brief Implementation of #BehaviorBase::activated
+         */
+        void activated() override;
+
+        /**
+         * @brief Implementation of #BehaviorBase::disabled
+         */
+        void disabled() override;
+
+    public:
+
+        DepthProfile();
+
+        bool request_set_point(mvp_msgs::ControlProcess *msg) override;
+
+    };
+}
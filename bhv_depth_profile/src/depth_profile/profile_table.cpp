@@ -0,0 +1,151 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#include "profile_table.h"
+
+#include "algorithm"
+#include "cmath"
+
+using namespace helm;
+
+ProfileTable::ProfileTable() {
+
+    m_loop = false;
+
+    reset();
+
+}
+
+bool ProfileTable::compile(const std::vector<row_t>& rows, bool loop) {
+
+    m_segments.clear();
+
+    m_loop = loop;
+
+    reset();
+
+    if(rows.empty()) {
+        return false;
+    }
+
+    if(rows.size() == 1) {
+        // Constant profile
+        m_segments.push_back({
+            rows[0].index, rows[0].index, 0.0,
+            rows[0].depth, 0.0,
+            std::isnan(rows[0].pitch) ? 0.0 : rows[0].pitch, 0.0,
+            !std::isnan(rows[0].pitch)
+        });
+        m_loop = false;
+        return true;
+    }
+
+    for(size_t i = 0 ; i + 1 < rows.size() ; i++) {
+        const auto& a = rows[i];
+        const auto& b = rows[i + 1];
+
+        auto length = b.index - a.index;
+        if(length <= 0) {
+            m_segments.clear();
+            return false;
+        }
+
+        segment_t s;
+        s.start = a.index;
+        s.end = b.index;
+        s.inv_length = 1.0 / length;
+        s.depth = a.depth;
+        s.depth_slope = (b.depth - a.depth) * s.inv_length;
+        s.has_pitch = !std::isnan(a.pitch) && !std::isnan(b.pitch);
+        s.pitch = s.has_pitch ? a.pitch : 0.0;
+        s.pitch_slope = s.has_pitch ? (b.pitch - a.pitch) * s.inv_length : 0.0;
+
+        m_segments.emplace_back(s);
+    }
+
+    return true;
+}
+
+void ProfileTable::reset() {
+
+    m_cursor = 0;
+
+    m_loops = 0;
+
+    m_offset = 0;
+
+}
+
+bool ProfileTable::finished(double index) const {
+
+    if(m_loop || m_segments.empty()) {
+        return false;
+    }
+
+    return index >= m_segments.back().end - m_segments.front().start;
+
+}
+
+bool ProfileTable::sample(double index, double* depth, double* pitch) {
+
+    if(m_segments.empty()) {
+        return false;
+    }
+
+    auto begin = m_segments.front().start;
+
+    auto period = m_segments.back().end - begin;
+
+    // Index since the beginning of the active loop
+    auto x = index - m_offset;
+
+    if(m_loop) {
+        /**
+         * Wrapping rewinds the cursor. Index moves less than a period per
+         * call in practice, so this happens at most once.
+         */
+        while(x >= period) {
+            x -= period;
+            m_offset += period;
+            m_cursor = 0;
+            m_loops++;
+        }
+    }
+
+    x += begin;
+
+    while(m_cursor + 1 < m_segments.size() && x >= m_segments[m_cursor].end) {
+        m_cursor++;
+    }
+
+    const auto& s = m_segments[m_cursor];
+
+    // Hold the ends of the table
+    auto t = std::min(std::max(x, s.start), s.end) - s.start;
+
+    *depth = s.depth + s.depth_slope * t;
+
+    *pitch = s.pitch + s.pitch_slope * t;
+
+    return s.has_pitch;
+}
@@ -0,0 +1,118 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#pragma once
+
+#include "cstddef"
+#include "vector"
+
+namespace helm {
+
+    /**
+     * @brief Depth and pitch profile compiled into a flat array of segments
+     *
+     * A profile is defined by rows of (index, depth, pitch). Index is either
+     * seconds or meters along the track and must be increasing. Values are
+     * linearly interpolated between rows. Pitch of a row is optional, a
+     * segment without pitch on both ends leaves the pitch to the caller.
+     *
+     * Index of a running profile only goes forward, so a cursor is kept on the
+     * active segment. Advancing it is O(1) per call, it only moves when a
+     * segment boundary is crossed.
+     */
+    class ProfileTable {
+    public:
+
+        struct row_t {
+            double index;
+            double depth;
+            //! @brief Pitch in radians, NaN if it is not defined
+            double pitch;
+        };
+
+    private:
+
+        struct segment_t {
+            double start;
+            double end;
+            double inv_length;
+            double depth;
+            double depth_slope;
+            double pitch;
+            double pitch_slope;
+            bool has_pitch;
+        };
+
+        std::vector<segment_t> m_segments;
+
+        bool m_loop;
+
+        size_t m_cursor;
+
+        //! @brief Number of completed loops
+        size_t m_loops;
+
+        //! @brief Index at which the active loop started
+        double m_offset;
+
+    public:
+
+        ProfileTable();
+
+        /**
+         * @brief Compile the rows
+         *
+         * @param rows Rows of the profile, sorted by index
+         * @param loop Start over when the end of the table is reached
+         * @return false if the rows don't form a valid profile
+         */
+        bool compile(const std::vector<row_t>& rows, bool loop);
+
+        /**
+         * @brief Rewind to the beginning of the profile
+         */
+        void reset();
+
+        /**
+         * @brief Sample the profile
+         *
+         * @param index Index since the start of the profile, must not
+         *              decrease between calls unless the table is reset
+         * @param depth Output, depth in meters
+         * @param pitch Output, pitch in radians
+         * @return false if there is no pitch defined at the index
+         */
+        bool sample(double index, double* depth, double* pitch);
+
+        /**
+         * @brief True if the profile is not looping and its end is reached
+         */
+        bool finished(double index) const;
+
+        bool empty() const { return m_segments.empty(); }
+
+        size_t get_loops() const { return m_loops; }
+
+    };
+
+}
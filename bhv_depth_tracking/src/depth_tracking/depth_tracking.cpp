@@ -27,33 +27,27 @@
 
 using namespace helm;
 
-void DepthTracking::initialize() {
+constexpr parameter_descriptor_t DepthTracking::PARAMETERS[];
 
-    m_nh.reset(
-        new ros::NodeHandle(ros::this_node::getName() + "/" + get_name())
-    );
+constexpr topic_descriptor_t DepthTracking::TOPICS[];
 
-    //! @par Declare the dofs to be controlled
-    BehaviorBase::m_dofs = decltype(m_dofs){
-        mvp_msgs::ControlMode::DOF_Z,
-        mvp_msgs::ControlMode::DOF_PITCH
-    };
+constexpr behavior_descriptor_t DepthTracking::DESCRIPTOR;
 
-    m_sub = m_nh->subscribe(
-        "desired_depth", 100, &DepthTracking::f_cb_sub, this);
+void DepthTracking::initialize() {
 
-    m_nh->param("desired_depth",m_requested_depth, 0.0);
+    m_nh = create_node_handle();
 
-    m_nh->param("max_pitch", m_max_pitch, M_PI_2);
+    m_sub = m_nh->subscribe(
+        "desired_depth", 100, &DepthTracking::f_cb_sub, this);
 
-    m_nh->param("forward_distance", m_fwd_distance, 3.0);
+    m_requested_depth = get_parameter<double>("desired_depth");
 
-    m_nh->param("use_heave_velocity", m_use_heave_velocity, false);
-    m_nh->param("pitch_enabled", m_pitch_enabled, false);
+    m_max_pitch = get_parameter<double>("max_pitch");
 
-}
+    m_fwd_distance = get_parameter<double>("forward_distance");
 
-auto DepthTracking::configure_dofs() -> decltype(m_dofs) {
+    m_use_heave_velocity = get_parameter<bool>("use_heave_velocity");
+    m_pitch_enabled = get_parameter<bool>("pitch_enabled");
 
 }
 
@@ -28,6 +28,8 @@
 #include "ros/ros.h"
 #include "std_msgs/Float64.h"
 
+#include "cmath"
+
 namespace helm {
 
     class DepthTracking : public BehaviorBase {
@@ -66,10 +68,41 @@ namespace helm {
 
         bool m_use_heave_velocity;
         bool m_pitch_enabled;
-        virtual auto configure_dofs() -> decltype(m_dofs) final;
 
     public:
 
+        static constexpr parameter_descriptor_t PARAMETERS[] = {
+            parameter_double("desired_depth", 0.0,
+                "Depth until one is received from the topic, in meters"),
+            parameter_double("max_pitch", M_PI_2, 0, M_PI_2,
+                "Largest pitch angle, in radians"),
+            parameter_double("forward_distance", 3.0, 1e-3,
+                std::numeric_limits<double>::infinity(),
+                "Distance ahead that the depth error is closed in, in meters"),
+            parameter_bool("use_heave_velocity", false,
+                "Adds the flight path angle to the pitch"),
+            parameter_bool("pitch_enabled", false,
+                "Requests the pitch, otherwise it is zero")
+        };
+
+        static constexpr topic_descriptor_t TOPICS[] = {
+            input_topic("desired_depth", "std_msgs/Float64",
+                "Depth to be tracked, in meters")
+        };
+
+        static constexpr behavior_descriptor_t DESCRIPTOR = make_descriptor(
+            dof_mask(
+                mvp_msgs::ControlMode::DOF_Z,
+                mvp_msgs::ControlMode::DOF_PITCH
+            ),
+            PARAMETERS,
+            TOPICS
+        );
+
+        const behavior_descriptor_t* get_descriptor() const override {
+            return &DESCRIPTOR;
+        }
+
         /**
          * @brief Trivial constructor
          */
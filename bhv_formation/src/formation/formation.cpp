@@ -0,0 +1,245 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#include "formation.h"
+#include "pluginlib/class_list_macros.h"
+
+#include "algorithm"
+#include "cmath"
+
+using namespace helm;
+
+constexpr parameter_descriptor_t Formation::PARAMETERS[];
+
+constexpr topic_descriptor_t Formation::TOPICS[];
+
+constexpr behavior_descriptor_t Formation::DESCRIPTOR;
+
+Formation::Formation() : BehaviorBase() {
+
+    m_source = Source::TOPIC;
+
+    m_offset_x = 0;
+
+    m_offset_y = 0;
+
+}
+
+void Formation::initialize() {
+
+    m_pnh = create_node_handle();
+
+    /**
+     * Reports with this id are taken as our own, so it must be unique within
+     * the fleet and within the process if the source is in process.
+     */
+    m_id = get_parameter<std::string>("id");
+    if(m_id.empty()) {
+        throw BehaviorException("id of the vehicle is required");
+    }
+
+    m_leader = get_parameter<std::string>("leader");
+
+    m_offset_x = get_parameter<double>("offset_x");
+
+    m_offset_y = get_parameter<double>("offset_y");
+
+    m_position_gain = get_parameter<double>("position_gain");
+
+    m_separation_radius = get_parameter<double>("separation_radius");
+
+    m_separation_gain = get_parameter<double>("separation_gain");
+
+    m_max_speed = get_parameter<double>("max_speed");
+
+    m_timeout = get_parameter<double>("timeout");
+
+    m_report_period = get_parameter<double>("report_period");
+
+    auto source = get_parameter<std::string>("source");
+
+    if(source == "in_process") {
+        m_source = Source::IN_PROCESS;
+        m_bus = NeighborBus::instance(m_separation_radius);
+    } else {
+        if(source != "topic") {
+            ROS_ERROR_STREAM(get_name() << ": unknown source '" << source
+                << "', it must be 'topic' or 'in_process'");
+        }
+
+        m_source = Source::TOPIC;
+        m_bus = std::make_shared<NeighborBus>(m_separation_radius);
+
+        auto topic = get_parameter<std::string>("neighbor_topic");
+
+        m_report_publisher = m_pnh->advertise<nav_msgs::Odometry>(topic, 10);
+
+        m_neighbor_subscriber = m_pnh->subscribe(
+            topic, 100, &Formation::f_cb_neighbor, this);
+    }
+
+}
+
+void Formation::f_cb_neighbor(const nav_msgs::Odometry::ConstPtr& msg) {
+
+    if(msg->child_frame_id == m_id) {
+        return;
+    }
+
+    const auto& q = msg->pose.pose.orientation;
+
+    SpatialHash::report_t r;
+    r.id = msg->child_frame_id;
+    r.x = msg->pose.pose.position.x;
+    r.y = msg->pose.pose.position.y;
+    r.yaw = std::atan2(
+        2.0 * (q.w * q.z + q.x * q.y),
+        1.0 - 2.0 * (q.y * q.y + q.z * q.z));
+
+    // Twist is in the body frame of the vehicle
+    auto u = msg->twist.twist.linear.x;
+    auto v = msg->twist.twist.linear.y;
+    r.vx = u * std::cos(r.yaw) - v * std::sin(r.yaw);
+    r.vy = u * std::sin(r.yaw) + v * std::cos(r.yaw);
+
+    // Time of arrival, stamps of the other vehicles may not be in sync
+    r.stamp = ros::Time::now().toSec();
+
+    std::lock_guard<std::mutex> lock(m_bus->mutex);
+    m_bus->hash.update(r);
+
+}
+
+SpatialHash::report_t Formation::f_own_report(double stamp) {
+
+    SpatialHash::report_t r;
+
+    r.id = m_id;
+    r.x = m_process_values.position.x;
+    r.y = m_process_values.position.y;
+    r.yaw = m_process_values.orientation.z;
+
+    auto u = m_process_values.velocity.x;
+    auto v = m_process_values.velocity.y;
+    r.vx = u * std::cos(r.yaw) - v * std::sin(r.yaw);
+    r.vy = u * std::sin(r.yaw) + v * std::cos(r.yaw);
+
+    r.stamp = stamp;
+
+    return r;
+}
+
+void Formation::f_publish_report(const SpatialHash::report_t& report) {
+
+    nav_msgs::Odometry msg;
+    msg.header.stamp = ros::Time::now();
+    msg.header.frame_id = m_process_values.header.frame_id;
+    msg.child_frame_id = report.id;
+
+    msg.pose.pose.position.x = report.x;
+    msg.pose.pose.position.y = report.y;
+    msg.pose.pose.position.z = m_process_values.position.z;
+    msg.pose.pose.orientation.z = std::sin(report.yaw / 2.0);
+    msg.pose.pose.orientation.w = std::cos(report.yaw / 2.0);
+
+    msg.twist.twist.linear.x = m_process_values.velocity.x;
+    msg.twist.twist.linear.y = m_process_values.velocity.y;
+
+    m_report_publisher.publish(msg);
+
+}
+
+bool Formation::request_set_point(mvp_msgs::ControlProcess *set_point) {
+
+    auto now = ros::Time::now();
+
+    auto own = f_own_report(now.toSec());
+
+    if(m_source == Source::TOPIC &&
+        (now - m_last_report).toSec() >= m_report_period) {
+        m_last_report = now;
+        f_publish_report(own);
+    }
+
+    std::lock_guard<std::mutex> lock(m_bus->mutex);
+
+    // Other behaviors on the bus report the vehicles they run for
+    if(m_source == Source::IN_PROCESS) {
+        m_bus->hash.update(own);
+    }
+
+    if(now.toSec() - m_bus->last_prune >= 1.0) {
+        m_bus->last_prune = now.toSec();
+        m_bus->hash.prune(now.toSec() - m_timeout);
+    }
+
+    if(!m_activated || m_leader.empty()) {
+        return false;
+    }
+
+    auto leader = m_bus->hash.find(m_leader);
+    if(leader == nullptr) {
+        return false;
+    }
+
+    // Slot of the vehicle in the formation
+    auto c = std::cos(leader->yaw);
+    auto s = std::sin(leader->yaw);
+    auto tx = leader->x + c * m_offset_x - s * m_offset_y;
+    auto ty = leader->y + s * m_offset_x + c * m_offset_y;
+
+    auto vx = leader->vx + m_position_gain * (tx - own.x);
+    auto vy = leader->vy + m_position_gain * (ty - own.y);
+
+    m_bus->hash.query(own.x, own.y, m_separation_radius, &m_neighbors);
+
+    for(const auto& n : m_neighbors) {
+        if(n->id == m_id) {
+            continue;
+        }
+
+        auto dx = own.x - n->x;
+        auto dy = own.y - n->y;
+        auto d = std::hypot(dx, dy);
+        if(d < 1e-3) {
+            continue;
+        }
+
+        auto k = m_separation_gain *
+            (m_separation_radius - d) / m_separation_radius / d;
+        vx += k * dx;
+        vy += k * dy;
+    }
+
+    auto speed = std::hypot(vx, vy);
+
+    set_point->velocity.x = std::min(speed, m_max_speed);
+
+    // Keep the heading of the leader when there is nothing to correct
+    set_point->orientation.z = speed > 1e-3 ? std::atan2(vy, vx) : leader->yaw;
+
+    return true;
+}
+
+
+PLUGINLIB_EXPORT_CLASS(helm::Formation, helm::BehaviorBase)
@@ -0,0 +1,205 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#pragma once
+
+#include "behavior_interface/behavior_base.h"
+#include "ros/ros.h"
+#include "nav_msgs/Odometry.h"
+
+#include "limits"
+
+#include "spatial_hash.h"
+
+namespace helm {
+
+    /**
+     * @brief Holds an offset to a leader while keeping clear of neighbors
+     *
+     * Vehicles report their position, heading and velocity as
+     * `nav_msgs/Odometry` where `child_frame_id` is the id of the vehicle.
+     * Reports are kept in a spatial hash so that the neighbors within the
+     * separation radius are found without going through the whole fleet.
+     *
+     * Desired velocity is the velocity of the leader, plus a term
+     * proportional to the distance to the formation slot, plus a repulsion
+     * from each neighbor closer than the separation radius.
+     */
+    class Formation : public BehaviorBase {
+    private:
+
+        enum class Source : int {
+            TOPIC,
+            IN_PROCESS
+        };
+
+        void initialize() override;
+
+        /**
+         * @brief Trivial node handler
+         */
+        ros::NodeHandlePtr m_pnh;
+
+        /**
+         * @brief Neighbor report subscriber
+         */
+        ros::Subscriber m_neighbor_subscriber;
+
+        /**
+         * @brief Own report publisher
+         */
+        ros::Publisher m_report_publisher;
+
+        Source m_source;
+
+        /**
+         * @brief Reports of the fleet
+         *
+         * Shared with the other formation behaviors of the process if the
+         * source is in process, private to this behavior otherwise.
+         */
+        std::shared_ptr<NeighborBus> m_bus;
+
+        //! @brief Id of this vehicle and its leader
+        std::string m_id;
+
+        std::string m_leader;
+
+        //! @brief Slot in the body frame of the leader, in meters
+        double m_offset_x;
+
+        double m_offset_y;
+
+        /**
+         * @brief Gain from the slot error to velocity, in 1/s
+         */
+        double m_position_gain;
+
+        /**
+         * @brief Neighbors closer than this are pushed away, in meters
+         */
+        double m_separation_radius;
+
+        /**
+         * @brief Repulsion speed at zero distance, in m/s
+         */
+        double m_separation_gain;
+
+        /**
+         * @brief Maximum surge speed commanded, in m/s
+         */
+        double m_max_speed;
+
+        /**
+         * @brief Reports older than this are dropped, in seconds
+         */
+        double m_timeout;
+
+        /**
+         * @brief Period of the own report on the topic, in seconds
+         */
+        double m_report_period;
+
+        ros::Time m_last_report;
+
+        /**
+         * @brief Scratch buffer of the neighbor query
+         */
+        std::vector<const SpatialHash::report_t*> m_neighbors;
+
+        /**
+         * @brief Own report built from the process values
+         */
+        SpatialHash::report_t f_own_report(double stamp);
+
+        /**
+         * @brief Publishes the own report to the topic
+         */
+        void f_publish_report(const SpatialHash::report_t& report);
+
+        /**
+         * @brief Neighbor report callback
+         */
+        void f_cb_neighbor(const nav_msgs::Odometry::ConstPtr& msg);
+
+    public:
+
+        static constexpr parameter_descriptor_t PARAMETERS[] = {
+            parameter_string("id", "",
+                "Id of the vehicle in the reports, required and unique"),
+            parameter_string("leader", "",
+                "Id of the leader, the vehicle doesn't move without it"),
+            parameter_double("offset_x", 0.0,
+                "Slot in the body frame of the leader, in meters"),
+            parameter_double("offset_y", 0.0,
+                "Slot in the body frame of the leader, in meters"),
+            parameter_double("position_gain", 0.2, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Gain of the slot error, in 1/s"),
+            parameter_double("separation_radius", 5.0, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Closer neighbors are pushed away, in meters"),
+            parameter_double("separation_gain", 1.0, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Speed of the separation, in m/s"),
+            parameter_double("max_speed", 1.5, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Upper bound of the surge velocity, in m/s"),
+            parameter_double("timeout", 5.0, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Older reports are dropped, in seconds"),
+            parameter_double("report_period", 0.5, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Period of the own report, in seconds"),
+            parameter_string("source", "topic",
+                "Source of the reports, one of topic or in_process"),
+            parameter_string("neighbor_topic", "/formation",
+                "Topic of the reports if the source is topic")
+        };
+
+        static constexpr topic_descriptor_t TOPICS[] = {
+            configured_input_topic("neighbor_topic", "nav_msgs/Odometry",
+                "Reports of the other vehicles"),
+            configured_output_topic("neighbor_topic", "nav_msgs/Odometry",
+                "Report of this vehicle")
+        };
+
+        static constexpr behavior_descriptor_t DESCRIPTOR = make_descriptor(
+            dof_mask(
+                mvp_msgs::ControlMode::DOF_SURGE,
+                mvp_msgs::ControlMode::DOF_YAW
+            ),
+            PARAMETERS,
+            TOPICS
+        );
+
+        const behavior_descriptor_t* get_descriptor() const override {
+            return &DESCRIPTOR;
+        }
+
+        Formation();
+
+        bool request_set_point(mvp_msgs::ControlProcess *msg) override;
+
+    };
+}
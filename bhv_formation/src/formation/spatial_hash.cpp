@@ -0,0 +1,190 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#include "spatial_hash.h"
+
+#include "algorithm"
+#include "cmath"
+
+using namespace helm;
+
+SpatialHash::SpatialHash(double cell_size) {
+
+    m_cell_size = cell_size > 0 ? cell_size : 10.0;
+
+}
+
+int64_t SpatialHash::f_key(int64_t cx, int64_t cy) const {
+
+    // Negative values can't be shifted
+    return static_cast<int64_t>(
+        (static_cast<uint64_t>(cx) << 32) ^
+            (static_cast<uint64_t>(cy) & 0xffffffff));
+
+}
+
+int64_t SpatialHash::f_key(double x, double y) const {
+
+    return f_key(static_cast<int64_t>(std::floor(x / m_cell_size)),
+                 static_cast<int64_t>(std::floor(y / m_cell_size)));
+
+}
+
+void SpatialHash::f_cell_remove(int64_t cell, size_t index) {
+
+    auto c = m_cells.find(cell);
+    if(c == m_cells.end()) {
+        return;
+    }
+
+    auto& v = c->second;
+    auto it = std::find(v.begin(), v.end(), index);
+    if(it != v.end()) {
+        *it = v.back();
+        v.pop_back();
+    }
+
+    if(v.empty()) {
+        m_cells.erase(c);
+    }
+
+}
+
+void SpatialHash::f_cell_replace(int64_t cell, size_t from, size_t to) {
+
+    auto c = m_cells.find(cell);
+    if(c == m_cells.end()) {
+        return;
+    }
+
+    std::replace(c->second.begin(), c->second.end(), from, to);
+
+}
+
+void SpatialHash::update(const report_t& report) {
+
+    auto cell = f_key(report.x, report.y);
+
+    auto it = m_index.find(report.id);
+
+    if(it == m_index.end()) {
+        m_index[report.id] = m_records.size();
+        m_cells[cell].push_back(m_records.size());
+        m_records.push_back({report, cell});
+        return;
+    }
+
+    auto& r = m_records[it->second];
+
+    if(r.cell != cell) {
+        f_cell_remove(r.cell, it->second);
+        m_cells[cell].push_back(it->second);
+        r.cell = cell;
+    }
+
+    r.report = report;
+
+}
+
+void SpatialHash::prune(double stamp) {
+
+    for(size_t i = 0 ; i < m_records.size() ; ) {
+        if(m_records[i].report.stamp >= stamp) {
+            i++;
+            continue;
+        }
+
+        // Swap with the last record and drop it
+        auto last = m_records.size() - 1;
+
+        f_cell_remove(m_records[i].cell, i);
+        m_index.erase(m_records[i].report.id);
+
+        if(i != last) {
+            f_cell_replace(m_records[last].cell, last, i);
+            m_index[m_records[last].report.id] = i;
+            m_records[i] = m_records[last];
+        }
+
+        m_records.pop_back();
+    }
+
+}
+
+const SpatialHash::report_t* SpatialHash::find(const std::string& id) const {
+
+    auto it = m_index.find(id);
+
+    return it == m_index.end() ? nullptr : &m_records[it->second].report;
+
+}
+
+void SpatialHash::query(double x, double y, double radius,
+                        std::vector<const report_t*>* out) const {
+
+    out->clear();
+
+    auto cx = static_cast<int64_t>(std::floor(x / m_cell_size));
+    auto cy = static_cast<int64_t>(std::floor(y / m_cell_size));
+
+    auto n = std::max<int64_t>(
+        1, static_cast<int64_t>(std::ceil(radius / m_cell_size)));
+
+    auto r2 = radius * radius;
+
+    for(int64_t i = cx - n ; i <= cx + n ; i++) {
+        for(int64_t j = cy - n ; j <= cy + n ; j++) {
+            auto c = m_cells.find(f_key(i, j));
+            if(c == m_cells.end()) {
+                continue;
+            }
+
+            for(const auto& idx : c->second) {
+                const auto& r = m_records[idx].report;
+                auto dx = r.x - x;
+                auto dy = r.y - y;
+                if(dx * dx + dy * dy <= r2) {
+                    out->push_back(&r);
+                }
+            }
+        }
+    }
+
+}
+
+std::shared_ptr<NeighborBus> NeighborBus::instance(double cell_size) {
+
+    static std::mutex mutex;
+
+    static std::weak_ptr<NeighborBus> bus;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto b = bus.lock();
+    if(!b) {
+        b = std::make_shared<NeighborBus>(cell_size);
+        bus = b;
+    }
+
+    return b;
+}
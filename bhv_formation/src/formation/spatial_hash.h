@@ -0,0 +1,146 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#pragma once
+
+#include "cstdint"
+#include "memory"
+#include "mutex"
+#include "string"
+#include "unordered_map"
+#include "vector"
+
+namespace helm {
+
+    /**
+     * @brief Position reports of the vehicles hashed into a uniform grid
+     *
+     * Cell size should be about the usual query radius. A query then looks
+     * at the 3x3 cells around the point, its cost depends on the local density
+     * of the vehicles rather than the size of the fleet. A report that stays
+     * in its cell is updated in place.
+     */
+    class SpatialHash {
+    public:
+
+        struct report_t {
+            std::string id;
+            double x;
+            double y;
+            double yaw;
+            //! @brief Velocity in the common frame
+            double vx;
+            double vy;
+            //! @brief Time of the report in seconds
+            double stamp;
+        };
+
+    private:
+
+        struct record_t {
+            report_t report;
+            int64_t cell;
+        };
+
+        double m_cell_size;
+
+        //! @brief Records, densely packed
+        std::vector<record_t> m_records;
+
+        //! @brief Index of each vehicle in #m_records
+        std::unordered_map<std::string, size_t> m_index;
+
+        //! @brief Indices of the records in each cell
+        std::unordered_map<int64_t, std::vector<size_t>> m_cells;
+
+        int64_t f_key(double x, double y) const;
+
+        int64_t f_key(int64_t cx, int64_t cy) const;
+
+        void f_cell_remove(int64_t cell, size_t index);
+
+        void f_cell_replace(int64_t cell, size_t from, size_t to);
+
+    public:
+
+        typedef std::shared_ptr<SpatialHash> Ptr;
+
+        explicit SpatialHash(double cell_size = 10.0);
+
+        /**
+         * @brief Insert or update a report
+         */
+        void update(const report_t& report);
+
+        /**
+         * @brief Remove the reports older than the given time
+         */
+        void prune(double stamp);
+
+        /**
+         * @brief Find the report of a vehicle
+         *
+         * @return nullptr if there is no report for the vehicle
+         */
+        const report_t* find(const std::string& id) const;
+
+        /**
+         * @brief Find the reports within a radius of a point
+         *
+         * @param x Point
+         * @param y Point
+         * @param radius Radius
+         * @param out Output, pointers are valid until the next modification
+         */
+        void query(double x, double y, double radius,
+                   std::vector<const report_t*>* out) const;
+
+        size_t size() const { return m_records.size(); }
+
+    };
+
+    /**
+     * @brief Spatial hash shared by the formation behaviors in a process
+     *
+     * It stands in for the neighbor topic when a fleet is simulated in a
+     * single process.
+     */
+    struct NeighborBus {
+
+        std::mutex mutex;
+
+        SpatialHash hash;
+
+        //! @brief Time of the last prune in seconds
+        double last_prune = 0;
+
+        explicit NeighborBus(double cell_size) : hash(cell_size) {}
+
+        /**
+         * @brief The bus of the process, created with the first request
+         */
+        static std::shared_ptr<NeighborBus> instance(double cell_size);
+
+    };
+
+}
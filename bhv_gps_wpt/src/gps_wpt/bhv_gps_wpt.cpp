@@ -31,9 +31,7 @@ using namespace helm;
 
 void GpsWaypoint::initialize() {
 
-    m_pnh.reset(
-        new ros::NodeHandle(ros::this_node::getName() + "/" + get_name())
-    );
+    m_pnh = create_node_handle();
 
     m_pnh->param<std::string>("state_fail", m_state_fail, "");
 
@@ -24,30 +24,99 @@
 #include "bhv_hold_position.h"
 #include "pluginlib/class_list_macros.h"
 
+#include "algorithm"
+#include "cmath"
+
 using namespace helm;
 
+constexpr parameter_descriptor_t HoldPosition::PARAMETERS[];
+
+constexpr topic_descriptor_t HoldPosition::TOPICS[];
+
+constexpr behavior_descriptor_t HoldPosition::DESCRIPTOR;
+
 void HoldPosition::initialize() {
 
-    m_pnh.reset(
-        new ros::NodeHandle(ros::this_node::getName() + "/" + get_name())
-    );
+    m_pnh = create_node_handle();
+
+    m_station_keeping = get_parameter<bool>("station_keeping");
+
+    m_watch_radius = get_parameter<double>("watch_radius");
+
+    m_release_radius = get_parameter<double>("release_radius");
 
-    BehaviorBase::m_dofs = decltype(m_dofs){
-        mvp_msgs::ControlMode::DOF_X,
-        mvp_msgs::ControlMode::DOF_Y,
-        mvp_msgs::ControlMode::DOF_Z,
-        mvp_msgs::ControlMode::DOF_YAW,
-        mvp_msgs::ControlMode::DOF_SURGE
-    };
+    m_drift_time_constant = get_parameter<double>("drift_time_constant");
+
+    m_min_drift_speed = get_parameter<double>("min_drift_speed");
+
+    m_release_radius = std::min(m_release_radius, m_watch_radius);
+
+    m_duty_cycle_publisher = m_pnh->advertise<std_msgs::Float64>(
+        "duty_cycle", 1);
 
 }
 
 HoldPosition::HoldPosition() {
     std::cout << "A message from the hold position behavior" << std::endl;
+
+    m_station_state = StationState::HOLDING;
+
+    m_drift_x = 0;
+    m_drift_y = 0;
+
+    m_holding_time = 0;
+    m_total_time = 0;
 }
 
 void HoldPosition::activated() {
     m_desired = m_process_values;
+
+    m_station_state = StationState::HOLDING;
+
+    m_drift_x = 0;
+    m_drift_y = 0;
+
+    m_last_x = m_process_values.position.x;
+    m_last_y = m_process_values.position.y;
+    m_last_time = ros::Time::now();
+
+    m_holding_time = 0;
+    m_total_time = 0;
+    m_last_report = m_last_time;
+}
+
+void HoldPosition::f_update_station(double dt) {
+
+    auto x = m_process_values.position.x;
+    auto y = m_process_values.position.y;
+
+    /**
+     * Drift is only observable when the controller is not acting on the
+     * position.
+     */
+    if(m_station_state == StationState::DRIFTING && dt > 0) {
+        auto a = std::min(dt / m_drift_time_constant, 1.0);
+        m_drift_x += a * ((x - m_last_x) / dt - m_drift_x);
+        m_drift_y += a * ((y - m_last_y) / dt - m_drift_y);
+    }
+
+    m_last_x = x;
+    m_last_y = y;
+
+    m_total_time += dt;
+    if(m_station_state == StationState::HOLDING) {
+        m_holding_time += dt;
+    }
+
+    auto dist = std::hypot(x - m_desired.position.x, y - m_desired.position.y);
+
+    if(m_station_state == StationState::DRIFTING && dist > m_watch_radius) {
+        m_station_state = StationState::HOLDING;
+    } else if(m_station_state == StationState::HOLDING &&
+        dist < m_release_radius) {
+        m_station_state = StationState::DRIFTING;
+    }
+
 }
 
 bool HoldPosition::request_set_point(
@@ -61,6 +130,37 @@ bool HoldPosition::request_set_point(
 
     p.orientation = m_desired.orientation;
 
+    if(m_station_keeping && m_activated) {
+        auto now = ros::Time::now();
+
+        f_update_station((now - m_last_time).toSec());
+
+        m_last_time = now;
+
+        if(m_station_state == StationState::DRIFTING) {
+            /**
+             * Zero position, heading and surge error, controller doesn't
+             * spend any effort. Surge is still bid on, otherwise the
+             * controller would brake the drift.
+             */
+            p.position.x = m_process_values.position.x;
+            p.position.y = m_process_values.position.y;
+            p.orientation.z = m_process_values.orientation.z;
+            p.velocity.x = m_process_values.velocity.x;
+        } else if(std::hypot(m_drift_x, m_drift_y) > m_min_drift_speed) {
+            // Head into the drift
+            p.orientation.z = std::atan2(-m_drift_y, -m_drift_x);
+        }
+
+        if((now - m_last_report).toSec() >= 1.0 && m_total_time > 0) {
+            std_msgs::Float64 duty_cycle;
+            duty_cycle.data = m_holding_time / m_total_time;
+            m_duty_cycle_publisher.publish(duty_cycle);
+
+            m_last_report = now;
+        }
+    }
+
     *set_point = p;
 
     return true;
@@ -30,9 +30,24 @@
 
 namespace helm {
 
+    /**
+     * @brief Holds the position that the vehicle had at the activation
+     *
+     * With station keeping enabled, the vehicle is allowed to drift inside a
+     * watch circle around the held position. Position is reacquired when the
+     * vehicle reaches the edge of the circle, and released again once it is
+     * back inside the release radius. While drifting, the set point follows
+     * the vehicle so that the controller doesn't act on the position. The
+     * drift is measured and the vehicle heads into it while holding.
+     */
     class HoldPosition : public BehaviorBase {
     private:
 
+        enum class StationState : int {
+            HOLDING,
+            DRIFTING
+        };
+
         void initialize() override;
 
         ros::NodeHandlePtr m_pnh;
@@ -41,8 +56,102 @@ namespace helm {
 
         mvp_msgs::ControlProcess m_desired;
 
+        /**
+         * @brief Duty cycle publisher
+         */
+        ros::Publisher m_duty_cycle_publisher;
+
+        bool m_station_keeping;
+
+        /**
+         * @brief Radius of the watch circle in meters
+         * Position is reacquired beyond this radius.
+         */
+        double m_watch_radius;
+
+        /**
+         * @brief Position is released within this radius, in meters
+         */
+        double m_release_radius;
+
+        /**
+         * @brief Time constant of the drift estimate in seconds
+         */
+        double m_drift_time_constant;
+
+        /**
+         * @brief Drift speed that the heading is adjusted for, in m/s
+         */
+        double m_min_drift_speed;
+
+        StationState m_station_state;
+
+        //! @brief Estimated drift velocity in the controller frame
+        double m_drift_x;
+
+        double m_drift_y;
+
+        //! @brief Position and time of the last iteration
+        double m_last_x;
+
+        double m_last_y;
+
+        ros::Time m_last_time;
+
+        //! @brief Time spent holding and in total since the activation
+        double m_holding_time;
+
+        double m_total_time;
+
+        ros::Time m_last_report;
+
+        /**
+         * @brief Updates the drift estimate and the duty cycle
+         *
+         * @param dt Time since the last iteration in seconds
+         */
+        void f_update_station(double dt);
+
     public:
 
+        static constexpr parameter_descriptor_t PARAMETERS[] = {
+            parameter_bool("station_keeping", false,
+                "Lets the vehicle drift inside the watch circle"),
+            parameter_double("watch_radius", 5.0, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Position is reacquired beyond this radius, in meters"),
+            parameter_double("release_radius", 1.0, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Position is released within this radius, in meters"),
+            parameter_double("drift_time_constant", 30.0, 1e-3,
+                std::numeric_limits<double>::infinity(),
+                "Time constant of the drift estimate, in seconds"),
+            parameter_double("min_drift_speed", 0.05, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Drift speed that the heading is adjusted for, in m/s")
+        };
+
+        static constexpr topic_descriptor_t TOPICS[] = {
+            output_topic("duty_cycle", "std_msgs/Float64",
+                "Fraction of the time spent holding")
+        };
+
+        static constexpr behavior_descriptor_t DESCRIPTOR = make_descriptor(
+            dof_mask(
+                mvp_msgs::ControlMode::DOF_X,
+                mvp_msgs::ControlMode::DOF_Y,
+                mvp_msgs::ControlMode::DOF_Z,
+                mvp_msgs::ControlMode::DOF_YAW,
+                mvp_msgs::ControlMode::DOF_SURGE
+            ),
+            PARAMETERS,
+            TOPICS
+        );
+
+        const behavior_descriptor_t* get_descriptor() const override {
+            return &DESCRIPTOR;
+        }
+
         HoldPosition();
 
         bool request_set_point(mvp_msgs::ControlProcess *msg) override;
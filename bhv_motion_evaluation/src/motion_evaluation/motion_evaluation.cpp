@@ -31,23 +31,17 @@
 
 using namespace helm;
 
+constexpr parameter_descriptor_t MotionEvaluation::PARAMETERS[];
+
+constexpr behavior_descriptor_t MotionEvaluation::DESCRIPTOR;
+
 MotionEvaluation::MotionEvaluation() : BehaviorBase() {
 
 }
 
 void MotionEvaluation::initialize() {
 
-    m_pnh.reset(
-        new ros::NodeHandle(ros::this_node::getName() + "/" + get_name())
-    );
-
-    BehaviorBase::m_dofs = decltype(m_dofs){
-        mvp_msgs::ControlMode::DOF_SURGE,
-        mvp_msgs::ControlMode::DOF_YAW_RATE,
-        mvp_msgs::ControlMode::DOF_PITCH_RATE,
-        mvp_msgs::ControlMode::DOF_YAW,
-        mvp_msgs::ControlMode::DOF_PITCH
-    };
+    m_pnh = create_node_handle();
 
     m_dynconf_server.setCallback(
         std::bind(&MotionEvaluation::f_dynconf_freqmag_cb, this,
@@ -56,7 +50,7 @@ void MotionEvaluation::initialize() {
         )
     );
 
-    m_pnh->param<bool>("square_wave", m_square_wave, false);
+    m_square_wave = get_parameter<bool>("square_wave");
 
     m_surge_phase = 0;
     m_pitch_rate_phase = 0;
@@ -77,6 +77,26 @@ namespace helm {
 
     public:
 
+        static constexpr parameter_descriptor_t PARAMETERS[] = {
+            parameter_bool("square_wave", false,
+                "Square waves instead of sine waves")
+        };
+
+        static constexpr behavior_descriptor_t DESCRIPTOR = make_descriptor(
+            dof_mask(
+                mvp_msgs::ControlMode::DOF_SURGE,
+                mvp_msgs::ControlMode::DOF_YAW_RATE,
+                mvp_msgs::ControlMode::DOF_PITCH_RATE,
+                mvp_msgs::ControlMode::DOF_YAW,
+                mvp_msgs::ControlMode::DOF_PITCH
+            ),
+            PARAMETERS
+        );
+
+        const behavior_descriptor_t* get_descriptor() const override {
+            return &DESCRIPTOR;
+        }
+
         MotionEvaluation();
 
 
@@ -24,20 +24,44 @@
 
 #include "path_following.h"
 #include "pluginlib/class_list_macros.h"
+#include "cstring"
 #include "memory"
 #include "vector"
 #include "thread"
 #include "functional"
 #include "cmath"
+#include "limits"
 #include "tf2_eigen/tf2_eigen.h"
 #include "tf2_geometry_msgs/tf2_geometry_msgs.h"
 
 using namespace helm;
 
+namespace {
+
+    /**
+     * @brief Progress on the path that a standby helm copies
+     */
+    struct checkpoint_t {
+        int32_t line_index;
+        float first_x;
+        float first_y;
+        float second_x;
+        float second_y;
+        double schedule_start;
+    };
+
+}
+
 PathFollowing::PathFollowing() : BehaviorBase() {
 
     m_line_index = 0;
 
+    m_overshoot_timer = 0;
+
+    m_overshoot_expired = false;
+
+    m_late_index = 0;
+
 }
 
 PathFollowing::~PathFollowing() {
@@ -50,11 +74,9 @@ PathFollowing::~PathFollowing() {
 
 void PathFollowing::initialize() {
 
-    m_pnh.reset(
-        new ros::NodeHandle(ros::this_node::getName() + "/" + get_name())
-    );
+    m_pnh = create_node_handle();
 
-    m_nh.reset(new ros::NodeHandle());
+    m_nh = create_node_handle("");
 
     BehaviorBase::m_dofs = decltype(m_dofs){
         mvp_msgs::ControlMode::DOF_SURGE,
@@ -86,6 +108,18 @@ void PathFollowing::initialize() {
     // Meter/Seconds
     m_pnh->param<double>("surge_velocity", m_surge_velocity, 0.5);
 
+    // Meter/Seconds, limits of the surge velocity to meet the deadlines
+    m_pnh->param<double>("min_surge_velocity", m_min_surge_velocity, 0.2);
+
+    // Meter/Seconds
+    m_pnh->param<double>(
+        "max_surge_velocity", m_max_surge_velocity, m_surge_velocity * 2.0);
+
+    // String: "activation" or "absolute", what the waypoint times count from
+    std::string time_reference;
+    m_pnh->param<std::string>("time_reference", time_reference, "activation");
+    m_absolute_time = time_reference == "absolute";
+
     // Arbitrary constant
     m_pnh->param<double>("beta_gain", m_beta_gain, 1.0);
 
@@ -95,6 +129,24 @@ void PathFollowing::initialize() {
     // String: A state to be requested after a failed execution
     m_pnh->param<std::string>("state_fail", m_state_fail, "");
 
+    // String: A state to be requested when a deadline can't be met
+    m_pnh->param<std::string>("state_infeasible", m_state_infeasible, "");
+
+    m_speed_schedule.set_limits(
+        m_surge_velocity, m_min_surge_velocity, m_max_surge_velocity);
+
+    // Meters, maximum distance of a dropped waypoint to the path, 0 disables
+    double simplify_tolerance;
+    m_pnh->param<double>("simplify_tolerance", simplify_tolerance, 0.0);
+    m_path_simplifier.set_memory_resource(get_memory_resource());
+
+    // Waypoints live in the arena of the behavior as well
+    PolymorphicAllocator<void> allocator(get_memory_resource());
+    m_waypoints = waypoints_t(allocator);
+    m_transformed_waypoints = waypoints_t(allocator);
+
+    m_path_simplifier.set_tolerance(simplify_tolerance);
+
     f_parse_param_waypoints();
 
     m_update_waypoint_sub = m_pnh->subscribe<geometry_msgs::PolygonStamped>(
@@ -143,15 +195,19 @@ void PathFollowing::f_waypoint_cb(
 
     if(append) {
 
-        // append
-        for(const auto& i : m->polygon.points) {
-            m_waypoints.polygon.points.emplace_back(i);
-        }
+        // append, appended waypoints have no deadline
+        f_simplify(m->polygon, true);
 
     } else {
 
         // replace
-        m_waypoints = *m;
+        m_waypoints.header.stamp = m->header.stamp;
+        m_waypoints.header.frame_id.assign(
+            m->header.frame_id.begin(), m->header.frame_id.end());
+
+        f_simplify(m->polygon, false);
+
+        m_deadlines.clear();
 
         m_line_index = 0;
 
@@ -159,6 +215,30 @@ void PathFollowing::f_waypoint_cb(
     }
 }
 
+bool PathFollowing::path_received(const std::string& frame_id,
+                          const std::vector<double>& x,
+                          const std::vector<double>& y)
+{
+    if(frame_id.empty()) {
+        return false;
+    }
+
+    geometry_msgs::PolygonStamped::Ptr m(new geometry_msgs::PolygonStamped);
+    m->header.stamp = ros::Time::now();
+    m->header.frame_id = frame_id;
+
+    for(size_t i = 0 ; i < x.size() && i < y.size() ; i++) {
+        geometry_msgs::Point32 p;
+        p.x = static_cast<float>(x[i]);
+        p.y = static_cast<float>(y[i]);
+        m->polygon.points.emplace_back(p);
+    }
+
+    f_waypoint_cb(m, false);
+
+    return true;
+}
+
 void PathFollowing::f_parse_param_waypoints() {
     XmlRpc::XmlRpcValue l;
     if(!m_pnh->getParam("waypoints", l)) {
@@ -181,35 +261,79 @@ void PathFollowing::f_parse_param_waypoints() {
 
     for(uint32_t i = 0; i < l.size() ; i++) {
         std::map<std::string, double> mp;
-        for(const auto& key : {"x", "y"}) {
+        mp["t"] = std::numeric_limits<double>::quiet_NaN();
+        for(const auto& key : {"x", "y", "t"}) {
             if (l[i][key].getType() == XmlRpc::XmlRpcValue::TypeDouble) {
                 mp[key] = static_cast<double>(l[i][key]);
             } else if (l[i][key].getType() == XmlRpc::XmlRpcValue::TypeInt) {
                 mp[key] = static_cast<int>(l[i][key]);
             }
         }
-        geometry_msgs::Point32 gp;
+        point32_t gp;
         gp.x = static_cast<float>(mp["x"]);
         gp.y = static_cast<float>(mp["y"]);
 
         m_waypoints.polygon.points.emplace_back(gp);
+
+        // Seconds, optional time to be at the waypoint
+        m_deadlines.emplace_back(mp["t"]);
+    }
+
+    m_waypoints.header.frame_id.assign(m_frame_id.begin(), m_frame_id.end());
+
+    // Waypoints written by hand are kept as they are
+    std::vector<PathSimplifier::point_t> points;
+    for(const auto& i : m_waypoints.polygon.points) {
+        points.push_back({i.x, i.y});
+    }
+    m_path_simplifier.append(points, true);
+
+}
+
+void PathFollowing::f_simplify(const geometry_msgs::Polygon& polygon,
+    bool append)
+{
+    if(!append) {
+        m_path_simplifier.clear();
+    }
+
+    // Vertices before the committed ones are the same as before
+    auto first = m_path_simplifier.get_committed();
+
+    std::vector<PathSimplifier::point_t> points;
+    points.reserve(polygon.points.size());
+    for(const auto& i : polygon.points) {
+        points.push_back({i.x, i.y});
     }
 
-    m_waypoints.header.frame_id = m_frame_id;
+    m_path_simplifier.append(points);
+
+    const auto& path = m_path_simplifier.get_path();
+
+    m_waypoints.polygon.points.resize(path.size());
+    for(size_t i = first ; i < path.size() ; i++) {
+        point32_t p;
+        p.x = static_cast<float>(path[i].x);
+        p.y = static_cast<float>(path[i].y);
+        m_waypoints.polygon.points[i] = p;
+    }
 
+    ROS_DEBUG_STREAM(get_name() << ": " << m_path_simplifier.get_received()
+        << " points are simplified to " << path.size() << " waypoints");
 }
 
 void
 PathFollowing::f_transform_waypoints(
     const std::string &target_frame,
-    const geometry_msgs::PolygonStamped &in,
-    geometry_msgs::PolygonStamped *out)
+    const waypoints_t &in,
+    waypoints_t *out)
 {
 
-    geometry_msgs::PolygonStamped tm;
+    PolymorphicAllocator<void> allocator(get_memory_resource());
+    waypoints_t tm(allocator);
 
     tm.header.stamp = ros::Time::now();
-    tm.header.frame_id = target_frame;
+    tm.header.frame_id.assign(target_frame.begin(), target_frame.end());
 
     try {
 
@@ -217,10 +341,11 @@ PathFollowing::f_transform_waypoints(
             geometry_msgs::PointStamped ps;
 
             if(in.header.frame_id[0] == '/') {
-                ps.header.frame_id =
-                    in.header.frame_id.substr(1, in.header.frame_id.length());
+                ps.header.frame_id.assign(
+                    in.header.frame_id.begin() + 1, in.header.frame_id.end());
             } else {
-                ps.header.frame_id = in.header.frame_id;
+                ps.header.frame_id.assign(
+                    in.header.frame_id.begin(), in.header.frame_id.end());
             }
 
             ps.point.x = pt.x;
@@ -229,7 +354,7 @@ PathFollowing::f_transform_waypoints(
             auto t = m_transform_buffer.transform(
                 ps, target_frame, ros::Duration(1.0));
 
-            geometry_msgs::Point32 p;
+            point32_t p;
             p.x = static_cast<float>(t.point.x);
             p.y = static_cast<float>(t.point.y);
 
@@ -255,8 +380,12 @@ void PathFollowing::f_next_line_segment() {
     if(m_line_index == length) {
         change_state(m_state_done);
         m_line_index = 0;
+
+        f_build_schedule(true);
     }
 
+    report_path_target(m_line_index);
+
 }
 
 void PathFollowing::activated() {
@@ -269,6 +398,52 @@ void PathFollowing::activated() {
 
 }
 
+size_t PathFollowing::save_checkpoint(uint8_t* data, size_t size) {
+
+    checkpoint_t c {
+        m_line_index,
+        m_wpt_first.x,
+        m_wpt_first.y,
+        m_wpt_second.x,
+        m_wpt_second.y,
+        m_schedule_start.toSec()
+    };
+
+    if(size < sizeof(c)) {
+        return 0;
+    }
+
+    std::memcpy(data, &c, sizeof(c));
+
+    return sizeof(c);
+
+}
+
+void PathFollowing::load_checkpoint(const uint8_t* data, size_t size) {
+
+    if(size != sizeof(checkpoint_t)) {
+        return;
+    }
+
+    checkpoint_t c;
+    std::memcpy(&c, data, sizeof(c));
+
+    m_line_index = c.line_index;
+    m_wpt_first.x = c.first_x;
+    m_wpt_first.y = c.first_y;
+    m_wpt_second.x = c.second_x;
+    m_wpt_second.y = c.second_y;
+    m_schedule_start.fromSec(c.schedule_start);
+
+    if(!m_transformed_waypoints.polygon.points.empty()) {
+        report_path_target(
+            m_line_index % m_transformed_waypoints.polygon.points.size());
+
+        f_build_schedule(false);
+    }
+
+}
+
 void PathFollowing::resume_or_start() {
     // Transform all the points into controller's frame
     geometry_msgs::PolygonStamped poly;
@@ -279,7 +454,7 @@ void PathFollowing::resume_or_start() {
     );
 
     // Push robots position as the first point
-    geometry_msgs::Point32 p;
+    point32_t p;
     p.x = static_cast<float>(m_process_values.position.x);
     p.y = static_cast<float>(m_process_values.position.y);
     m_wpt_first = p;
@@ -290,6 +465,76 @@ void PathFollowing::resume_or_start() {
         m_line_index % m_transformed_waypoints.polygon.points.size()
     ];
 
+    // Let the helm estimate what is left of the path
+    std::vector<double> xs, ys;
+    for(const auto& i : m_transformed_waypoints.polygon.points) {
+        xs.emplace_back(i.x);
+        ys.emplace_back(i.y);
+    }
+    report_path(xs, ys, m_surge_velocity);
+
+    report_path_target(
+        m_line_index % m_transformed_waypoints.polygon.points.size());
+
+    f_build_schedule(m_line_index == 0);
+
+}
+
+void PathFollowing::f_build_schedule(bool restart) {
+
+    std::vector<double> xs, ys;
+    for(const auto& i : m_transformed_waypoints.polygon.points) {
+        xs.emplace_back(i.x);
+        ys.emplace_back(i.y);
+    }
+
+    m_speed_schedule.set_path(xs, ys, m_deadlines);
+
+    if(!m_speed_schedule.has_deadlines()) {
+        return;
+    }
+
+    if(!m_absolute_time) {
+        if(restart || m_schedule_start.isZero()) {
+            m_schedule_start = ros::Time::now();
+        }
+        m_speed_schedule.shift(m_schedule_start.toSec());
+    }
+
+    m_late_index = xs.size();
+
+    f_check_schedule();
+
+}
+
+void PathFollowing::f_check_schedule() {
+
+    auto n = m_transformed_waypoints.polygon.points.size();
+    if(n == 0) {
+        return;
+    }
+
+    auto target = m_line_index % n;
+
+    auto distance = std::hypot(
+        m_transformed_waypoints.polygon.points[target].x -
+            m_process_values.position.x,
+        m_transformed_waypoints.polygon.points[target].y -
+            m_process_values.position.y);
+
+    auto violations = m_speed_schedule.check(
+        target, distance, ros::Time::now().toSec());
+
+    for(const auto& v : violations) {
+        ROS_WARN_STREAM("path following (" << get_name() << "): waypoint " <<
+            v.index << " needs " << v.required_speed << "m/s to be on time,"
+            " surge velocity is limited to [" << m_min_surge_velocity << ", " <<
+            m_max_surge_velocity << "]m/s");
+    }
+
+    if(!violations.empty() && !m_state_infeasible.empty()) {
+        change_state(m_state_infeasible);
+    }
 
 }
 
@@ -308,9 +553,11 @@ bool PathFollowing::request_set_point(mvp_msgs::ControlProcess *set_point) {
         return false;
     }
 
-    // Visualize the path and the segment
-    f_visualize_path();
-    f_visualize_segment();
+    // Visualize the path and the segment, unless helm is shedding load
+    if(visualization_enabled()) {
+        f_visualize_path();
+        f_visualize_segment();
+    }
 
     // Acquire vehicle position from the controller process
     double x = BehaviorBase::m_process_values.position.x;
@@ -340,16 +587,16 @@ bool PathFollowing::request_set_point(mvp_msgs::ControlProcess *set_point) {
         // we are at the opposite side now
         gamma_p = gamma_p + M_PI;
 
-        // record the time
-        auto t = ros::Time::now();
-
         // if overshoot timer is not set, set it now.
-        if((t - m_overshoot_timer).toSec() == t.toSec()) {
-            m_overshoot_timer = ros::Time::now();
+        if(m_overshoot_timer == 0 && !m_overshoot_expired) {
+            m_overshoot_timer = schedule_timer(m_overshoot_timeout, [this] {
+                m_overshoot_timer = 0;
+                m_overshoot_expired = true;
+            });
         }
 
         // check if overshoot timer passed the timeout.
-        if((t - m_overshoot_timer).toSec() > m_overshoot_timeout) {
+        if(m_overshoot_expired) {
             ROS_ERROR_THROTTLE(10, "Overshoot abort!");
             change_state(m_state_fail);
             return false;
@@ -369,17 +616,38 @@ bool PathFollowing::request_set_point(mvp_msgs::ControlProcess *set_point) {
 
     beta *= m_beta_gain;
 
-    // set an arbitrary velocity
+    auto dist = std::sqrt(Xke * Xke + Ye*Ye);
+
+    // set the surge velocity, scheduled if the waypoints have deadlines
     m_cmd.velocity.x = m_surge_velocity;
+    if(m_speed_schedule.has_deadlines()) {
+        m_cmd.velocity.x = m_speed_schedule.speed(
+            m_line_index % m_transformed_waypoints.polygon.points.size(),
+            dist, ros::Time::now().toSec());
+
+        auto index = m_speed_schedule.get_deadline_index();
+        if(m_speed_schedule.is_late() && index != m_late_index) {
+            m_late_index = index;
+
+            ROS_WARN_STREAM("path following (" << get_name() << "): waypoint "
+                << index << " will be late, it needs " <<
+                m_speed_schedule.get_required_speed() << "m/s");
+
+            if(!m_state_infeasible.empty()) {
+                change_state(m_state_infeasible);
+            }
+        }
+    }
 
     // set the heading for line of sight
     m_cmd.orientation.z = gamma_p + atan( - Ye / lookahead) - beta;
 
     // check the acceptance radius
-    auto dist = std::sqrt(Xke * Xke + Ye*Ye);
     if(dist < m_acceptance_radius ) {
         f_next_line_segment();
-        m_overshoot_timer.fromSec(0);
+        cancel_timer(m_overshoot_timer);
+        m_overshoot_timer = 0;
+        m_overshoot_expired = false;
     }
 
     /*
@@ -29,7 +29,9 @@ using namespace helm;
 
 void PathFollowing::f_visualize_path(bool clear) {
     visualization_msgs::Marker marker;
-    marker.header = m_transformed_waypoints.header;
+    marker.header.frame_id.assign(
+        m_transformed_waypoints.header.frame_id.begin(),
+        m_transformed_waypoints.header.frame_id.end());
     marker.header.stamp = ros::Time::now();
     marker.type = visualization_msgs::Marker::LINE_STRIP;
     if(clear) {
@@ -70,7 +72,9 @@ void PathFollowing::f_visualize_path(bool clear) {
 
 void PathFollowing::f_visualize_segment(bool clear) {
     visualization_msgs::Marker marker;
-    marker.header = m_transformed_waypoints.header;
+    marker.header.frame_id.assign(
+        m_transformed_waypoints.header.frame_id.begin(),
+        m_transformed_waypoints.header.frame_id.end());
     marker.header.stamp = ros::Time::now();
     marker.type = visualization_msgs::Marker::LINE_STRIP;
 
@@ -24,6 +24,7 @@
 
 #include "path_following_i.h"
 #include "pluginlib/class_list_macros.h"
+#include "cstring"
 #include "memory"
 #include "vector"
 #include "thread"
@@ -34,10 +35,30 @@
 
 using namespace helm;
 
+namespace {
+
+    /**
+     * @brief Progress on the path that a standby helm copies
+     */
+    struct checkpoint_t {
+        int32_t line_index;
+        float first_x;
+        float first_y;
+        float second_x;
+        float second_y;
+        double yint;
+    };
+
+}
+
 PathFollowingI::PathFollowingI() : BehaviorBase() {
 
     m_line_index = 0;
 
+    m_overshoot_timer = 0;
+
+    m_overshoot_expired = false;
+
 }
 
 PathFollowingI::~PathFollowingI() {
@@ -50,11 +71,9 @@ PathFollowingI::~PathFollowingI() {
 
 void PathFollowingI::initialize() {
 
-    m_pnh.reset(
-        new ros::NodeHandle(ros::this_node::getName() + "/" + get_name())
-    );
+    m_pnh = create_node_handle();
 
-    m_nh.reset(new ros::NodeHandle());
+    m_nh = create_node_handle("");
 
     BehaviorBase::m_dofs = decltype(m_dofs){
         mvp_msgs::ControlMode::DOF_SURGE,
@@ -97,6 +116,18 @@ void PathFollowingI::initialize() {
     // String: A state to be requested after a failed execution
     m_pnh->param<std::string>("state_fail", m_state_fail, "");
     
+    // Meters, maximum distance of a dropped waypoint to the path, 0 disables
+    double simplify_tolerance;
+    m_pnh->param<double>("simplify_tolerance", simplify_tolerance, 0.0);
+    m_path_simplifier.set_memory_resource(get_memory_resource());
+
+    // Waypoints live in the arena of the behavior as well
+    PolymorphicAllocator<void> allocator(get_memory_resource());
+    m_waypoints = waypoints_t(allocator);
+    m_transformed_waypoints = waypoints_t(allocator);
+
+    m_path_simplifier.set_tolerance(simplify_tolerance);
+
     f_parse_param_waypoints();
 
     m_update_waypoint_sub = m_pnh->subscribe<geometry_msgs::PolygonStamped>(
@@ -146,14 +177,16 @@ void PathFollowingI::f_waypoint_cb(
     if(append) {
 
         // append
-        for(const auto& i : m->polygon.points) {
-            m_waypoints.polygon.points.emplace_back(i);
-        }
+        f_simplify(m->polygon, true);
 
     } else {
 
         // replace
-        m_waypoints = *m;
+        m_waypoints.header.stamp = m->header.stamp;
+        m_waypoints.header.frame_id.assign(
+            m->header.frame_id.begin(), m->header.frame_id.end());
+
+        f_simplify(m->polygon, false);
 
         m_line_index = 0;
 
@@ -161,6 +194,30 @@ void PathFollowingI::f_waypoint_cb(
     }
 }
 
+bool PathFollowingI::path_received(const std::string& frame_id,
+                          const std::vector<double>& x,
+                          const std::vector<double>& y)
+{
+    if(frame_id.empty()) {
+        return false;
+    }
+
+    geometry_msgs::PolygonStamped::Ptr m(new geometry_msgs::PolygonStamped);
+    m->header.stamp = ros::Time::now();
+    m->header.frame_id = frame_id;
+
+    for(size_t i = 0 ; i < x.size() && i < y.size() ; i++) {
+        geometry_msgs::Point32 p;
+        p.x = static_cast<float>(x[i]);
+        p.y = static_cast<float>(y[i]);
+        m->polygon.points.emplace_back(p);
+    }
+
+    f_waypoint_cb(m, false);
+
+    return true;
+}
+
 void PathFollowingI::f_parse_param_waypoints() {
     XmlRpc::XmlRpcValue l;
     if(!m_pnh->getParam("waypoints", l)) {
@@ -190,27 +247,67 @@ void PathFollowingI::f_parse_param_waypoints() {
                 mp[key] = static_cast<int>(l[i][key]);
             }
         }
-        geometry_msgs::Point32 gp;
+        point32_t gp;
         gp.x = static_cast<float>(mp["x"]);
         gp.y = static_cast<float>(mp["y"]);
 
         m_waypoints.polygon.points.emplace_back(gp);
     }
 
-    m_waypoints.header.frame_id = m_frame_id;
+    m_waypoints.header.frame_id.assign(m_frame_id.begin(), m_frame_id.end());
+
+    // Waypoints written by hand are kept as they are
+    std::vector<PathSimplifier::point_t> points;
+    for(const auto& i : m_waypoints.polygon.points) {
+        points.push_back({i.x, i.y});
+    }
+    m_path_simplifier.append(points, true);
+
+}
+
+void PathFollowingI::f_simplify(const geometry_msgs::Polygon& polygon,
+    bool append)
+{
+    if(!append) {
+        m_path_simplifier.clear();
+    }
+
+    // Vertices before the committed ones are the same as before
+    auto first = m_path_simplifier.get_committed();
+
+    std::vector<PathSimplifier::point_t> points;
+    points.reserve(polygon.points.size());
+    for(const auto& i : polygon.points) {
+        points.push_back({i.x, i.y});
+    }
+
+    m_path_simplifier.append(points);
 
+    const auto& path = m_path_simplifier.get_path();
+
+    m_waypoints.polygon.points.resize(path.size());
+    for(size_t i = first ; i < path.size() ; i++) {
+        point32_t p;
+        p.x = static_cast<float>(path[i].x);
+        p.y = static_cast<float>(path[i].y);
+        m_waypoints.polygon.points[i] = p;
+    }
+
+    ROS_DEBUG_STREAM(get_name() << ": " << m_path_simplifier.get_received()
+        << " points are simplified to " << path.size() << " waypoints");
 }
 
 void PathFollowingI::f_transform_waypoints(
     const std::string &target_frame,
-    const geometry_msgs::PolygonStamped &in,
-    geometry_msgs::PolygonStamped *out)
+    const waypoints_t &in,
+    waypoints_t *out)
 {
 
-    geometry_msgs::PolygonStamped tm;
+    PolymorphicAllocator<void> allocator(get_memory_resource());
+    waypoints_t tm(allocator);
 
     tm.header.stamp = ros::Time::now();
-    tm.header.frame_id = target_frame;
+    tm.header.frame_id.assign(target_frame.begin(), target_frame.end());
 
     try {
 
@@ -218,10 +315,11 @@ void PathFollowingI::f_transform_waypoints(
             geometry_msgs::PointStamped ps;
 
             if(in.header.frame_id[0] == '/') {
-                ps.header.frame_id =
-                    in.header.frame_id.substr(1, in.header.frame_id.length());
+                ps.header.frame_id.assign(
+                    in.header.frame_id.begin() + 1, in.header.frame_id.end());
             } else {
-                ps.header.frame_id = in.header.frame_id;
+                ps.header.frame_id.assign(
+                    in.header.frame_id.begin(), in.header.frame_id.end());
             }
 
             ps.point.x = pt.x;
@@ -230,7 +328,7 @@ void PathFollowingI::f_transform_waypoints(
             auto t = m_transform_buffer.transform(
                 ps, target_frame, ros::Duration(1.0));
 
-            geometry_msgs::Point32 p;
+            point32_t p;
             p.x = static_cast<float>(t.point.x);
             p.y = static_cast<float>(t.point.y);
 
@@ -258,6 +356,8 @@ void PathFollowingI::f_next_line_segment() {
         m_line_index = 0;
     }
 
+    report_path_target(m_line_index);
+
 }
 
 void PathFollowingI::activated() {
@@ -270,6 +370,50 @@ void PathFollowingI::activated() {
 
 }
 
+size_t PathFollowingI::save_checkpoint(uint8_t* data, size_t size) {
+
+    checkpoint_t c {
+        m_line_index,
+        m_wpt_first.x,
+        m_wpt_first.y,
+        m_wpt_second.x,
+        m_wpt_second.y,
+        m_yint
+    };
+
+    if(size < sizeof(c)) {
+        return 0;
+    }
+
+    std::memcpy(data, &c, sizeof(c));
+
+    return sizeof(c);
+
+}
+
+void PathFollowingI::load_checkpoint(const uint8_t* data, size_t size) {
+
+    if(size != sizeof(checkpoint_t)) {
+        return;
+    }
+
+    checkpoint_t c;
+    std::memcpy(&c, data, sizeof(c));
+
+    m_line_index = c.line_index;
+    m_wpt_first.x = c.first_x;
+    m_wpt_first.y = c.first_y;
+    m_wpt_second.x = c.second_x;
+    m_wpt_second.y = c.second_y;
+    m_yint = c.yint;
+
+    if(!m_transformed_waypoints.polygon.points.empty()) {
+        report_path_target(
+            m_line_index % m_transformed_waypoints.polygon.points.size());
+    }
+
+}
+
 void PathFollowingI::resume_or_start() {
     // Transform all the points into controller's frame
     geometry_msgs::PolygonStamped poly;
@@ -280,7 +424,7 @@ void PathFollowingI::resume_or_start() {
     );
 
     // Push robots position as the first point
-    geometry_msgs::Point32 p;
+    point32_t p;
     p.x = static_cast<float>(m_process_values.position.x);
     p.y = static_cast<float>(m_process_values.position.y);
     m_wpt_first = p;
@@ -291,6 +435,17 @@ void PathFollowingI::resume_or_start() {
         m_line_index % m_transformed_waypoints.polygon.points.size()
     ];
 
+    // Let the helm estimate what is left of the path
+    std::vector<double> xs, ys;
+    for(const auto& i : m_transformed_waypoints.polygon.points) {
+        xs.emplace_back(i.x);
+        ys.emplace_back(i.y);
+    }
+    report_path(xs, ys, m_surge_velocity);
+
+    report_path_target(
+        m_line_index % m_transformed_waypoints.polygon.points.size());
+
 
 }
 
@@ -309,9 +464,11 @@ bool PathFollowingI::request_set_point(mvp_msgs::ControlProcess *set_point) {
         return false;
     }
 
-    // Visualize the path and the segment
-    f_visualize_path();
-    f_visualize_segment();
+    // Visualize the path and the segment, unless helm is shedding load
+    if(visualization_enabled()) {
+        f_visualize_path();
+        f_visualize_segment();
+    }
 
     // Acquire vehicle position from the controller process
     double x = BehaviorBase::m_process_values.position.x;
@@ -346,16 +503,16 @@ bool PathFollowingI::request_set_point(mvp_msgs::ControlProcess *set_point) {
         // we are at the opposite side now
         gamma_p = gamma_p + M_PI;
 
-        // record the time
-        auto t = ros::Time::now();
-
         // if overshoot timer is not set, set it now.
-        if((t - m_overshoot_timer).toSec() == t.toSec()) {
-            m_overshoot_timer = ros::Time::now();
+        if(m_overshoot_timer == 0 && !m_overshoot_expired) {
+            m_overshoot_timer = schedule_timer(m_overshoot_timeout, [this] {
+                m_overshoot_timer = 0;
+                m_overshoot_expired = true;
+            });
         }
 
         // check if overshoot timer passed the timeout.
-        if((t - m_overshoot_timer).toSec() > m_overshoot_timeout) {
+        if(m_overshoot_expired) {
             ROS_ERROR_THROTTLE(10, "Overshoot abort!");
             change_state(m_state_fail);
             return false;
@@ -390,7 +547,9 @@ bool PathFollowingI::request_set_point(mvp_msgs::ControlProcess *set_point) {
     auto dist = std::sqrt(dx2 * dx2 + dy2*dy2);
     if(dist < m_acceptance_radius ) {
         f_next_line_segment();
-        m_overshoot_timer.fromSec(0);
+        cancel_timer(m_overshoot_timer);
+        m_overshoot_timer = 0;
+        m_overshoot_expired = false;
     }
 
     /*
@@ -25,6 +25,7 @@
 #pragma once
 
 #include "behavior_interface/behavior_base.h"
+#include "behavior_interface/path_simplifier.h"
 #include "ros/ros.h"
 #include "mvp_msgs/ControlProcess.h"
 #include "geometry_msgs/PolygonStamped.h"
@@ -81,12 +82,27 @@ namespace helm {
          */
         ros::Publisher m_trajectory_segment_publisher;
 
+        /**
+         * @brief Waypoint messages that allocate from the arena of the
+         *        behavior, see #BehaviorBase::get_memory_resource
+         */
+        typedef geometry_msgs::PolygonStamped_<PolymorphicAllocator<void>>
+            waypoints_t;
+
+        typedef geometry_msgs::Point32_<PolymorphicAllocator<void>> point32_t;
+
         /**
          * @brief Waypoints to be traversed
          */
-        geometry_msgs::PolygonStamped m_waypoints;
+        waypoints_t m_waypoints;
+
+        waypoints_t m_transformed_waypoints;
 
-        geometry_msgs::PolygonStamped m_transformed_waypoints;
+        /**
+         * @brief Simplifies the waypoints received from the topics
+         * #PathFollowingI::m_waypoints holds its output.
+         */
+        PathSimplifier m_path_simplifier;
 
         /**
          * @brief Frame id of the points name
@@ -126,9 +142,13 @@ namespace helm {
 
         /**
          * @brief Overshoot timer
-         * This variable will hold the time it passed since the overshoot.
+         * It is scheduled when the overshoot is first detected and cancelled
+         * at the next line segment, 0 if it is not scheduled.
          */
-        ros::Time m_overshoot_timer;
+        uint64_t m_overshoot_timer;
+
+        //! @brief Set by the overshoot timer once the timeout passes
+        bool m_overshoot_expired;
 
         /**
          * @brief Done state
@@ -147,12 +167,12 @@ namespace helm {
         /**
          * @brief First point in the active line segment
          */
-        geometry_msgs::Point32 m_wpt_first;
+        point32_t m_wpt_first;
 
         /**
          * @brief Second point in the active line segment
          */
-        geometry_msgs::Point32 m_wpt_second;
+        point32_t m_wpt_second;
 
         /**
          * @brief Transform buffer for TF2
@@ -179,8 +199,8 @@ namespace helm {
          */
         void f_transform_waypoints(
             const std::string &target_frame,
-            const geometry_msgs::PolygonStamped &in,
-            geometry_msgs::PolygonStamped *out
+            const waypoints_t &in,
+            waypoints_t *out
         );
 
         /**
@@ -192,6 +212,14 @@ namespace helm {
         void f_waypoint_cb(const geometry_msgs::PolygonStamped::ConstPtr &m,
                            bool append);
 
+        /**
+         * @brief Simplifies the points and updates the waypoints
+         *
+         * @param polygon Points in the frame of the waypoints
+         * @param append Append if true, replace if false
+         */
+        void f_simplify(const geometry_msgs::Polygon& polygon, bool append);
+
         /**
          * @brief Progress to the next line segment
          */
@@ -221,11 +249,29 @@ namespace helm {
          */
         void activated() override;
 
+        /**
+         * @brief Replaces the waypoints with a path from another behavior,
+         *        e.g. the route of a return to rally behavior
+         */
+        bool path_received(const std::string& frame_id,
+                           const std::vector<double>& x,
+                           const std::vector<double>& y) override;
+
         /**
          * @brief This function is inherited from #BehaviorBase
          */
         void disabled() override {}
 
+        /**
+         * @brief Saves the line segment, see #BehaviorBase::save_checkpoint
+         */
+        size_t save_checkpoint(uint8_t* data, size_t size) override;
+
+        /**
+         * @brief This function is inherited from #BehaviorBase
+         */
+        void load_checkpoint(const uint8_t* data, size_t size) override;
+
         void resume_or_start();
 
     public:
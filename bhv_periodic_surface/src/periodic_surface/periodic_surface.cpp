@@ -27,27 +27,26 @@
 
 using namespace helm;
 
-void PeriodicSurface::initialize() {
+constexpr parameter_descriptor_t PeriodicSurface::PARAMETERS[];
+
+constexpr behavior_descriptor_t PeriodicSurface::DESCRIPTOR;
 
-    m_pnh.reset(
-        new ros::NodeHandle(ros::this_node::getName() + "/" + get_name())
-    );
+void PeriodicSurface::initialize() {
 
-    BehaviorBase::m_dofs = decltype(m_dofs){
-        mvp_msgs::ControlMode::DOF_PITCH,
-        mvp_msgs::ControlMode::DOF_Z
-    };
+    m_pnh = create_node_handle();
 
-    m_pnh->param("forward_distance", m_fwd_distance, 3.0);
+    m_fwd_distance = get_parameter<double>("forward_distance");
 
-    m_pnh->param<double>("max_pitch", m_max_pitch, M_PI_2);
-    m_pnh->param<double>("surface_interval", m_surface_interval, 10.0); //seconds
-    m_pnh->param<double>("surface_duration", m_surface_duration, 10.0); //seconds
+    m_max_pitch = get_parameter<double>("max_pitch");
+    m_surface_interval = get_parameter<double>("surface_interval");
+    m_surface_duration = get_parameter<double>("surface_duration");
 
     m_activated = false;
 
     m_bhv_state = BhvState::DISABLED;
 
+    m_timer = 0;
+
 }
 
 
@@ -63,8 +62,6 @@ PeriodicSurface::PeriodicSurface()
 void PeriodicSurface::activated() {
 
     // This will be triggered when the behaviour is activated.
-    m_start_time = ros::Time::now();
-
     m_bhv_state = BhvState::ENABLED;
 
     m_activated = true;
@@ -73,6 +70,10 @@ void PeriodicSurface::activated() {
 
 void PeriodicSurface::disabled() {
 
+    cancel_timer(m_timer);
+
+    m_timer = 0;
+
     m_bhv_state = BhvState::DISABLED;
 
     m_activated = false;
@@ -93,31 +94,28 @@ bool PeriodicSurface::request_set_point(mvp_msgs::ControlProcess *set_point)
         return false;
     }
 
-    //check depth to set m_surfaced_time
+    //check depth to start the surfacing duration
 
     if(m_bhv_state == BhvState::ENABLED) {
 
         if(BehaviorBase::m_process_values.position.z < 0.5){
             m_bhv_state = BhvState::WAITING;
-            m_surfaced_time = ros::Time::now();
-        }
 
-    } else if (m_bhv_state == BhvState::WAITING) {
+            // stay on the surface for the duration, then dive for the interval
+            m_timer = schedule_timer(m_surface_duration, [this] {
+                m_bhv_state = BhvState::DISABLED;
 
-        if(ros::Time::now().sec - m_surfaced_time.sec > m_surface_duration) {
-            m_bhv_state = BhvState::DISABLED;
-            m_start_time = ros::Time::now();
+                m_timer = schedule_timer(m_surface_interval, [this] {
+                    m_bhv_state = BhvState::ENABLED;
 
-            return false;
+                    m_timer = 0;
+                });
+            });
         }
 
     } else if (m_bhv_state == BhvState::DISABLED) {
 
-        if(ros::Time::now().sec - m_start_time.sec > m_surface_interval) {
-            m_bhv_state = BhvState::ENABLED;
-        } else {
-            return false;
-        }
+        return false;
 
     }
 
@@ -27,6 +27,7 @@
 #include "behavior_interface/behavior_base.h"
 #include "ros/ros.h"
 
+#include "cmath"
 
 namespace helm {
 
@@ -78,17 +79,12 @@ namespace helm {
         double m_surface_duration;
 
         /**
-         * @brief Unix time stamp of the time when behavior is activated again.
+         * @brief Timer of the surfacing duration or the interval
          *
-         * When it activated, it indicates the time when the vehicle starts to
-         * climb up again.
+         * It is scheduled when the vehicle is first surfaced, 0 while the
+         * vehicle climbs up.
          */
-        ros::Time m_start_time;
-
-        /**
-         * @brief Unix time stamp of the time when the vehicle is first surfaced
-         */
-        ros::Time m_surfaced_time;
+        uint64_t m_timer;
 
         /**
          * @brief Implementation of #BehaviorBase::activated
@@ -102,6 +98,33 @@ namespace helm {
 
     public:
 
+        static constexpr parameter_descriptor_t PARAMETERS[] = {
+            parameter_double("forward_distance", 3.0, 1e-3,
+                std::numeric_limits<double>::infinity(),
+                "Distance ahead that the depth is closed in, in meters"),
+            parameter_double("max_pitch", M_PI_2, 0, M_PI_2,
+                "Largest pitch angle, in radians"),
+            parameter_double("surface_interval", 10.0, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Time spent below the surface between two surfacings,"
+                " in seconds"),
+            parameter_double("surface_duration", 10.0, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Time spent on the surface, in seconds")
+        };
+
+        static constexpr behavior_descriptor_t DESCRIPTOR = make_descriptor(
+            dof_mask(
+                mvp_msgs::ControlMode::DOF_PITCH,
+                mvp_msgs::ControlMode::DOF_Z
+            ),
+            PARAMETERS
+        );
+
+        const behavior_descriptor_t* get_descriptor() const override {
+            return &DESCRIPTOR;
+        }
+
         PeriodicSurface();
 
         bool request_set_point(mvp_msgs::ControlProcess *msg) override;
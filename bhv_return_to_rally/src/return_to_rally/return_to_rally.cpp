@@ -0,0 +1,302 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#include "return_to_rally.h"
+#include "pluginlib/class_list_macros.h"
+#include "tf2_geometry_msgs/tf2_geometry_msgs.h"
+#include "chrono"
+
+using namespace helm;
+
+namespace {
+
+    /**
+     * @brief Reads a point defined as {x: .., y: ..}
+     */
+    bool parse_point(XmlRpc::XmlRpcValue& v, VisibilityGraph::point_t* p) {
+
+        if(v.getType() != XmlRpc::XmlRpcValue::TypeStruct) {
+            return false;
+        }
+
+        double xy[2];
+        const char* keys[2] = {"x", "y"};
+        for(int i = 0 ; i < 2 ; i++) {
+            if(!v.hasMember(keys[i])) {
+                return false;
+            }
+
+            auto& e = v[keys[i]];
+            if(e.getType() == XmlRpc::XmlRpcValue::TypeDouble) {
+                xy[i] = static_cast<double>(e);
+            } else if(e.getType() == XmlRpc::XmlRpcValue::TypeInt) {
+                xy[i] = static_cast<int>(e);
+            } else {
+                return false;
+            }
+        }
+
+        p->x = xy[0];
+        p->y = xy[1];
+
+        return true;
+    }
+
+}
+
+ReturnToRally::ReturnToRally() : BehaviorBase() {
+
+    m_active = false;
+
+    m_planned = false;
+
+}
+
+ReturnToRally::~ReturnToRally() {
+
+    m_route_publisher.shutdown();
+
+}
+
+void ReturnToRally::initialize() {
+
+    m_pnh = create_node_handle();
+
+    // String: Name of the path following behavior, e.g. "bhv_return"
+    m_pnh->param<std::string>("path_follower", m_path_follower, "");
+
+    std::string route_topic;
+
+    // Route is published here if there is no path follower
+    m_pnh->param<std::string>("route_topic", route_topic, "route");
+
+    m_pnh->param<std::string>("frame_id", m_frame_id, "");
+
+    // String: A state to be requested after the route is handed over
+    m_pnh->param<std::string>("state_done", m_state_done, "");
+
+    // String: A state to be requested if there is no route
+    m_pnh->param<std::string>("state_fail", m_state_fail, "");
+
+    f_parse_param_graph();
+
+    m_route_publisher = m_pnh->advertise<geometry_msgs::PolygonStamped>(
+        route_topic, 1);
+
+    m_transform_listener.reset(new
+        tf2_ros::TransformListener(m_transform_buffer)
+    );
+
+}
+
+void ReturnToRally::f_parse_param_graph() {
+
+    // Meters
+    double clearance;
+    m_pnh->param<double>("clearance", clearance, 2.0);
+    m_graph.set_clearance(clearance);
+
+    XmlRpc::XmlRpcValue l;
+    if(m_pnh->getParam("keep_out", l)) {
+        if(l.getType() != XmlRpc::XmlRpcValue::TypeArray) {
+            ROS_ERROR("keep_out polygons are not in type array format.");
+        } else {
+            for(int32_t i = 0 ; i < l.size() ; i++) {
+                if(l[i].getType() != XmlRpc::XmlRpcValue::TypeArray) {
+                    ROS_ERROR_STREAM("keep_out polygon " << i << " is not in"
+                        " type array format.");
+                    continue;
+                }
+
+                VisibilityGraph::polygon_t polygon;
+                for(int32_t j = 0 ; j < l[i].size() ; j++) {
+                    VisibilityGraph::point_t p;
+                    if(parse_point(l[i][j], &p)) {
+                        polygon.emplace_back(p);
+                    }
+                }
+
+                if(polygon.size() < 3) {
+                    ROS_ERROR_STREAM("keep_out polygon " << i << " must have"
+                        " at least 3 points.");
+                    continue;
+                }
+
+                m_graph.add_polygon(polygon);
+            }
+        }
+    }
+
+    XmlRpc::XmlRpcValue r;
+    if(m_pnh->getParam("rally_points", r) &&
+        r.getType() == XmlRpc::XmlRpcValue::TypeArray) {
+        for(int32_t i = 0 ; i < r.size() ; i++) {
+            VisibilityGraph::point_t p;
+            if(parse_point(r[i], &p)) {
+                m_graph.add_rally_point(p);
+            }
+        }
+    } else {
+        ROS_ERROR_STREAM("No rally points are defined for " << get_name());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    auto edges = m_graph.build();
+
+    std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+
+    ROS_INFO_STREAM(get_name() << ": visibility graph with "
+        << m_graph.get_node_count() << " nodes and " << edges
+        << " edges is built in " << d.count() * 1000.0 << "ms");
+
+}
+
+bool ReturnToRally::f_get_position(VisibilityGraph::point_t* p) {
+
+    if(m_frame_id.empty() || m_frame_id == m_process_values.header.frame_id) {
+        p->x = m_process_values.position.x;
+        p->y = m_process_values.position.y;
+        return true;
+    }
+
+    try {
+        geometry_msgs::PointStamped ps;
+        ps.header.frame_id = m_process_values.header.frame_id;
+        ps.point = m_process_values.position;
+
+        // Helm thread must not wait for the transform
+        auto t = m_transform_buffer.transform(ps, m_frame_id);
+
+        p->x = t.point.x;
+        p->y = t.point.y;
+
+        return true;
+    } catch(const tf2::TransformException& e) {
+        ROS_WARN_STREAM_THROTTLE(10, get_name() << ": vehicle position can"
+            " not be transformed to " << m_frame_id << ": " << e.what());
+        return false;
+    }
+
+}
+
+void ReturnToRally::f_plan() {
+
+    VisibilityGraph::point_t start;
+    if(!f_get_position(&start)) {
+        // try again in the next iteration
+        return;
+    }
+
+    m_planned = true;
+
+    std::vector<VisibilityGraph::point_t> route;
+    if(!m_graph.plan(start, &route)) {
+        ROS_ERROR_STREAM(get_name() << ": no route to a rally point from ("
+            << start.x << ", " << start.y << ")");
+
+        if(!m_state_fail.empty()) {
+            change_state(m_state_fail);
+        }
+        return;
+    }
+
+    std::string frame_id = m_frame_id.empty() ?
+        m_process_values.header.frame_id : m_frame_id;
+
+    if(!m_path_follower.empty()) {
+        std::vector<double> x, y;
+        x.reserve(route.size());
+        y.reserve(route.size());
+        for(const auto& i : route) {
+            x.emplace_back(i.x);
+            y.emplace_back(i.y);
+        }
+
+        /**
+         * The follower replaces its waypoints before it returns. Requesting
+         * the state change only afterwards keeps it from resuming on the old
+         * ones.
+         */
+        if(!send_path(m_path_follower, frame_id, x, y)) {
+            ROS_ERROR_STREAM(get_name() << ": behavior '" << m_path_follower
+                << "' didn't accept the route");
+
+            if(!m_state_fail.empty()) {
+                change_state(m_state_fail);
+            }
+            return;
+        }
+    } else {
+        geometry_msgs::PolygonStamped::Ptr msg(
+            new geometry_msgs::PolygonStamped);
+        msg->header.stamp = ros::Time::now();
+        msg->header.frame_id = frame_id;
+
+        for(const auto& i : route) {
+            geometry_msgs::Point32 p;
+            p.x = static_cast<float>(i.x);
+            p.y = static_cast<float>(i.y);
+            msg->polygon.points.emplace_back(p);
+        }
+
+        m_route_publisher.publish(msg);
+    }
+
+    ROS_INFO_STREAM(get_name() << ": route to rally point ("
+        << route.back().x << ", " << route.back().y << ") with "
+        << route.size() << " waypoints");
+
+    if(!m_state_done.empty()) {
+        change_state(m_state_done);
+    }
+
+}
+
+void ReturnToRally::activated() {
+
+    m_active = true;
+
+    m_planned = false;
+
+}
+
+void ReturnToRally::disabled() {
+
+    m_active = false;
+
+}
+
+bool ReturnToRally::request_set_point(mvp_msgs::ControlProcess *msg) {
+
+    if(m_active && !m_planned) {
+        f_plan();
+    }
+
+    return true;
+}
+
+/**
+ * @brief Behavior must export the class to the Plugin library.
+ */
+PLUGINLIB_EXPORT_CLASS(helm::ReturnToRally, helm::BehaviorBase)
@@ -0,0 +1,146 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#pragma once
+
+#include "behavior_interface/behavior_base.h"
+#include "ros/ros.h"
+#include "geometry_msgs/PolygonStamped.h"
+#include "tf2_ros/transform_listener.h"
+
+#include "visibility_graph.h"
+
+namespace helm {
+
+    /**
+     * @brief Return to rally behavior
+     *
+     * Keep-out polygons and rally points are read when the mission is loaded
+     * and a visibility graph is built over them. When the behavior gets
+     * activated, it plans the shortest route from the vehicle position to the
+     * closest rally point and hands it to a path following behavior with
+     * #BehaviorBase::send_path. The follower has the route before the state
+     * change is requested, so it never resumes on its old waypoints.
+     *
+     * This behavior doesn't control any degree of freedom. It is expected to
+     * request a state in which the path following behavior is active.
+     */
+    class ReturnToRally : public BehaviorBase {
+    private:
+
+        void initialize() override;
+
+        /**
+         * @brief Trivial node handler
+         */
+        ros::NodeHandlePtr m_pnh;
+
+        /**
+         * @brief Route publisher, used if there is no path follower
+         */
+        ros::Publisher m_route_publisher;
+
+        /**
+         * @brief Name of the path following behavior receiving the route
+         */
+        std::string m_path_follower;
+
+        /**
+         * @brief Graph over keep-out polygons and rally points
+         */
+        VisibilityGraph m_graph;
+
+        /**
+         * @brief Frame of the polygons and the rally points
+         * Frame of the process values is used if it is empty.
+         */
+        std::string m_frame_id;
+
+        /**
+         * @brief State to be requested after the route is handed over
+         */
+        std::string m_state_done;
+
+        /**
+         * @brief State to be requested if no route can be found
+         */
+        std::string m_state_fail;
+
+        /**
+         * @brief True while the behavior is active
+         */
+        bool m_active;
+
+        /**
+         * @brief True once a route is planned since the activation
+         */
+        bool m_planned;
+
+        /**
+         * @brief Transform buffer for TF2
+         */
+        tf2_ros::Buffer m_transform_buffer;
+
+        /**
+         * @brief Transform listener for TF2
+         */
+        std::shared_ptr<tf2_ros::TransformListener> m_transform_listener;
+
+        /**
+         * @brief Reads keep-out polygons and rally points, then builds the
+         *        graph
+         */
+        void f_parse_param_graph();
+
+        /**
+         * @brief Reads the vehicle position in #m_frame_id
+         *
+         * @param p Output
+         * @return true if the position is available
+         */
+        bool f_get_position(VisibilityGraph::point_t* p);
+
+        /**
+         * @brief Plans the route and hands it over to the path follower
+         */
+        void f_plan();
+
+        void activated() override;
+
+        void disabled() override;
+
+    public:
+
+        ReturnToRally();
+
+        ~ReturnToRally() override;
+
+        /**
+         * @brief This function is inherited from #BehaviorBase
+         * @param msg
+         * @return
+         */
+        bool request_set_point(mvp_msgs::ControlProcess *msg) override;
+
+    };
+}
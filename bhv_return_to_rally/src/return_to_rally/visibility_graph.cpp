@@ -0,0 +1,368 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#include "visibility_graph.h"
+
+#include "algorithm"
+#include "cmath"
+#include "functional"
+#include "limits"
+#include "queue"
+
+using namespace helm;
+
+namespace {
+
+    constexpr double EPSILON = 1e-9;
+
+    constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+    double cross(double ax, double ay, double bx, double by) {
+        return ax * by - ay * bx;
+    }
+
+    double distance(const VisibilityGraph::point_t& a,
+                    const VisibilityGraph::point_t& b) {
+        return std::hypot(b.x - a.x, b.y - a.y);
+    }
+
+    /**
+     * @brief Side of point p with respect to the line a-b
+     */
+    int side(const VisibilityGraph::point_t& a,
+             const VisibilityGraph::point_t& b,
+             const VisibilityGraph::point_t& p) {
+        auto c = cross(b.x - a.x, b.y - a.y, p.x - a.x, p.y - a.y);
+        return c > EPSILON ? 1 : (c < -EPSILON ? -1 : 0);
+    }
+
+    /**
+     * @brief Checks if segments a-b and p-q cross each other
+     *
+     * Touching at an end point or running along each other doesn't count.
+     * Nodes of the graph lie on the corners of the polygons, so the segments
+     * leaving them would otherwise be rejected.
+     */
+    bool crosses(const VisibilityGraph::point_t& a,
+                 const VisibilityGraph::point_t& b,
+                 const VisibilityGraph::point_t& p,
+                 const VisibilityGraph::point_t& q) {
+        return side(a, b, p) * side(a, b, q) < 0 &&
+               side(p, q, a) * side(p, q, b) < 0;
+    }
+
+    /**
+     * @brief Entry in the open list of A*
+     */
+    struct open_t {
+        double f;
+        double g;
+        size_t node;
+        //! Node that the entry is expanded from, NONE for the start point
+        size_t parent;
+
+        bool operator>(const open_t& o) const { return f > o.f; }
+    };
+
+}
+
+VisibilityGraph::VisibilityGraph() {
+
+    m_clearance = 0;
+
+}
+
+void VisibilityGraph::add_polygon(const polygon_t& polygon) {
+
+    if(polygon.size() < 3) {
+        return;
+    }
+
+    obstacle_t o;
+    o.polygon = polygon;
+
+    // Corners are found assuming counter clockwise order
+    double area = 0;
+    for(size_t i = 0 ; i < polygon.size() ; i++) {
+        const auto& a = polygon[i];
+        const auto& b = polygon[(i + 1) % polygon.size()];
+        area += cross(a.x, a.y, b.x, b.y);
+    }
+
+    if(area < 0) {
+        std::reverse(o.polygon.begin(), o.polygon.end());
+    }
+
+    o.min = o.max = o.polygon.front();
+    for(const auto& p : o.polygon) {
+        o.min.x = std::min(o.min.x, p.x);
+        o.min.y = std::min(o.min.y, p.y);
+        o.max.x = std::max(o.max.x, p.x);
+        o.max.y = std::max(o.max.y, p.y);
+    }
+
+    m_obstacles.emplace_back(o);
+
+}
+
+void VisibilityGraph::add_rally_point(const point_t& point) {
+
+    m_rally_points.emplace_back(point);
+
+}
+
+bool VisibilityGraph::f_inside(const obstacle_t& o, const point_t& p) const {
+
+    if(p.x < o.min.x || p.x > o.max.x || p.y < o.min.y || p.y > o.max.y) {
+        return false;
+    }
+
+    bool inside = false;
+    const auto& poly = o.polygon;
+    for(size_t i = 0, j = poly.size() - 1 ; i < poly.size() ; j = i++) {
+        if((poly[i].y > p.y) != (poly[j].y > p.y) &&
+            p.x < (poly[j].x - poly[i].x) * (p.y - poly[i].y) /
+                (poly[j].y - poly[i].y) + poly[i].x) {
+            inside = !inside;
+        }
+    }
+
+    return inside;
+}
+
+bool VisibilityGraph::f_visible(const point_t& a, const point_t& b,
+                                const std::vector<bool>* ignored) const {
+
+    point_t min {std::min(a.x, b.x), std::min(a.y, b.y)};
+    point_t max {std::max(a.x, b.x), std::max(a.y, b.y)};
+    point_t mid {(a.x + b.x) / 2.0, (a.y + b.y) / 2.0};
+
+    for(size_t k = 0 ; k < m_obstacles.size() ; k++) {
+
+        if(ignored != nullptr && (*ignored)[k]) {
+            continue;
+        }
+
+        const auto& o = m_obstacles[k];
+
+        if(max.x < o.min.x || min.x > o.max.x ||
+           max.y < o.min.y || min.y > o.max.y) {
+            continue;
+        }
+
+        const auto& poly = o.polygon;
+        for(size_t i = 0, j = poly.size() - 1 ; i < poly.size() ; j = i++) {
+            if(crosses(a, b, poly[j], poly[i])) {
+                return false;
+            }
+        }
+
+        /**
+         * A segment between two corners of the same polygon doesn't cross
+         * any of its edges when it runs through the inside.
+         */
+        if(f_inside(o, mid)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+double VisibilityGraph::f_heuristic(const point_t& p) const {
+
+    double h = std::numeric_limits<double>::infinity();
+    for(const auto& r : m_rally_points) {
+        h = std::min(h, distance(p, r));
+    }
+
+    return h;
+}
+
+size_t VisibilityGraph::build() {
+
+    m_nodes.clear();
+
+    /**
+     * Shortest routes only bend around convex corners. Each of them is pushed
+     * out along its bisector so that both of its edges are at least
+     * clearance away.
+     */
+    for(const auto& o : m_obstacles) {
+        const auto& poly = o.polygon;
+        auto n = poly.size();
+        for(size_t i = 0 ; i < n ; i++) {
+            const auto& a = poly[(i + n - 1) % n];
+            const auto& b = poly[i];
+            const auto& c = poly[(i + 1) % n];
+
+            if(cross(b.x - a.x, b.y - a.y, c.x - b.x, c.y - b.y) <= 0) {
+                continue;
+            }
+
+            auto l1 = distance(a, b);
+            auto l2 = distance(b, c);
+            if(l1 < EPSILON || l2 < EPSILON) {
+                continue;
+            }
+
+            // Outward normals of the edges
+            point_t n1 {(b.y - a.y) / l1, -(b.x - a.x) / l1};
+            point_t n2 {(c.y - b.y) / l2, -(c.x - b.x) / l2};
+
+            point_t dir {n1.x + n2.x, n1.y + n2.y};
+            auto len = std::hypot(dir.x, dir.y);
+            if(len < EPSILON) {
+                continue;
+            }
+            dir.x /= len;
+            dir.y /= len;
+
+            // Very sharp corners are limited to five times the clearance
+            auto d = m_clearance /
+                std::max(dir.x * n1.x + dir.y * n1.y, 0.2);
+
+            node_t node;
+            node.p = {b.x + dir.x * d, b.y + dir.y * d};
+            node.rally = false;
+            m_nodes.emplace_back(node);
+        }
+    }
+
+    // Corners pushed into another polygon are of no use
+    m_nodes.erase(std::remove_if(m_nodes.begin(), m_nodes.end(),
+        [this](const node_t& node) {
+            return std::any_of(m_obstacles.begin(), m_obstacles.end(),
+                [this, &node](const obstacle_t& o) {
+                    return f_inside(o, node.p);
+                });
+        }), m_nodes.end());
+
+    for(const auto& r : m_rally_points) {
+        node_t node;
+        node.p = r;
+        node.rally = true;
+        m_nodes.emplace_back(node);
+    }
+
+    size_t count = 0;
+    for(size_t i = 0 ; i < m_nodes.size() ; i++) {
+        for(size_t j = i + 1 ; j < m_nodes.size() ; j++) {
+            if(!f_visible(m_nodes[i].p, m_nodes[j].p)) {
+                continue;
+            }
+
+            auto cost = distance(m_nodes[i].p, m_nodes[j].p);
+            m_nodes[i].edges.push_back({j, cost});
+            m_nodes[j].edges.push_back({i, cost});
+            count++;
+        }
+    }
+
+    return count;
+}
+
+bool VisibilityGraph::plan(const point_t& start,
+                           std::vector<point_t>* route) const {
+
+    route->clear();
+
+    if(m_rally_points.empty()) {
+        return false;
+    }
+
+    std::vector<bool> ignored(m_obstacles.size(), false);
+    for(size_t k = 0 ; k < m_obstacles.size() ; k++) {
+        ignored[k] = f_inside(m_obstacles[k], start);
+    }
+
+    std::vector<double> g(m_nodes.size(),
+        std::numeric_limits<double>::infinity());
+    std::vector<size_t> parent(m_nodes.size(), NONE);
+    std::vector<bool> closed(m_nodes.size(), false);
+
+    std::priority_queue<open_t, std::vector<open_t>, std::greater<open_t>>
+        open;
+
+    /**
+     * Edges leaving the start point are checked lazily, only when they are
+     * popped from the open list. Most of them are never looked at.
+     */
+    for(size_t j = 0 ; j < m_nodes.size() ; j++) {
+        auto d = distance(start, m_nodes[j].p);
+        open.push({d + f_heuristic(m_nodes[j].p), d, j, NONE});
+    }
+
+    size_t goal = NONE;
+    while(!open.empty()) {
+        auto e = open.top();
+        open.pop();
+
+        if(closed[e.node]) {
+            continue;
+        }
+
+        if(e.parent == NONE) {
+            if(!f_visible(start, m_nodes[e.node].p, &ignored)) {
+                continue;
+            }
+        } else if(e.g > g[e.node]) {
+            continue;
+        }
+
+        g[e.node] = e.g;
+        parent[e.node] = e.parent;
+        closed[e.node] = true;
+
+        if(m_nodes[e.node].rally) {
+            goal = e.node;
+            break;
+        }
+
+        for(const auto& edge : m_nodes[e.node].edges) {
+            if(closed[edge.to]) {
+                continue;
+            }
+
+            auto cost = e.g + edge.cost;
+            if(cost < g[edge.to]) {
+                g[edge.to] = cost;
+                open.push({cost + f_heuristic(m_nodes[edge.to].p), cost,
+                    edge.to, e.node});
+            }
+        }
+    }
+
+    if(goal == NONE) {
+        return false;
+    }
+
+    for(auto i = goal ; i != NONE ; i = parent[i]) {
+        route->emplace_back(m_nodes[i].p);
+    }
+    route->emplace_back(start);
+
+    std::reverse(route->begin(), route->end());
+
+    return true;
+}
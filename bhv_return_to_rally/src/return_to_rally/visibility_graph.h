@@ -0,0 +1,137 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#pragma once
+
+#include "cstddef"
+#include "vector"
+
+namespace helm {
+
+    /**
+     * @brief Visibility graph over keep-out polygons and rally points
+     *
+     * Nodes of the graph are the convex corners of the keep-out polygons,
+     * pushed out by the clearance, and the rally points. Edges connect every
+     * pair of nodes that can see each other. The graph is built once, a
+     * route query only connects the start point to the cached graph and runs
+     * A* towards the closest rally point.
+     */
+    class VisibilityGraph {
+    public:
+
+        struct point_t {
+            double x;
+            double y;
+        };
+
+        typedef std::vector<point_t> polygon_t;
+
+    private:
+
+        struct edge_t {
+            size_t to;
+            double cost;
+        };
+
+        struct node_t {
+            point_t p;
+            bool rally;
+            std::vector<edge_t> edges;
+        };
+
+        struct obstacle_t {
+            polygon_t polygon;
+            point_t min;
+            point_t max;
+        };
+
+        double m_clearance;
+
+        std::vector<obstacle_t> m_obstacles;
+
+        std::vector<node_t> m_nodes;
+
+        std::vector<point_t> m_rally_points;
+
+        /**
+         * @brief Checks if segment a-b crosses any of the obstacles
+         *
+         * @param a First point
+         * @param b Second point
+         * @param ignored Obstacles to be ignored, may be null
+         * @return true if the segment is free
+         */
+        bool f_visible(const point_t& a, const point_t& b,
+                       const std::vector<bool>* ignored = nullptr) const;
+
+        /**
+         * @brief Checks if a point is inside an obstacle
+         */
+        bool f_inside(const obstacle_t& o, const point_t& p) const;
+
+        /**
+         * @brief Distance to the closest rally point, used as A* heuristic
+         */
+        double f_heuristic(const point_t& p) const;
+
+    public:
+
+        VisibilityGraph();
+
+        /**
+         * @brief Set the distance kept from the corners of the polygons
+         *
+         * @param clearance Clearance in meters
+         */
+        void set_clearance(double clearance) { m_clearance = clearance; }
+
+        void add_polygon(const polygon_t& polygon);
+
+        void add_rally_point(const point_t& point);
+
+        /**
+         * @brief Builds the graph. Must be called after all the polygons and
+         *        rally points are added.
+         *
+         * @return Number of edges in the graph
+         */
+        size_t build();
+
+        /**
+         * @brief Plans the shortest route from a point to a rally point
+         *
+         * If the start point is inside a keep-out polygon, that polygon is
+         * ignored while leaving the start point.
+         *
+         * @param start Start point
+         * @param route Output, start point followed by the route
+         * @return true if a route is found
+         */
+        bool plan(const point_t& start, std::vector<point_t>* route) const;
+
+        size_t get_node_count() const { return m_nodes.size(); }
+
+    };
+
+}
@@ -25,32 +25,76 @@
 #include "bhv_sawtooth_wave.h"
 #include "pluginlib/class_list_macros.h"
 
+#include "cmath"
+
 using namespace helm;
 
+constexpr parameter_descriptor_t SawtoothWave::PARAMETERS[];
+
+constexpr topic_descriptor_t SawtoothWave::TOPICS[];
+
+constexpr behavior_descriptor_t SawtoothWave::DESCRIPTOR;
+
 void SawtoothWave::initialize() {
 
-    m_pnh.reset(
-        new ros::NodeHandle(ros::this_node::getName() + "/" + get_name())
+    m_pnh = create_node_handle();
+
+    m_min_depth = get_parameter<double>("min_depth");
+
+    m_max_depth = get_parameter<double>("max_depth");
+
+    m_surge_velocity = get_parameter<double>("surge_velocity");
+
+    m_heading = get_parameter<double>("heading");
+
+    // default: 22.5 degrees
+    m_pitch = get_parameter<double>("pitch");
+
+    m_bhv_state = BHV_STATE::IDLE;
+
+    m_upper_depth = m_min_depth;
+
+    /**
+     * Adaptive turning
+     */
+    auto turning = get_parameter<std::string>("turning");
+
+    if(turning == "fixed") {
+        m_turning = TURNING::FIXED;
+    } else if(turning == "gradient") {
+        m_turning = TURNING::GRADIENT;
+    } else if(turning == "altitude") {
+        m_turning = TURNING::ALTITUDE;
+    } else {
+        throw BehaviorException("Unknown turning '" + turning + "', must be"
+            " one of fixed, gradient or altitude");
+    }
+
+    m_detector.configure(
+        get_parameter<double>("gradient/window"),
+        get_parameter<double>("gradient/min_gradient"),
+        get_parameter<double>("gradient/drop"),
+        get_parameter<double>("gradient/margin"),
+        get_parameter<double>("gradient/smoothing")
     );
 
-    m_pnh->param("min_depth", m_min_depth, 0.0); // meters
+    m_min_altitude = get_parameter<double>("altitude/min_altitude");
 
-    m_pnh->param("max_depth", m_max_depth, 5.0); // meters
+    m_altitude_band = get_parameter<double>("altitude/band");
 
-    m_pnh->param("surge_velocity", m_surge_velocity, 0.65); // m/s
+    m_altitude_smoothing = get_parameter<double>("altitude/smoothing");
 
-    m_pnh->param("heading", m_heading, 0.0); // radians
+    m_sample_timeout = get_parameter<double>("sample_timeout");
 
-    // radians. default: 22.5 degrees
-    m_pnh->param("pitch", m_pitch, 0.39269908169872414);
+    m_altitude = NAN;
 
-    BehaviorBase::m_dofs = decltype(m_dofs){
-        mvp_msgs::ControlMode::DOF_SURGE,
-        mvp_msgs::ControlMode::DOF_PITCH,
-        mvp_msgs::ControlMode::DOF_YAW
-    };
+    m_dropped = 0;
 
-    m_bhv_state = BHV_STATE::IDLE;
+    if(m_turning != TURNING::FIXED) {
+        m_profile_sub = m_pnh->subscribe(
+            get_parameter<std::string>("profile_topic"), 100,
+            &SawtoothWave::f_profile_cb, this);
+    }
 
 }
 
@@ -60,11 +104,13 @@ SawtoothWave::SawtoothWave() {
 
 void SawtoothWave::activated() {
 
+    m_upper_depth = m_min_depth;
+
+    m_detector.reset();
+
     if(BehaviorBase::m_process_values.position.z > m_max_depth) {
         m_bhv_state = BHV_STATE::ASCENDING;
-    }
-
-    if(BehaviorBase::m_process_values.position.z < m_min_depth) {
+    } else {
         m_bhv_state = BHV_STATE::DESCENDING;
     }
 }
@@ -75,25 +121,117 @@ void SawtoothWave::disabled() {
 
 }
 
+void SawtoothWave::f_profile_cb(const std_msgs::Float64::ConstPtr& msg) {
+
+    if(!m_samples.push(msg->data)) {
+        m_dropped++;
+    }
+
+}
+
+bool SawtoothWave::f_process_samples() {
+
+    auto depth = BehaviorBase::m_process_values.position.z;
+
+    bool turn = false;
+
+    double value;
+    while(m_samples.pop(&value)) {
+        if(!std::isfinite(value) || m_bhv_state == BHV_STATE::IDLE) {
+            continue;
+        }
+
+        m_last_sample = ros::Time::now();
+
+        if(m_turning == TURNING::GRADIENT) {
+            turn |= m_detector.update(depth, value);
+        } else if(m_turning == TURNING::ALTITUDE && value > 0) {
+            // Altimeters report zero or less without a bottom lock
+            m_altitude = std::isnan(m_altitude) ? value :
+                m_altitude + m_altitude_smoothing * (value - m_altitude);
+        }
+    }
+
+    if(m_dropped > 0) {
+        ROS_WARN_STREAM_THROTTLE(10, get_name() << ": " << m_dropped.exchange(0)
+            << " profile samples are dropped");
+    }
+
+    if(m_last_sample.isZero() ||
+        (ros::Time::now() - m_last_sample).toSec() > m_sample_timeout) {
+        if(m_bhv_state != BHV_STATE::IDLE) {
+            ROS_WARN_STREAM_THROTTLE(10, get_name() << ": no profile samples,"
+                " turning at min_depth and max_depth");
+        }
+        m_altitude = NAN;
+        return false;
+    }
+
+    if(m_turning == TURNING::ALTITUDE) {
+        return m_bhv_state == BHV_STATE::DESCENDING &&
+            m_altitude < m_min_altitude;
+    }
+
+    return turn;
+}
+
+void SawtoothWave::f_turn(BHV_STATE state, const std::string& reason) {
+
+    auto depth = BehaviorBase::m_process_values.position.z;
+
+    m_bhv_state = state;
+
+    m_upper_depth = m_min_depth;
+
+    if(state == BHV_STATE::ASCENDING && m_turning == TURNING::ALTITUDE &&
+        !std::isnan(m_altitude) && m_altitude_band > 0) {
+        /**
+         * Climb the band over the bottom seen at this dive
+         */
+        auto bottom = depth + m_altitude;
+        m_upper_depth = std::max(m_min_depth,
+            std::min(m_max_depth, bottom - m_min_altitude - m_altitude_band));
+    }
+
+    ROS_INFO_STREAM(get_name() << ": turning at " << depth << "m, " << reason
+        << (state == BHV_STATE::ASCENDING ?
+            ", climbing to " + std::to_string(m_upper_depth) + "m" : ""));
+
+    m_detector.reset();
+}
 
 bool SawtoothWave::request_set_point(
     mvp_msgs::ControlProcess *set_point) {
 
+    bool sensed_turn = m_turning != TURNING::FIXED && f_process_samples();
+
+    auto depth = BehaviorBase::m_process_values.position.z;
+
     set_point->orientation.z = m_heading;
 
     set_point->velocity.x = m_surge_velocity;
 
     if(m_bhv_state == BHV_STATE::ASCENDING) {
-        if(BehaviorBase::m_process_values.position.z < m_min_depth) {
-            m_bhv_state = BHV_STATE::DESCENDING;
+        if(depth < m_upper_depth || sensed_turn) {
+            f_turn(BHV_STATE::DESCENDING, depth < m_upper_depth ?
+                "reached the upper depth" : std::string("passed the gradient"
+                " peak at ") + std::to_string(m_detector.get_peak_depth())
+                + "m");
             return false;
         }
         set_point->orientation.y = m_pitch;
 
 
     } else if (m_bhv_state == BHV_STATE::DESCENDING){
-        if(BehaviorBase::m_process_values.position.z > m_max_depth) {
-            m_bhv_state = BHV_STATE::ASCENDING;
+        if(depth > m_max_depth || sensed_turn) {
+            std::string reason = "reached max_depth";
+            if(depth <= m_max_depth) {
+                reason = m_turning == TURNING::ALTITUDE ?
+                    "reached min_altitude" :
+                    "passed the gradient peak at " +
+                        std::to_string(m_detector.get_peak_depth()) + "m";
+            }
+            f_turn(BHV_STATE::ASCENDING, reason);
             return false;
         }
         set_point->orientation.y = -m_pitch;
@@ -102,4 +240,4 @@ bool SawtoothWave::request_set_point(
     return true;
 }
 
-PLUGINLIB_EXPORT_CLASS(helm::SawtoothWave, helm::BehaviorBase)
\ No newline at end of file
+PLUGINLIB_EXPORT_CLASS(helm::SawtoothWave, helm::BehaviorBase)
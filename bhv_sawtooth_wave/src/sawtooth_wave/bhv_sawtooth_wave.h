@@ -24,12 +24,34 @@
 
 #pragma once
 
+#include "atomic"
+#include "cmath"
+
 #include "behavior_interface/behavior_base.h"
 #include "ros/ros.h"
 #include "std_msgs/Float64.h"
 
+#include "gradient_detector.h"
+#include "spsc_queue.h"
+
 namespace helm {
 
+    /**
+     * @brief Yo-yo between two depths at a fixed pitch
+     *
+     * Turning depths are either fixed, min_depth and max_depth, or adapted
+     * every leg from a profile sensor:
+     *
+     *  - gradient: the vehicle turns once it has passed the strongest
+     *    gradient of the samples, e.g. the thermocline from a CTD, so that
+     *    it keeps crossing it.
+     *  - altitude: samples are the altitude over the bottom. The vehicle
+     *    turns at min_altitude and climbs altitude_band above it before
+     *    diving again.
+     *
+     * min_depth and max_depth stay as the limits. If the sensor goes quiet
+     * the behavior turns at the limits.
+     */
     class SawtoothWave : public BehaviorBase {
     private:
 
@@ -39,6 +61,12 @@ namespace helm {
             DESCENDING
         };
 
+        enum class TURNING : int {
+            FIXED,
+            GRADIENT,
+            ALTITUDE
+        };
+
         void initialize() override;
 
         double m_min_depth;
@@ -53,6 +81,52 @@ namespace helm {
 
         BHV_STATE m_bhv_state;
 
+        TURNING m_turning;
+
+        /**
+         * @brief Depth the vehicle turns at on the way up
+         * Adapted every dive in altitude mode, min_depth otherwise.
+         */
+        double m_upper_depth;
+
+        /**
+         * @brief Samples handed from the subscriber to the helm thread
+         */
+        SpscQueue<double, 256> m_samples;
+
+        //! @brief Samples dropped because the helm didn't keep up
+        std::atomic<size_t> m_dropped;
+
+        ros::Subscriber m_profile_sub;
+
+        GradientDetector m_detector;
+
+        //! @brief Smoothed altitude over the bottom, NAN if unknown
+        double m_altitude;
+
+        double m_min_altitude;
+
+        double m_altitude_band;
+
+        //! @brief Weight of a new altitude in the moving average
+        double m_altitude_smoothing;
+
+        //! @brief Sensor is ignored if it is silent for this many seconds
+        double m_sample_timeout;
+
+        ros::Time m_last_sample;
+
+        void f_profile_cb(const std_msgs::Float64::ConstPtr& msg);
+
+        /**
+         * @brief Feeds the queued samples to the detector at current depth
+         *
+         * @return true if the samples call for a turn
+         */
+        bool f_process_samples();
+
+        void f_turn(BHV_STATE state, const std::string& reason);
+
         /**
          * @brief trivial node handler
          */
@@ -64,6 +138,65 @@ namespace helm {
 
     public:
 
+        static constexpr parameter_descriptor_t PARAMETERS[] = {
+            parameter_double("min_depth", 0.0,
+                "Shallowest turning depth, in meters"),
+            parameter_double("max_depth", 5.0,
+                "Deepest turning depth, in meters"),
+            parameter_double("surge_velocity", 0.65, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Surge velocity, in m/s"),
+            parameter_double("heading", 0.0, "Heading, in radians"),
+            parameter_double("pitch", 0.39269908169872414, 0, M_PI_2,
+                "Pitch angle of the legs, in radians"),
+            parameter_string("turning", "fixed",
+                "Turning depths, one of fixed, gradient or altitude"),
+            parameter_string("profile_topic", "profile",
+                "Profile sensor of the adaptive turning"),
+            parameter_double("gradient/window", 0.5, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Depth step of the gradient, in meters"),
+            parameter_double("gradient/min_gradient", 0.1, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Weaker gradients are ignored, in units per meter"),
+            parameter_double("gradient/drop", 0.5, 0.0, 1.0,
+                "Fraction of the peak the gradient must fall below"),
+            parameter_double("gradient/margin", 1.0, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Distance past the peak before turning, in meters"),
+            parameter_double("gradient/smoothing", 0.3, 0.0, 1.0,
+                "Weight of a new sample in the moving average"),
+            parameter_double("altitude/min_altitude", 5.0, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Altitude that the vehicle turns at, in meters"),
+            parameter_double("altitude/band", 10.0, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Climb above the minimum altitude, in meters"),
+            parameter_double("altitude/smoothing", 0.3, 0.0, 1.0,
+                "Weight of a new altitude in the moving average"),
+            parameter_double("sample_timeout", 2.0, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Turning falls back to the limits after it, in seconds")
+        };
+
+        static constexpr topic_descriptor_t TOPICS[] = {
+            configured_input_topic("profile_topic", "std_msgs/Float64",
+                "Profile samples, subscribed unless the turning is fixed")
+        };
+
+        static constexpr behavior_descriptor_t DESCRIPTOR = make_descriptor(
+            dof_mask(
+                mvp_msgs::ControlMode::DOF_SURGE,
+                mvp_msgs::ControlMode::DOF_PITCH,
+                mvp_msgs::ControlMode::DOF_YAW
+            ),
+            PARAMETERS,
+            TOPICS
+        );
+
+        const behavior_descriptor_t* get_descriptor() const override {
+            return &DESCRIPTOR;
+        }
 
         SawtoothWave();
 
@@ -0,0 +1,102 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#include "gradient_detector.h"
+
+#include "cmath"
+
+using namespace helm;
+
+GradientDetector::GradientDetector() {
+
+    configure(0.5, 0.1, 0.5, 1.0, 0.3);
+
+    m_started = false;
+
+    reset();
+
+}
+
+void GradientDetector::configure(double window, double min_gradient,
+                                 double drop, double margin,
+                                 double smoothing) {
+
+    m_window = window;
+
+    m_min_gradient = min_gradient;
+
+    m_drop = drop;
+
+    m_margin = margin;
+
+    m_smoothing = smoothing;
+
+}
+
+void GradientDetector::reset() {
+
+    m_peak = 0;
+
+    m_peak_depth = 0;
+
+    m_anchor_depth = NAN;
+
+}
+
+bool GradientDetector::update(double depth, double value) {
+
+    if(!m_started) {
+        m_started = true;
+        m_smoothed = value;
+    } else {
+        m_smoothed += m_smoothing * (value - m_smoothed);
+    }
+
+    // First sample of a leg
+    if(std::isnan(m_anchor_depth)) {
+        m_anchor_depth = depth;
+        m_anchor_value = m_smoothed;
+        return false;
+    }
+
+    auto dz = depth - m_anchor_depth;
+    if(std::fabs(dz) < m_window) {
+        return false;
+    }
+
+    auto gradient = std::fabs(m_smoothed - m_anchor_value) / std::fabs(dz);
+    auto gradient_depth = (depth + m_anchor_depth) / 2.0;
+
+    m_anchor_depth = depth;
+    m_anchor_value = m_smoothed;
+
+    if(gradient > m_peak) {
+        m_peak = gradient;
+        m_peak_depth = gradient_depth;
+    }
+
+    return m_peak >= m_min_gradient &&
+        gradient < m_drop * m_peak &&
+        std::fabs(depth - m_peak_depth) >= m_margin;
+
+}
@@ -0,0 +1,98 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#pragma once
+
+namespace helm {
+
+    /**
+     * @brief Streaming detector of a gradient peak along a vertical profile
+     *
+     * Finds the depth where a scalar, e.g. temperature, changes the most,
+     * such as a thermocline, while the vehicle passes through it. Samples are
+     * smoothed with an exponential moving average and the gradient is taken
+     * over a fixed depth step. The peak is passed once the gradient falls to
+     * a fraction of the strongest one and the vehicle is far enough from it.
+     * Each sample is O(1) in time and memory.
+     */
+    class GradientDetector {
+    private:
+
+        //! @brief Depth step of the finite difference, in meters
+        double m_window;
+
+        //! @brief Weaker peaks are ignored, in units per meter
+        double m_min_gradient;
+
+        //! @brief Fraction of the peak the gradient must fall below
+        double m_drop;
+
+        //! @brief Distance past the peak before it is reported, in meters
+        double m_margin;
+
+        //! @brief Weight of a new sample in the moving average, (0, 1]
+        double m_smoothing;
+
+        bool m_started;
+
+        double m_smoothed;
+
+        double m_anchor_depth;
+
+        double m_anchor_value;
+
+        double m_peak;
+
+        double m_peak_depth;
+
+    public:
+
+        GradientDetector();
+
+        void configure(double window, double min_gradient, double drop,
+                       double margin, double smoothing);
+
+        /**
+         * @brief Forgets the peak, e.g. at the start of a new leg
+         *
+         * Moving average is kept, the profile is continuous.
+         */
+        void reset();
+
+        /**
+         * @brief Adds a sample
+         *
+         * @param depth Depth of the sample in meters
+         * @param value
+         * @return true once the vehicle is past the peak
+         */
+        bool update(double depth, double value);
+
+        //! @brief Strongest gradient since the last reset, 0 if none
+        double get_peak() const { return m_peak; }
+
+        double get_peak_depth() const { return m_peak_depth; }
+
+    };
+
+}
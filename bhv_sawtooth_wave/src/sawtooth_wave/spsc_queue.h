@@ -0,0 +1,101 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#pragma once
+
+#include "array"
+#include "atomic"
+#include "cstddef"
+
+namespace helm {
+
+    /**
+     * @brief Bounded lock-free queue between one producer and one consumer
+     *
+     * A subscriber callback pushes and the helm thread pops, neither of them
+     * ever waits for the other. roscpp never calls the callback of a
+     * subscription concurrently with itself, so there is a single producer.
+     *
+     * @tparam T Copyable element
+     * @tparam N Capacity, a power of two
+     */
+    template <typename T, size_t N>
+    class SpscQueue {
+    private:
+
+        static_assert(N > 0 && (N & (N - 1)) == 0,
+            "capacity must be a power of two");
+
+        std::array<T, N> m_buffer;
+
+        //! @brief Next element to pop, written by the consumer
+        std::atomic<size_t> m_head;
+
+        //! @brief Next slot to push, written by the producer
+        std::atomic<size_t> m_tail;
+
+    public:
+
+        SpscQueue() : m_head(0), m_tail(0) {}
+
+        /**
+         * @brief Called by the producer
+         *
+         * @return false if the queue is full, the element is dropped
+         */
+        bool push(const T& value) {
+            auto tail = m_tail.load(std::memory_order_relaxed);
+
+            if(tail - m_head.load(std::memory_order_acquire) == N) {
+                return false;
+            }
+
+            m_buffer[tail & (N - 1)] = value;
+
+            m_tail.store(tail + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /**
+         * @brief Called by the consumer
+         *
+         * @return false if the queue is empty
+         */
+        bool pop(T* value) {
+            auto head = m_head.load(std::memory_order_relaxed);
+
+            if(head == m_tail.load(std::memory_order_acquire)) {
+                return false;
+            }
+
+            *value = m_buffer[head & (N - 1)];
+
+            m_head.store(head + 1, std::memory_order_release);
+
+            return true;
+        }
+
+    };
+
+}
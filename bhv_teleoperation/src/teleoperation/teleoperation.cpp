@@ -27,6 +27,12 @@
 
 using namespace helm;
 
+constexpr parameter_descriptor_t Teleoperation::PARAMETERS[];
+
+constexpr topic_descriptor_t Teleoperation::TOPICS[];
+
+constexpr behavior_descriptor_t Teleoperation::DESCRIPTOR;
+
 Teleoperation::Teleoperation()
   : m_use_joy(false), m_last_yaw (false), m_last_pitch(false) {
     std::cout << "A message from the teleoperation" << std::endl;
@@ -52,46 +58,23 @@ void Teleoperation::initialize() {
      * @note variables with redundant class names are used for emphesizing the
      * base class member variables.
      */
-    m_pnh.reset(
-        new ros::NodeHandle(ros::this_node::getName() + "/" + get_name())
-    );
+    m_pnh = create_node_handle();
 
-    m_nh.reset(new ros::NodeHandle(""));
+    m_nh = create_node_handle("");
 
     // ROS related: load parameters, setup sub/pub
 
-    m_pnh->param<double>("max_surge", m_max_surge, 1.0);
-    m_pnh->param<double>("max_pitch_rate", m_max_pitch_rate, 3.15);
-    m_pnh->param<double>("max_yaw_rate", m_max_yaw_rate, 3.15);
-    m_pnh->param<std::string>("joy_topic", m_joy_topic_name, "joy");
-    m_pnh->param<int>("joy_map/axes_surge", m_axes_surge, 1);
-    m_pnh->param<int>("joy_map/axes_pitch", m_axes_pitch, 4);
-    m_pnh->param<int>("joy_map/axes_yaw", m_axes_yaw, 3);
-    m_pnh->param<int>("joy_map/button_enable", m_button_enable, 5);
+    m_max_surge = get_parameter<double>("max_surge");
+    m_max_pitch_rate = get_parameter<double>("max_pitch_rate");
+    m_max_yaw_rate = get_parameter<double>("max_yaw_rate");
+    m_joy_topic_name = get_parameter<std::string>("joy_topic");
+    m_axes_surge = get_parameter<int>("joy_map/axes_surge");
+    m_axes_pitch = get_parameter<int>("joy_map/axes_pitch");
+    m_axes_yaw = get_parameter<int>("joy_map/axes_yaw");
+    m_button_enable = get_parameter<int>("joy_map/button_enable");
 
 
     m_joy_sub = m_nh->subscribe(m_joy_topic_name, 100, &Teleoperation::f_joy_cb, this);
-
-    /**
-     * @brief Declare the degree of freedoms to be controlled by the behavior
-     *
-     * @details This member variable dictates the DOFs that can be controllable
-     * by the behavior. If this member is not initialized, behavior can only
-     * trigger state changes. This vector gets values from enum type of
-     * mvp_msgs/ControlMode enums.
-     *
-     */
-    BehaviorBase::m_dofs = decltype(m_dofs){
-        // for flight mode
-        mvp_msgs::ControlMode::DOF_SURGE,
-        mvp_msgs::ControlMode::DOF_PITCH,
-        mvp_msgs::ControlMode::DOF_YAW,
-
-        // for another control mode
-        mvp_msgs::ControlMode::DOF_SURGE,
-        mvp_msgs::ControlMode::DOF_PITCH_RATE,
-        mvp_msgs::ControlMode::DOF_YAW_RATE,
-    };
 }
 
 void Teleoperation::f_joy_cb(const sensor_msgs::Joy::ConstPtr &m) {
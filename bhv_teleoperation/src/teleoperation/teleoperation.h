@@ -175,6 +175,52 @@ namespace helm {
 
     public:
 
+        static constexpr parameter_descriptor_t PARAMETERS[] = {
+            parameter_double("max_surge", 1.0, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Surge velocity at full stick, in m/s"),
+            parameter_double("max_pitch_rate", 3.15, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Pitch rate at full stick, in rad/s"),
+            parameter_double("max_yaw_rate", 3.15, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Yaw rate at full stick, in rad/s"),
+            parameter_string("joy_topic", "joy", "Joystick topic"),
+            parameter_int("joy_map/axes_surge", 1, 0,
+                std::numeric_limits<int>::max(), "Axis of the surge"),
+            parameter_int("joy_map/axes_pitch", 4, 0,
+                std::numeric_limits<int>::max(), "Axis of the pitch rate"),
+            parameter_int("joy_map/axes_yaw", 3, 0,
+                std::numeric_limits<int>::max(), "Axis of the yaw rate"),
+            parameter_int("joy_map/button_enable", 5, 0,
+                std::numeric_limits<int>::max(),
+                "Button that enables the joystick")
+        };
+
+        static constexpr topic_descriptor_t TOPICS[] = {
+            configured_input_topic("joy_topic", "sensor_msgs/Joy",
+                "Joystick, relative to the namespace of the helm")
+        };
+
+        static constexpr behavior_descriptor_t DESCRIPTOR = make_descriptor(
+            dof_mask(
+                // for flight mode
+                mvp_msgs::ControlMode::DOF_SURGE,
+                mvp_msgs::ControlMode::DOF_PITCH,
+                mvp_msgs::ControlMode::DOF_YAW,
+
+                // for another control mode
+                mvp_msgs::ControlMode::DOF_PITCH_RATE,
+                mvp_msgs::ControlMode::DOF_YAW_RATE
+            ),
+            PARAMETERS,
+            TOPICS
+        );
+
+        const behavior_descriptor_t* get_descriptor() const override {
+            return &DESCRIPTOR;
+        }
+
         /**
          * @brief Trivial constructor
          */
@@ -40,9 +40,7 @@ void BehaviorTemplate::initialize() {
      * @note variables with redundant class names are used for emphesizing the
      * base class member variables.
      */
-    m_pnh.reset(
-        new ros::NodeHandle(ros::this_node::getName() + "/" + get_name())
-    );
+    m_pnh = create_node_handle();
 
     /**
      * @brief Declare the degree of freedoms to be controlled by the behavior
@@ -41,15 +41,15 @@ namespace helm {
          * function, user is responsible for proper initalization of the
          * behavior. This function must be unblocking, otherwise, every other
          * behavior may wait this function to return. In this function user
-         * should create #ros::NodeHandle, and define controlled degrees of
-         * freedom. Below is a trivial implementation of this function
+         * should create #ros::NodeHandle with
+         * #BehaviorBase::create_node_handle, and define controlled degrees of
+         * freedom, unless the behavior declares them with its parameters in
+         * a #helm::behavior_descriptor_t, see #BehaviorBase::get_descriptor.
+         * Below is a trivial implementation of this function
          *
          * @code{.cpp}
          * void BehaviorTemplate::initalize() {
-         *   m_pnh.reset(
-         *     new ros::NodeHandle(ros::this_node::getName() + "/" +
-         *       BehaviorBase::m_name)
-         *   );
+         *   m_pnh = create_node_handle();
          *
          *   BehaviorBase::m_dofs = decltype(m_dofs){
          *     ctrl::DOF::SURGE
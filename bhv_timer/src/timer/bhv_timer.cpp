@@ -27,42 +27,46 @@
 
 using namespace helm;
 
-void Timer::initialize() {
+constexpr parameter_descriptor_t Timer::PARAMETERS[];
 
-    m_pnh.reset(
-        new ros::NodeHandle(ros::this_node::getName() + "/" + get_name())
-    );
+constexpr behavior_descriptor_t Timer::DESCRIPTOR;
 
-    if(!m_pnh->hasParam("duration")) {
-        // ill configuration
-    }
+void Timer::initialize() {
+
+    m_pnh = create_node_handle();
 
-    m_pnh->param<double>("duration", m_duration, 0.0);
+    m_duration = get_parameter<double>("duration");
 
-    // String: A state to be requested after a failed execution
-    m_pnh->param<std::string>("transition_to", m_transition_to, "");
+    m_transition_to = get_parameter<std::string>("transition_to");
 
 }
 
-Timer::Timer() {
+Timer::Timer() : m_timer(0) {
 
 }
 
 void Timer::activated() {
 
-    m_t = ros::Time::now();
+    if(m_duration != 0.0 && !m_transition_to.empty()) {
+        m_timer = schedule_timer(m_duration, [this] {
+            m_timer = 0;
+            change_state(m_transition_to);
+        });
+    }
 
 }
 
-bool Timer::request_set_point(mvp_msgs::ControlProcess *set_point) {
+void Timer::disabled() {
 
-    if(m_duration != 0.0 && !m_transition_to.empty()) {
+    cancel_timer(m_timer);
 
-        if((ros::Time::now() - m_t).toSec() > m_duration) {
-            change_state(m_transition_to);
-        }
-    }
+    m_timer = 0;
+
+}
+
+bool Timer::request_set_point(mvp_msgs::ControlProcess *set_point) {
 
+    // State change is requested by the timer
     return false;
 }
 
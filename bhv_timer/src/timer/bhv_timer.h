@@ -39,7 +39,10 @@ namespace helm {
 
         void activated() override;
 
-        ros::Time m_t;
+        void disabled() override;
+
+        //! @brief Timer scheduled at the activation, 0 if there is none
+        uint64_t m_timer;
 
         double m_duration;
 
@@ -47,6 +50,23 @@ namespace helm {
 
     public:
 
+        static constexpr parameter_descriptor_t PARAMETERS[] = {
+            parameter_double("duration", 0.0, 0.0,
+                std::numeric_limits<double>::infinity(),
+                "Time after the activation, in seconds, 0 disables the timer"),
+            parameter_string("transition_to", "",
+                "State to be requested when the time is up")
+        };
+
+        static constexpr behavior_descriptor_t DESCRIPTOR = make_descriptor(
+            dof_mask(),
+            PARAMETERS
+        );
+
+        const behavior_descriptor_t* get_descriptor() const override {
+            return &DESCRIPTOR;
+        }
+
         Timer();
 
         bool request_set_point(mvp_msgs::ControlProcess *msg) override;
@@ -26,12 +26,31 @@
 #include "pluginlib/class_list_macros.h"
 #include "geometry_msgs/PointStamped.h"
 
+#include "cmath"
+#include "cstring"
+#include "limits"
+
 using namespace helm;
 
+namespace {
+
+    /**
+     * @brief Progress on the path that a standby helm copies
+     */
+    struct checkpoint_t {
+        int32_t wpt_index;
+        int32_t reserved;
+        double schedule_start;
+    };
+
+}
+
 WaypointTracking::WaypointTracking() : BehaviorBase() {
 
     m_wpt_index = 0;
 
+    m_late_index = 0;
+
     std::cout << "A message from the waypoint tracking" << std::endl;
 
 }
@@ -46,11 +65,9 @@ WaypointTracking::~WaypointTracking() {
 
 void WaypointTracking::initialize() {
 
-    m_pnh.reset(
-        new ros::NodeHandle(ros::this_node::getName() + "/" + get_name())
-    );
+    m_pnh = create_node_handle();
 
-    m_nh.reset(new ros::NodeHandle());
+    m_nh = create_node_handle("");
 
     BehaviorBase::m_dofs = decltype(m_dofs){
         mvp_msgs::ControlMode::DOF_SURGE,
@@ -76,9 +93,39 @@ void WaypointTracking::initialize() {
     // Meter/Seconds
     m_pnh->param<double>("surge_velocity", m_surge_velocity, 0.5);
 
+    // Meter/Seconds, limits of the surge velocity to meet the deadlines
+    m_pnh->param<double>("min_surge_velocity", m_min_surge_velocity, 0.2);
+
+    // Meter/Seconds
+    m_pnh->param<double>(
+        "max_surge_velocity", m_max_surge_velocity, m_surge_velocity * 2.0);
+
+    // String: "activation" or "absolute", what the waypoint times count from
+    std::string time_reference;
+    m_pnh->param<std::string>("time_reference", time_reference, "activation");
+    m_absolute_time = time_reference == "absolute";
+
     // String: A state to be requested after a successful execution
     m_pnh->param<std::string>("state_done", m_state_done, "");
 
+    // String: A state to be requested when a deadline can't be met
+    m_pnh->param<std::string>("state_infeasible", m_state_infeasible, "");
+
+    m_speed_schedule.set_limits(
+        m_surge_velocity, m_min_surge_velocity, m_max_surge_velocity);
+
+    // Meters, maximum distance of a dropped waypoint to the path, 0 disables
+    double simplify_tolerance;
+    m_pnh->param<double>("simplify_tolerance", simplify_tolerance, 0.0);
+    m_path_simplifier.set_memory_resource(get_memory_resource());
+
+    // Waypoints live in the arena of the behavior as well
+    PolymorphicAllocator<void> allocator(get_memory_resource());
+    m_waypoints = waypoints_t(allocator);
+    m_transformed_waypoints = waypoints_t(allocator);
+
+    m_path_simplifier.set_tolerance(simplify_tolerance);
+
     f_parse_param_waypoints();
 
     m_waypoint_viz_pub = m_pnh->advertise<visualization_msgs::Marker>(
@@ -121,15 +168,41 @@ void WaypointTracking::f_waypoint_cb(
     }
 
     if(append) {
-        for(const auto& i : m->polygon.points) {
-            m_waypoints.polygon.points.emplace_back(i);
-        }
+        f_simplify(m->polygon, true);
     } else { /* replace */
-        m_waypoints = *m;
+        m_waypoints.header.stamp = m->header.stamp;
+        m_waypoints.header.frame_id.assign(
+            m->header.frame_id.begin(), m->header.frame_id.end());
+        f_simplify(m->polygon, false);
+        m_deadlines.clear();
         m_wpt_index = 0;
     }
 }
 
+bool WaypointTracking::path_received(const std::string& frame_id,
+                          const std::vector<double>& x,
+                          const std::vector<double>& y)
+{
+    if(frame_id.empty()) {
+        return false;
+    }
+
+    geometry_msgs::PolygonStamped::Ptr m(new geometry_msgs::PolygonStamped);
+    m->header.stamp = ros::Time::now();
+    m->header.frame_id = frame_id;
+
+    for(size_t i = 0 ; i < x.size() && i < y.size() ; i++) {
+        geometry_msgs::Point32 p;
+        p.x = static_cast<float>(x[i]);
+        p.y = static_cast<float>(y[i]);
+        m->polygon.points.emplace_back(p);
+    }
+
+    f_waypoint_cb(m, false);
+
+    return true;
+}
+
 void WaypointTracking::f_parse_param_waypoints() {
     XmlRpc::XmlRpcValue l;
     if(!m_pnh->getParam("waypoints", l)) {
@@ -151,48 +224,93 @@ void WaypointTracking::f_parse_param_waypoints() {
 
     for(uint32_t i = 0; i < l.size() ; i++) {
         std::map<std::string, double> mp;
-        for(const auto& key : {"x", "y"}) {
+        mp["t"] = std::numeric_limits<double>::quiet_NaN();
+        for(const auto& key : {"x", "y", "t"}) {
             if (l[i][key].getType() == XmlRpc::XmlRpcValue::TypeDouble) {
                 mp[key] = static_cast<double>(l[i][key]);
             } else if (l[i][key].getType() == XmlRpc::XmlRpcValue::TypeInt) {
                 mp[key] = static_cast<int>(l[i][key]);
             }
         }
-        geometry_msgs::Point32 gp;
+        point32_t gp;
         gp.x = static_cast<float>(mp["x"]);
         gp.y = static_cast<float>(mp["y"]);
 
         m_waypoints.polygon.points.emplace_back(gp);
+
+        // Seconds, optional time to be at the waypoint
+        m_deadlines.emplace_back(mp["t"]);
     }
 
-    m_waypoints.header.frame_id = m_frame_id;
+    m_waypoints.header.frame_id.assign(m_frame_id.begin(), m_frame_id.end());
+
+    // Waypoints written by hand are kept as they are
+    std::vector<PathSimplifier::point_t> points;
+    for(const auto& i : m_waypoints.polygon.points) {
+        points.push_back({i.x, i.y});
+    }
+    m_path_simplifier.append(points, true);
 
 }
 
+void WaypointTracking::f_simplify(const geometry_msgs::Polygon& polygon,
+    bool append)
+{
+    if(!append) {
+        m_path_simplifier.clear();
+    }
+
+    // Vertices before the committed ones are the same as before
+    auto first = m_path_simplifier.get_committed();
+
+    std::vector<PathSimplifier::point_t> points;
+    points.reserve(polygon.points.size());
+    for(const auto& i : polygon.points) {
+        points.push_back({i.x, i.y});
+    }
+
+    m_path_simplifier.append(points);
+
+    const auto& path = m_path_simplifier.get_path();
+
+    m_waypoints.polygon.points.resize(path.size());
+    for(size_t i = first ; i < path.size() ; i++) {
+        point32_t p;
+        p.x = static_cast<float>(path[i].x);
+        p.y = static_cast<float>(path[i].y);
+        m_waypoints.polygon.points[i] = p;
+    }
+
+    ROS_DEBUG_STREAM(get_name() << ": " << m_path_simplifier.get_received()
+        << " points are simplified to " << path.size() << " waypoints");
+}
+
 void
 WaypointTracking::f_transform_waypoints(
     const std::string &target_frame,
-    const geometry_msgs::PolygonStamped &in,
-    geometry_msgs::PolygonStamped *out)
+    const waypoints_t &in,
+    waypoints_t *out)
 {
 
-    geometry_msgs::PolygonStamped tm;
+    PolymorphicAllocator<void> allocator(get_memory_resource());
+    waypoints_t tm(allocator);
 
     tm.header.stamp = ros::Time::now();
-    tm.header.frame_id = target_frame;
+    tm.header.frame_id.assign(target_frame.begin(), target_frame.end());
 
     try {
 
         for (const auto &pt: in.polygon.points) {
             geometry_msgs::PointStamped ps;
-            ps.header.frame_id = in.header.frame_id;
+            ps.header.frame_id.assign(
+                in.header.frame_id.begin(), in.header.frame_id.end());
             ps.point.x = pt.x;
             ps.point.y = pt.y;
 
             auto t = m_transform_buffer.transform(
                 ps, target_frame, ros::Duration(1.0));
 
-            geometry_msgs::Point32 p;
+            point32_t p;
             p.x = static_cast<float>(t.point.x);
             p.y = static_cast<float>(t.point.y);
 
@@ -215,6 +333,38 @@ void WaypointTracking::activated() {
 
 }
 
+size_t WaypointTracking::save_checkpoint(uint8_t* data, size_t size) {
+
+    checkpoint_t c {m_wpt_index, 0, m_schedule_start.toSec()};
+
+    if(size < sizeof(c)) {
+        return 0;
+    }
+
+    std::memcpy(data, &c, sizeof(c));
+
+    return sizeof(c);
+
+}
+
+void WaypointTracking::load_checkpoint(const uint8_t* data, size_t size) {
+
+    if(size != sizeof(checkpoint_t)) {
+        return;
+    }
+
+    checkpoint_t c;
+    std::memcpy(&c, data, sizeof(c));
+
+    m_wpt_index = c.wpt_index;
+    m_schedule_start.fromSec(c.schedule_start);
+
+    if(!m_transformed_waypoints.polygon.points.empty()) {
+        f_build_schedule(false);
+    }
+
+}
+
 void WaypointTracking::resume_or_start() {
     // Transform all the points into controller's frame
     geometry_msgs::PolygonStamped poly;
@@ -224,6 +374,63 @@ void WaypointTracking::resume_or_start() {
         &m_transformed_waypoints
     );
 
+    f_build_schedule(m_wpt_index == 0);
+
+}
+
+void WaypointTracking::f_build_schedule(bool restart) {
+
+    std::vector<double> xs, ys;
+    for(const auto& i : m_transformed_waypoints.polygon.points) {
+        xs.emplace_back(i.x);
+        ys.emplace_back(i.y);
+    }
+
+    m_speed_schedule.set_path(xs, ys, m_deadlines);
+
+    if(!m_speed_schedule.has_deadlines()) {
+        return;
+    }
+
+    if(!m_absolute_time) {
+        if(restart || m_schedule_start.isZero()) {
+            m_schedule_start = ros::Time::now();
+        }
+        m_speed_schedule.shift(m_schedule_start.toSec());
+    }
+
+    m_late_index = xs.size();
+
+    f_check_schedule();
+
+}
+
+void WaypointTracking::f_check_schedule() {
+
+    if(static_cast<size_t>(m_wpt_index) >=
+        m_transformed_waypoints.polygon.points.size()) {
+        return;
+    }
+
+    auto wpt = m_transformed_waypoints.polygon.points[m_wpt_index];
+
+    auto distance = std::hypot(wpt.x - m_process_values.position.x,
+                               wpt.y - m_process_values.position.y);
+
+    auto violations = m_speed_schedule.check(
+        m_wpt_index, distance, ros::Time::now().toSec());
+
+    for(const auto& v : violations) {
+        ROS_WARN_STREAM("waypoint tracking (" << get_name() << "): waypoint "
+            << v.index << " needs " << v.required_speed << "m/s to be on time,"
+            " surge velocity is limited to [" << m_min_surge_velocity << ", " <<
+            m_max_surge_velocity << "]m/s");
+    }
+
+    if(!violations.empty() && !m_state_infeasible.empty()) {
+        change_state(m_state_infeasible);
+    }
+
 }
 
 bool WaypointTracking::request_set_point(mvp_msgs::ControlProcess *set_point) {
@@ -232,7 +439,9 @@ bool WaypointTracking::request_set_point(mvp_msgs::ControlProcess *set_point) {
         return false;
     }
 
-    f_visualize_waypoints();
+    if(visualization_enabled()) {
+        f_visualize_waypoints();
+    }
 
     auto wpt = m_transformed_waypoints.polygon.points[m_wpt_index];
 
@@ -247,6 +456,8 @@ bool WaypointTracking::request_set_point(mvp_msgs::ControlProcess *set_point) {
         if(m_transformed_waypoints.polygon.points.size() == m_wpt_index) {
             change_state(m_state_done);
             m_wpt_index = 0;
+
+            f_build_schedule(true);
         }
 
         // skip for this loop
@@ -256,6 +467,25 @@ bool WaypointTracking::request_set_point(mvp_msgs::ControlProcess *set_point) {
     set_point->orientation.z  = atan2(dist_y, dist_x);
     set_point->velocity.x = m_surge_velocity;
 
+    // Schedule the surge velocity if the waypoints have deadlines
+    if(m_speed_schedule.has_deadlines()) {
+        set_point->velocity.x = m_speed_schedule.speed(
+            m_wpt_index, dist, ros::Time::now().toSec());
+
+        auto index = m_speed_schedule.get_deadline_index();
+        if(m_speed_schedule.is_late() && index != m_late_index) {
+            m_late_index = index;
+
+            ROS_WARN_STREAM("waypoint tracking (" << get_name() << "): "
+                "waypoint " << index << " will be late, it needs " <<
+                m_speed_schedule.get_required_speed() << "m/s");
+
+            if(!m_state_infeasible.empty()) {
+                change_state(m_state_infeasible);
+            }
+        }
+    }
+
     /*
      * Use the result from the behavior
      */
@@ -25,6 +25,8 @@
 #pragma once
 
 #include "behavior_interface/behavior_base.h"
+#include "behavior_interface/path_simplifier.h"
+#include "behavior_interface/speed_schedule.h"
 #include "ros/ros.h"
 #include "std_msgs/Float64.h"
 #include "geometry_msgs/PolygonStamped.h"
@@ -68,12 +70,27 @@ namespace helm {
 
         ros::Publisher m_waypoint_viz_pub;
 
+        /**
+         * @brief Waypoint messages that allocate from the arena of the
+         *        behavior, see #BehaviorBase::get_memory_resource
+         */
+        typedef geometry_msgs::PolygonStamped_<PolymorphicAllocator<void>>
+            waypoints_t;
+
+        typedef geometry_msgs::Point32_<PolymorphicAllocator<void>> point32_t;
+
         /**
          * @brief Waypoints to be traversed
          */
-        geometry_msgs::PolygonStamped m_waypoints;
+        waypoints_t m_waypoints;
 
-        geometry_msgs::PolygonStamped m_transformed_waypoints;
+        waypoints_t m_transformed_waypoints;
+
+        /**
+         * @brief Simplifies the waypoints received from the topics
+         * #WaypointTracking::m_waypoints holds its output.
+         */
+        PathSimplifier m_path_simplifier;
 
         /**
          * @brief Frame id of the points name
@@ -95,6 +112,47 @@ namespace helm {
          */
         double m_surge_velocity;
 
+        /**
+         * @brief Surge velocity limits of the vehicle for the deadlines
+         */
+        double m_min_surge_velocity;
+
+        double m_max_surge_velocity;
+
+        /**
+         * @brief Deadline of each waypoint in seconds, NaN if there is none
+         * Deadlines are relative to the start of the waypoints unless
+         * #WaypointTracking::m_absolute_time is set.
+         */
+        std::vector<double> m_deadlines;
+
+        /**
+         * @brief True if the deadlines are ROS times rather than relative
+         */
+        bool m_absolute_time;
+
+        /**
+         * @brief Time that the relative deadlines count from
+         */
+        ros::Time m_schedule_start;
+
+        /**
+         * @brief Surge velocity schedule for the deadlines
+         */
+        SpeedSchedule m_speed_schedule;
+
+        /**
+         * @brief Index of the last deadline reported as missed
+         */
+        size_t m_late_index;
+
+        /**
+         * @brief Infeasible state
+         * Behavior will request a state change to helm with the value this
+         * variable holds when a deadline can't be met.
+         */
+        std::string m_state_infeasible;
+
         /**
          * @brief Done state
          * Behavior will request a state change to helm with the value this
@@ -125,8 +183,8 @@ namespace helm {
          * @param out
          */
         void f_transform_waypoints(const std::string &target_frame,
-                                   const geometry_msgs::PolygonStamped &in,
-                                   geometry_msgs::PolygonStamped *out);
+                                   const waypoints_t &in,
+                                   waypoints_t *out);
 
         /**
          * @brief Trivial waypoint callback
@@ -137,6 +195,26 @@ namespace helm {
         void f_waypoint_cb(const geometry_msgs::PolygonStamped::ConstPtr &m,
                            bool append);
 
+        /**
+         * @brief Simplifies the points and updates the waypoints
+         *
+         * @param polygon Points in the frame of the waypoints
+         * @param append Append if true, replace if false
+         */
+        void f_simplify(const geometry_msgs::Polygon& polygon, bool append);
+
+        /**
+         * @brief Builds the speed schedule from the transformed waypoints
+         *
+         * @param restart Relative deadlines count from now if true
+         */
+        void f_build_schedule(bool restart);
+
+        /**
+         * @brief Reports the deadlines that can't be met within the limits
+         */
+        void f_check_schedule();
+
         /**
          * @brief Destroy the Path Following object
          */
@@ -146,6 +224,21 @@ namespace helm {
 
         void activated() override;
 
+        /**
+         * @brief Replaces the waypoints with a path from another behavior,
+         *        e.g. the route of a return to rally behavior
+         */
+        bool path_received(const std::string& frame_id,
+                           const std::vector<double>& x,
+                           const std::vector<double>& y) override;
+
+        /**
+         * @brief Saves the waypoint index, see #BehaviorBase::save_checkpoint
+         */
+        size_t save_checkpoint(uint8_t* data, size_t size) override;
+
+        void load_checkpoint(const uint8_t* data, size_t size) override;
+
         void f_visualize_waypoints(bool clear = false);
     public:
 
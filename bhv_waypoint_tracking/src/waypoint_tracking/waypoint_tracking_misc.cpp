@@ -4,7 +4,9 @@ using namespace helm;
 
 void WaypointTracking::f_visualize_waypoints(bool clear) {
     visualization_msgs::Marker marker;
-    marker.header = m_transformed_waypoints.header;
+    marker.header.frame_id.assign(
+        m_transformed_waypoints.header.frame_id.begin(),
+        m_transformed_waypoints.header.frame_id.end());
     marker.header.stamp = ros::Time::now();
     marker.type = visualization_msgs::Marker::POINTS;
     if(clear) {
@@ -0,0 +1,159 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#include "cmaes.h"
+
+#include "algorithm"
+#include "cmath"
+#include "numeric"
+
+using namespace helm::tuner;
+
+CmaEs::CmaEs(const Eigen::VectorXd &mean, double sigma, size_t lambda,
+             uint32_t seed) : m_rng(seed) {
+
+    m_dim = static_cast<size_t>(mean.size());
+
+    auto n = static_cast<double>(m_dim);
+
+    m_lambda = lambda > 0 ? lambda :
+        4 + static_cast<size_t>(std::floor(3.0 * std::log(n)));
+
+    m_mu = m_lambda / 2;
+
+    m_weights.resize(static_cast<Eigen::Index>(m_mu));
+    for(size_t i = 0 ; i < m_mu ; i++) {
+        m_weights[i] = std::log(m_mu + 0.5) - std::log(i + 1.0);
+    }
+    m_weights /= m_weights.sum();
+
+    m_mueff = 1.0 / m_weights.squaredNorm();
+
+    m_cc = (4.0 + m_mueff / n) / (n + 4.0 + 2.0 * m_mueff / n);
+
+    m_cs = (m_mueff + 2.0) / (n + m_mueff + 5.0);
+
+    m_c1 = 2.0 / ((n + 1.3) * (n + 1.3) + m_mueff);
+
+    m_cmu = std::min(1.0 - m_c1, 2.0 * (m_mueff - 2.0 + 1.0 / m_mueff) /
+        ((n + 2.0) * (n + 2.0) + m_mueff));
+
+    m_damps = 1.0 + 2.0 * std::max(0.0,
+        std::sqrt((m_mueff - 1.0) / (n + 1.0)) - 1.0) + m_cs;
+
+    m_chi_n = std::sqrt(n) * (1.0 - 1.0 / (4.0 * n) + 1.0 / (21.0 * n * n));
+
+    m_mean = mean;
+
+    m_sigma = sigma;
+
+    m_c = Eigen::MatrixXd::Identity(mean.size(), mean.size());
+
+    m_b = m_c;
+
+    m_d = Eigen::VectorXd::Ones(mean.size());
+
+    m_pc = Eigen::VectorXd::Zero(mean.size());
+
+    m_ps = Eigen::VectorXd::Zero(mean.size());
+
+    m_generation = 0;
+
+}
+
+std::vector<Eigen::VectorXd> CmaEs::ask() {
+
+    std::vector<Eigen::VectorXd> population;
+
+    for(size_t k = 0 ; k < m_lambda ; k++) {
+        Eigen::VectorXd z(m_mean.size());
+        for(Eigen::Index i = 0 ; i < z.size() ; i++) {
+            z[i] = m_normal(m_rng);
+        }
+
+        population.emplace_back(
+            m_mean + m_sigma * (m_b * m_d.cwiseProduct(z)));
+    }
+
+    return population;
+}
+
+void CmaEs::tell(const std::vector<Eigen::VectorXd> &population,
+                 const std::vector<double> &fitness) {
+
+    auto n = static_cast<double>(m_dim);
+
+    std::vector<size_t> order(population.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return fitness[a] < fitness[b];
+    });
+
+    Eigen::VectorXd old = m_mean;
+
+    m_mean.setZero();
+    for(size_t i = 0 ; i < m_mu ; i++) {
+        m_mean += m_weights[i] * population[order[i]];
+    }
+
+    Eigen::VectorXd step = (m_mean - old) / m_sigma;
+
+    // C^-1/2 * step
+    Eigen::VectorXd whitened =
+        m_b * m_d.cwiseInverse().asDiagonal() * m_b.transpose() * step;
+
+    m_ps = (1.0 - m_cs) * m_ps +
+        std::sqrt(m_cs * (2.0 - m_cs) * m_mueff) * whitened;
+
+    m_generation++;
+
+    auto hsig = m_ps.norm() /
+        std::sqrt(1.0 - std::pow(1.0 - m_cs, 2.0 * m_generation)) / m_chi_n <
+        1.4 + 2.0 / (n + 1.0);
+
+    m_pc = (1.0 - m_cc) * m_pc +
+        (hsig ? std::sqrt(m_cc * (2.0 - m_cc) * m_mueff) : 0.0) * step;
+
+    Eigen::MatrixXd rank_mu = Eigen::MatrixXd::Zero(m_c.rows(), m_c.cols());
+    for(size_t i = 0 ; i < m_mu ; i++) {
+        Eigen::VectorXd y = (population[order[i]] - old) / m_sigma;
+        rank_mu += m_weights[i] * y * y.transpose();
+    }
+
+    m_c = (1.0 - m_c1 - m_cmu) * m_c +
+        m_c1 * (m_pc * m_pc.transpose() +
+            (hsig ? 0.0 : m_cc * (2.0 - m_cc)) * m_c) +
+        m_cmu * rank_mu;
+
+    m_sigma *= std::exp((m_cs / m_damps) * (m_ps.norm() / m_chi_n - 1.0));
+
+    // Dimension is small, decompose every generation
+    m_c = m_c.triangularView<Eigen::Upper>();
+    m_c = m_c.selfadjointView<Eigen::Upper>();
+
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver(m_c);
+    m_b = solver.eigenvectors();
+    m_d = solver.eigenvalues().cwiseMax(1e-20).cwiseSqrt();
+
+}
@@ -0,0 +1,125 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#pragma once
+
+#include "cstdint"
+#include "random"
+#include "vector"
+
+#include "Eigen/Dense"
+
+namespace helm {
+
+namespace tuner {
+
+    /**
+     * @brief Covariance matrix adaptation evolution strategy
+     *
+     * A plain (mu/mu_w, lambda) CMA-ES with the default strategy parameters
+     * of Hansen's tutorial. It minimizes, and it is unconstrained; bounds
+     * are the caller's business.
+     */
+    class CmaEs {
+    private:
+
+        size_t m_dim;
+
+        size_t m_lambda;
+
+        size_t m_mu;
+
+        Eigen::VectorXd m_weights;
+
+        double m_mueff;
+
+        //! @brief Learning rates
+        double m_cc;
+
+        double m_cs;
+
+        double m_c1;
+
+        double m_cmu;
+
+        double m_damps;
+
+        double m_chi_n;
+
+        Eigen::VectorXd m_mean;
+
+        double m_sigma;
+
+        Eigen::MatrixXd m_c;
+
+        Eigen::MatrixXd m_b;
+
+        Eigen::VectorXd m_d;
+
+        Eigen::VectorXd m_pc;
+
+        Eigen::VectorXd m_ps;
+
+        size_t m_generation;
+
+        std::mt19937 m_rng;
+
+        std::normal_distribution<double> m_normal;
+
+    public:
+
+        /**
+         * @brief Construct the strategy
+         *
+         * @param mean Initial mean
+         * @param sigma Initial step size
+         * @param lambda Population size, 0 picks the default
+         * @param seed Random seed
+         */
+        CmaEs(const Eigen::VectorXd& mean, double sigma, size_t lambda,
+              uint32_t seed);
+
+        /**
+         * @brief Sample a population
+         */
+        std::vector<Eigen::VectorXd> ask();
+
+        /**
+         * @brief Update the distribution with the fitness of the population
+         *
+         * @param population Population returned by #CmaEs::ask
+         * @param fitness Fitness of each member, lower is better
+         */
+        void tell(const std::vector<Eigen::VectorXd>& population,
+                  const std::vector<double>& fitness);
+
+        auto get_lambda() -> decltype(m_lambda) { return m_lambda; }
+
+        auto get_sigma() -> decltype(m_sigma) { return m_sigma; }
+
+    };
+
+}
+
+}
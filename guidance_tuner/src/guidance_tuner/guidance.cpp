@@ -0,0 +1,139 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#include "guidance.h"
+
+#include "cmath"
+
+using namespace helm::tuner;
+
+Guidance::Guidance(GuidanceLaw law, const guidance_parameters_t &params,
+                   double surge_velocity, double overshoot_timeout,
+                   const path_t &path, double x, double y) {
+
+    m_law = law;
+
+    m_params = params;
+
+    m_surge_velocity = surge_velocity;
+
+    m_overshoot_timeout = overshoot_timeout;
+
+    m_path = path;
+
+    m_line_index = 0;
+
+    m_yint = 0;
+
+    m_overshoot_start = -1;
+
+    m_wpt_first = {x, y};
+
+    m_wpt_second = m_path.front();
+
+}
+
+bool Guidance::f_next_line_segment() {
+
+    auto length = m_path.size();
+
+    m_wpt_first = m_path[m_line_index % length];
+
+    m_wpt_second = m_path[(m_line_index + 1) % length];
+
+    m_yint = 0;
+
+    m_line_index++;
+
+    return m_line_index == length;
+}
+
+Guidance::Status Guidance::update(const Vehicle::state_t &state, double t,
+                                  double *surge, double *yaw) {
+
+    auto gamma_p = std::atan2(m_wpt_second.y - m_wpt_first.y,
+                              m_wpt_second.x - m_wpt_first.x);
+
+    auto dx1 = state.x - m_wpt_first.x;
+    auto dy1 = state.y - m_wpt_first.y;
+
+    auto ye = -dx1 * std::sin(gamma_p) + dy1 * std::cos(gamma_p);
+
+    auto xke = (state.x - m_wpt_second.x) * std::cos(gamma_p) +
+        (state.y - m_wpt_second.y) * std::sin(gamma_p);
+
+    auto lookahead = m_params.lookahead_distance;
+
+    if(xke > 0) {
+        lookahead = -lookahead;
+
+        gamma_p = gamma_p + M_PI;
+
+        if(m_overshoot_start < 0) {
+            m_overshoot_start = t;
+        }
+
+        if(t - m_overshoot_start > m_overshoot_timeout) {
+            return Status::FAILED;
+        }
+    }
+
+    *surge = m_surge_velocity;
+
+    double dist;
+
+    if(m_law == GuidanceLaw::LOS) {
+        double beta = 0;
+        if(state.ground_u != 0) {
+            beta = std::atan2(state.ground_v, state.ground_u);
+        }
+
+        *yaw = gamma_p + std::atan(-ye / lookahead) -
+            m_params.beta_gain * beta;
+
+        dist = std::sqrt(xke * xke + ye * ye);
+    } else {
+        auto e = ye + m_params.sigma * m_yint;
+        m_yint += lookahead * ye / (e * e + lookahead * lookahead);
+
+        auto ye_dot = -state.ground_u * std::sin(-state.yaw + gamma_p) +
+            state.ground_v * std::cos(-state.yaw + gamma_p);
+
+        *yaw = gamma_p - std::atan(
+            (ye + m_params.sigma * m_yint) / lookahead +
+                ye_dot * m_params.beta_gain);
+
+        dist = std::hypot(state.x - m_wpt_second.x, state.y - m_wpt_second.y);
+    }
+
+    if(dist < m_params.acceptance_radius) {
+        m_overshoot_start = -1;
+
+        if(f_next_line_segment()) {
+            return Status::DONE;
+        }
+    }
+
+    return Status::RUNNING;
+}
@@ -0,0 +1,134 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#pragma once
+
+#include "vector"
+
+#include "vehicle.h"
+
+namespace helm {
+
+namespace tuner {
+
+    struct point_t {
+        double x;
+        double y;
+    };
+
+    typedef std::vector<point_t> path_t;
+
+    enum class GuidanceLaw : int {
+        //! @brief Line of sight with sideslip compensation, PathFollowing
+        LOS,
+        //! @brief Integral line of sight, PathFollowingI
+        INTEGRAL_LOS
+    };
+
+    struct guidance_parameters_t {
+        double lookahead_distance;
+        double sigma;
+        double beta_gain;
+        double acceptance_radius;
+    };
+
+    /**
+     * @brief Guidance of the path following behaviors
+     *
+     * A copy of the law in `PathFollowing::request_set_point` and
+     * `PathFollowingI::request_set_point`, including the way the segments
+     * advance and the overshoot abort. It must be kept in sync with them,
+     * otherwise the tuned parameters don't carry over.
+     */
+    class Guidance {
+    public:
+
+        enum class Status : int {
+            RUNNING,
+            DONE,
+            FAILED
+        };
+
+    private:
+
+        GuidanceLaw m_law;
+
+        guidance_parameters_t m_params;
+
+        double m_surge_velocity;
+
+        double m_overshoot_timeout;
+
+        path_t m_path;
+
+        point_t m_wpt_first;
+
+        point_t m_wpt_second;
+
+        size_t m_line_index;
+
+        //! @brief Integral state of the integral line of sight
+        double m_yint;
+
+        //! @brief Start of the overshoot, negative if there is none
+        double m_overshoot_start;
+
+        /**
+         * @return true if the last waypoint is reached
+         */
+        bool f_next_line_segment();
+
+    public:
+
+        /**
+         * @brief Construct a guidance from the position of the vehicle
+         *
+         * @param law Guidance law
+         * @param params Parameters to be tuned
+         * @param surge_velocity Commanded surge in m/s
+         * @param overshoot_timeout Seconds
+         * @param path Waypoints, at least one
+         * @param x Position of the vehicle at the activation
+         * @param y Position of the vehicle at the activation
+         */
+        Guidance(GuidanceLaw law, const guidance_parameters_t& params,
+                 double surge_velocity, double overshoot_timeout,
+                 const path_t& path, double x, double y);
+
+        /**
+         * @brief Compute the command
+         *
+         * @param state State of the vehicle
+         * @param t Time in seconds
+         * @param surge Output, surge in m/s
+         * @param yaw Output, heading in radians
+         */
+        Status update(const Vehicle::state_t& state, double t,
+                      double* surge, double* yaw);
+
+    };
+
+}
+
+}
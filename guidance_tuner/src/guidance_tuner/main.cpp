@@ -0,0 +1,291 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#include "algorithm"
+#include "chrono"
+#include "cstdlib"
+#include "iomanip"
+#include "iostream"
+#include "sstream"
+#include "string"
+
+#include "tuner.h"
+
+/**
+ * Tunes the guidance parameters of PathFollowing and PathFollowingI.
+ *
+ * Usage:
+ *   rosrun guidance_tuner guidance_tuner [options]
+ *
+ * Prints the Pareto set of cross track error and completion time as yaml.
+ * Each entry can be copied into the parameters of the behavior.
+ */
+
+namespace {
+
+    void usage() {
+        std::cerr <<
+            "usage: guidance_tuner [options]\n"
+            "  --behavior path_following|path_following_i   (path_following)\n"
+            "  --surge-velocity m/s                         (1.0)\n"
+            "  --frequency hz, helm frequency               (10)\n"
+            "  --overshoot-timeout s                        (30)\n"
+            "  --surge-time-constant s                      (3.0)\n"
+            "  --yaw-time-constant s                        (1.5)\n"
+            "  --max-yaw-rate rad/s                         (0.35)\n"
+            "  --current m/s                                (0.2)\n"
+            "  --gust m/s                                   (0.05)\n"
+            "  --gust-time-constant s                       (20)\n"
+            "  --scenarios n                                (9)\n"
+            "  --leg-length m                               (100)\n"
+            "  --evaluations n                              (3000)\n"
+            "  --tradeoffs n                                (7)\n"
+            "  -j n, threads, 0 for all the cores           (0)\n"
+            "  --seed n                                     (1)\n"
+            "  --points n, entries of the pareto set to print (10)\n"
+            "  --bound name:min:max, search range of a parameter\n"
+            "  --fix name:value, keep a parameter out of the search\n";
+    }
+
+    bool set_parameter(helm::tuner::guidance_parameters_t* p,
+                       const std::string& name, double value) {
+        if(name == "lookahead_distance") {
+            p->lookahead_distance = value;
+        } else if(name == "sigma") {
+            p->sigma = value;
+        } else if(name == "beta_gain") {
+            p->beta_gain = value;
+        } else if(name == "acceptance_radius") {
+            p->acceptance_radius = value;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    bool split(const std::string& s, std::vector<std::string>* out) {
+        std::stringstream ss(s);
+        std::string item;
+        while(std::getline(ss, item, ':')) {
+            out->emplace_back(item);
+        }
+        return !out->empty();
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+
+    using namespace helm::tuner;
+
+    tuner_configuration_t conf;
+
+    conf.simulation = {
+        .law = GuidanceLaw::LOS,
+        .surge_velocity = 1.0,
+        .dt = 0.1,
+        .overshoot_timeout = 30.0,
+        .time_limit = 3.0,
+        .vehicle = {
+            .surge_time_constant = 3.0,
+            .yaw_time_constant = 1.5,
+            .max_yaw_rate = 0.35
+        },
+        .disturbance = {
+            .current_speed = 0.2,
+            .gust_intensity = 0.05,
+            .gust_time_constant = 20.0
+        }
+    };
+
+    conf.scenarios = 9;
+    conf.leg_length = 100.0;
+    conf.evaluations = 3000;
+    conf.tradeoffs = 7;
+    conf.jobs = 0;
+    conf.seed = 1;
+
+    // Defaults of the behaviors
+    conf.fixed = {
+        .lookahead_distance = 2.0,
+        .sigma = 1.0,
+        .beta_gain = 0.0,
+        .acceptance_radius = 1.0
+    };
+
+    std::vector<parameter_bounds_t> bounds = {
+        {"lookahead_distance", 1.0, 30.0, true},
+        {"sigma", 0.01, 5.0, true},
+        {"beta_gain", 0.0, 2.0, false},
+        {"acceptance_radius", 0.5, 10.0, false}
+    };
+
+    std::vector<std::string> fixed;
+
+    size_t points = 10;
+
+    for(int i = 1 ; i < argc ; i++) {
+        std::string arg = argv[i];
+
+        if(i + 1 >= argc) {
+            usage();
+            return 1;
+        }
+
+        std::string value = argv[++i];
+
+        if(arg == "--behavior") {
+            if(value == "path_following") {
+                conf.simulation.law = GuidanceLaw::LOS;
+            } else if(value == "path_following_i") {
+                conf.simulation.law = GuidanceLaw::INTEGRAL_LOS;
+            } else {
+                usage();
+                return 1;
+            }
+        } else if(arg == "--surge-velocity") {
+            conf.simulation.surge_velocity = std::atof(value.c_str());
+        } else if(arg == "--frequency") {
+            conf.simulation.dt = 1.0 / std::atof(value.c_str());
+        } else if(arg == "--overshoot-timeout") {
+            conf.simulation.overshoot_timeout = std::atof(value.c_str());
+        } else if(arg == "--surge-time-constant") {
+            conf.simulation.vehicle.surge_time_constant =
+                std::atof(value.c_str());
+        } else if(arg == "--yaw-time-constant") {
+            conf.simulation.vehicle.yaw_time_constant =
+                std::atof(value.c_str());
+        } else if(arg == "--max-yaw-rate") {
+            conf.simulation.vehicle.max_yaw_rate = std::atof(value.c_str());
+        } else if(arg == "--current") {
+            conf.simulation.disturbance.current_speed =
+                std::atof(value.c_str());
+        } else if(arg == "--gust") {
+            conf.simulation.disturbance.gust_intensity =
+                std::atof(value.c_str());
+        } else if(arg == "--gust-time-constant") {
+            conf.simulation.disturbance.gust_time_constant =
+                std::atof(value.c_str());
+        } else if(arg == "--scenarios") {
+            conf.scenarios = std::strtoul(value.c_str(), nullptr, 10);
+        } else if(arg == "--leg-length") {
+            conf.leg_length = std::atof(value.c_str());
+        } else if(arg == "--evaluations") {
+            conf.evaluations = std::strtoul(value.c_str(), nullptr, 10);
+        } else if(arg == "--tradeoffs") {
+            conf.tradeoffs = std::strtoul(value.c_str(), nullptr, 10);
+        } else if(arg == "-j") {
+            conf.jobs = std::strtoul(value.c_str(), nullptr, 10);
+        } else if(arg == "--seed") {
+            conf.seed = static_cast<uint32_t>(
+                std::strtoul(value.c_str(), nullptr, 10));
+        } else if(arg == "--points") {
+            points = std::strtoul(value.c_str(), nullptr, 10);
+        } else if(arg == "--bound") {
+            std::vector<std::string> f;
+            split(value, &f);
+            auto it = std::find_if(bounds.begin(), bounds.end(),
+                [&](const parameter_bounds_t& b) { return b.name == f[0]; });
+            if(f.size() != 3 || it == bounds.end()) {
+                usage();
+                return 1;
+            }
+            it->min = std::atof(f[1].c_str());
+            it->max = std::atof(f[2].c_str());
+            it->log = it->log && it->min > 0;
+        } else if(arg == "--fix") {
+            std::vector<std::string> f;
+            split(value, &f);
+            if(f.size() != 2 ||
+                !set_parameter(&conf.fixed, f[0], std::atof(f[1].c_str()))) {
+                usage();
+                return 1;
+            }
+            fixed.emplace_back(f[0]);
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    for(const auto& b : bounds) {
+        // Path following has no integral term
+        if(b.name == "sigma" && conf.simulation.law == GuidanceLaw::LOS) {
+            continue;
+        }
+
+        if(std::find(fixed.begin(), fixed.end(), b.name) != fixed.end()) {
+            continue;
+        }
+
+        conf.bounds.emplace_back(b);
+    }
+
+    if(conf.bounds.empty() || conf.scenarios == 0 ||
+        conf.simulation.surge_velocity <= 0 || conf.simulation.dt <= 0) {
+        usage();
+        return 1;
+    }
+
+    Tuner tuner(conf);
+
+    auto start = std::chrono::steady_clock::now();
+
+    auto pareto = tuner.run();
+
+    std::chrono::duration<double> wall =
+        std::chrono::steady_clock::now() - start;
+
+    std::cout << "# " << tuner.get_evaluated() << " candidates on "
+        << conf.scenarios << " scenarios in " << std::setprecision(3)
+        << wall.count() << " seconds\n";
+
+    if(pareto.empty()) {
+        std::cout << "# no candidate completed every scenario\n";
+        return 2;
+    }
+
+    std::cout << "# time_ratio is the completion time over the time at the"
+        " commanded surge\n";
+    std::cout << "# " << pareto.size() << " non dominated candidates\n";
+    std::cout << "pareto:\n" << std::setprecision(4);
+
+    // Set is sorted by cross track error, print evenly spaced entries of it
+    size_t count = std::max<size_t>(1, std::min(points, pareto.size()));
+    for(size_t i = 0 ; i < count ; i++) {
+        size_t index = count == 1 ? 0 :
+            i * (pareto.size() - 1) / (count - 1);
+        const auto& k = pareto[index];
+        std::cout << "  - { lookahead_distance: " << k.params.lookahead_distance;
+        if(conf.simulation.law == GuidanceLaw::INTEGRAL_LOS) {
+            std::cout << ", sigma: " << k.params.sigma;
+        }
+        std::cout << ", beta_gain: " << k.params.beta_gain
+            << ", acceptance_radius: " << k.params.acceptance_radius
+            << ", cross_track_error: " << k.cross_track_error
+            << ", time_ratio: " << k.time_ratio << " }\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#include "simulation.h"
+
+#include "algorithm"
+#include "cmath"
+#include "limits"
+#include "random"
+
+using namespace helm::tuner;
+
+namespace {
+
+    double segment_distance(const point_t& a, const point_t& b,
+                            double x, double y) {
+
+        auto dx = b.x - a.x;
+        auto dy = b.y - a.y;
+        auto l2 = dx * dx + dy * dy;
+
+        double t = 0;
+        if(l2 > 0) {
+            t = std::max(0.0, std::min(1.0,
+                ((x - a.x) * dx + (y - a.y) * dy) / l2));
+        }
+
+        return std::hypot(x - a.x - t * dx, y - a.y - t * dy);
+    }
+
+}
+
+std::vector<scenario_t> helm::tuner::make_scenarios(
+    size_t count, double leg_length, double surge_velocity, uint32_t seed) {
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    std::vector<scenario_t> scenarios;
+
+    for(size_t i = 0 ; i < count ; i++) {
+        scenario_t s;
+        auto& p = s.path;
+
+        switch(i % 3) {
+            case 0: {
+                // Lawnmower, lines are a fifth of a leg apart
+                auto spacing = leg_length / 5.0;
+                for(int j = 0 ; j < 4 ; j++) {
+                    auto y = j * spacing;
+                    if(j % 2 == 0) {
+                        p.push_back({0, y});
+                        p.push_back({leg_length, y});
+                    } else {
+                        p.push_back({leg_length, y});
+                        p.push_back({0, y});
+                    }
+                }
+                break;
+            }
+            case 1:
+                p = {{0, 0}, {leg_length, 0}, {leg_length, leg_length},
+                     {0, leg_length}, {0, 0}};
+                break;
+            default: {
+                // Zigzag with turns between 30 and 150 degrees
+                point_t c = {0, 0};
+                double heading = 0;
+                p.push_back(c);
+                for(int j = 0 ; j < 5 ; j++) {
+                    c.x += leg_length * std::cos(heading);
+                    c.y += leg_length * std::sin(heading);
+                    p.push_back(c);
+                    auto turn = (30.0 + 120.0 * uniform(rng)) * M_PI / 180.0;
+                    heading += j % 2 == 0 ? turn : -turn;
+                }
+                break;
+            }
+        }
+
+        // Start somewhere behind the first waypoint
+        auto a = 2.0 * M_PI * uniform(rng);
+        auto r = leg_length * (0.1 + 0.2 * uniform(rng));
+        s.x = p.front().x + r * std::cos(a);
+        s.y = p.front().y + r * std::sin(a);
+        s.yaw = 2.0 * M_PI * uniform(rng) - M_PI;
+        s.seed = static_cast<uint32_t>(rng());
+
+        double length = std::hypot(p.front().x - s.x, p.front().y - s.y);
+        for(size_t j = 1 ; j < p.size() ; j++) {
+            length += std::hypot(p[j].x - p[j - 1].x, p[j].y - p[j - 1].y);
+        }
+        s.nominal_time = length / surge_velocity;
+
+        scenarios.emplace_back(std::move(s));
+    }
+
+    return scenarios;
+}
+
+result_t helm::tuner::simulate(const simulation_configuration_t &conf,
+                               const scenario_t &scenario,
+                               const guidance_parameters_t &params) {
+
+    Vehicle vehicle(conf.vehicle, conf.disturbance, scenario.seed,
+                    scenario.x, scenario.y, scenario.yaw);
+
+    Guidance guidance(conf.law, params, conf.surge_velocity,
+                      conf.overshoot_timeout, scenario.path,
+                      scenario.x, scenario.y);
+
+    // Cross track error is measured against the whole path
+    path_t path = {{scenario.x, scenario.y}};
+    path.insert(path.end(), scenario.path.begin(), scenario.path.end());
+
+    auto limit = conf.time_limit * scenario.nominal_time;
+
+    double squared = 0;
+    size_t samples = 0;
+
+    double t = 0;
+    for( ; t < limit ; t += conf.dt) {
+        const auto& s = vehicle.get_state();
+
+        double surge, yaw;
+        auto status = guidance.update(s, t, &surge, &yaw);
+
+        if(status == Guidance::Status::DONE) {
+            return {true, std::sqrt(squared / std::max<size_t>(samples, 1)), t};
+        }
+
+        if(status == Guidance::Status::FAILED) {
+            break;
+        }
+
+        auto d = std::numeric_limits<double>::max();
+        for(size_t j = 1 ; j < path.size() ; j++) {
+            d = std::min(d, segment_distance(path[j - 1], path[j], s.x, s.y));
+        }
+        squared += d * d;
+        samples++;
+
+        vehicle.step(surge, yaw, conf.dt);
+    }
+
+    return {false, std::sqrt(squared / std::max<size_t>(samples, 1)), t};
+}
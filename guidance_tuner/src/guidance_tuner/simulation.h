@@ -0,0 +1,95 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#pragma once
+
+#include "cstdint"
+#include "vector"
+
+#include "guidance.h"
+#include "vehicle.h"
+
+namespace helm {
+
+namespace tuner {
+
+    struct simulation_configuration_t {
+        GuidanceLaw law;
+        //! @brief Commanded surge, in m/s
+        double surge_velocity;
+        //! @brief Period of the helm, in seconds
+        double dt;
+        //! @brief Overshoot timeout of the behavior, in seconds
+        double overshoot_timeout;
+        //! @brief A run fails if it takes this many times the nominal time
+        double time_limit;
+        vehicle_configuration_t vehicle;
+        disturbance_configuration_t disturbance;
+    };
+
+    struct scenario_t {
+        path_t path;
+        //! @brief Initial pose of the vehicle
+        double x;
+        double y;
+        double yaw;
+        //! @brief Seed of the disturbance
+        uint32_t seed;
+        //! @brief Time to complete the path at the commanded surge
+        double nominal_time;
+    };
+
+    struct result_t {
+        bool completed;
+        //! @brief RMS distance to the path, in meters
+        double cross_track_error;
+        //! @brief Seconds
+        double completion_time;
+    };
+
+    /**
+     * @brief Generate a set of paths to tune on
+     *
+     * Lawnmower surveys, boxes and zigzags with random turn angles, in
+     * turns. Start poses and disturbances are random.
+     *
+     * @param count Number of scenarios
+     * @param leg_length Length of a leg, in meters
+     * @param surge_velocity Commanded surge in m/s, for the nominal time
+     * @param seed Random seed
+     */
+    std::vector<scenario_t> make_scenarios(size_t count, double leg_length,
+                                           double surge_velocity,
+                                           uint32_t seed);
+
+    /**
+     * @brief Run a closed loop simulation
+     */
+    result_t simulate(const simulation_configuration_t& conf,
+                      const scenario_t& scenario,
+                      const guidance_parameters_t& params);
+
+}
+
+}
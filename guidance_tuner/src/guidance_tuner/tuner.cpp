@@ -0,0 +1,215 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#include "tuner.h"
+#include "cmaes.h"
+
+#include "algorithm"
+#include "atomic"
+#include "cmath"
+#include "thread"
+
+using namespace helm::tuner;
+
+namespace {
+
+    //! @brief Cross track error that counts as one unit of the objective
+    constexpr double CROSS_TRACK_SCALE = 1.0;
+
+    //! @brief Completion time ratio that counts as one unit of the objective
+    constexpr double TIME_SCALE = 0.1;
+
+    //! @brief Weight of the sum in the augmented Tchebycheff scalarization
+    constexpr double AUGMENTATION = 0.05;
+
+    //! @brief Fitness of a candidate that fails a scenario
+    constexpr double INFEASIBLE = 1e3;
+
+}
+
+Tuner::Tuner(const tuner_configuration_t &conf) {
+
+    m_conf = conf;
+
+    if(m_conf.jobs == 0) {
+        m_conf.jobs = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    m_conf.tradeoffs = std::max<size_t>(m_conf.tradeoffs, 1);
+
+    m_scenarios = make_scenarios(m_conf.scenarios, m_conf.leg_length,
+        m_conf.simulation.surge_velocity, m_conf.seed);
+
+}
+
+guidance_parameters_t Tuner::f_decode(const Eigen::VectorXd &x) const {
+
+    auto p = m_conf.fixed;
+
+    for(size_t i = 0 ; i < m_conf.bounds.size() ; i++) {
+        const auto& b = m_conf.bounds[i];
+
+        auto u = std::max(0.0, std::min(1.0, x[static_cast<Eigen::Index>(i)]));
+
+        double v = b.log ?
+            std::exp(std::log(b.min) + u * (std::log(b.max) - std::log(b.min))) :
+            b.min + u * (b.max - b.min);
+
+        if(b.name == "lookahead_distance") {
+            p.lookahead_distance = v;
+        } else if(b.name == "sigma") {
+            p.sigma = v;
+        } else if(b.name == "beta_gain") {
+            p.beta_gain = v;
+        } else if(b.name == "acceptance_radius") {
+            p.acceptance_radius = v;
+        }
+    }
+
+    return p;
+}
+
+std::vector<candidate_t> Tuner::f_evaluate(
+    const std::vector<guidance_parameters_t> &params) {
+
+    auto count = params.size() * m_scenarios.size();
+
+    std::vector<result_t> results(count);
+
+    std::atomic<size_t> next(0);
+
+    auto worker = [&]() {
+        for(auto i = next++ ; i < count ; i = next++) {
+            results[i] = simulate(m_conf.simulation,
+                m_scenarios[i % m_scenarios.size()],
+                params[i / m_scenarios.size()]);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(size_t i = 1 ; i < std::min(m_conf.jobs, count) ; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for(auto& t : threads) {
+        t.join();
+    }
+
+    std::vector<candidate_t> candidates;
+    for(size_t c = 0 ; c < params.size() ; c++) {
+        candidate_t k = {params[c], 0, 0, true};
+
+        for(size_t s = 0 ; s < m_scenarios.size() ; s++) {
+            const auto& r = results[c * m_scenarios.size() + s];
+            k.feasible = k.feasible && r.completed;
+            k.cross_track_error += r.cross_track_error;
+            k.time_ratio += r.completion_time / m_scenarios[s].nominal_time;
+        }
+
+        k.cross_track_error /= m_scenarios.size();
+        k.time_ratio /= m_scenarios.size();
+
+        candidates.emplace_back(k);
+    }
+
+    m_archive.insert(m_archive.end(), candidates.begin(), candidates.end());
+
+    return candidates;
+}
+
+std::vector<candidate_t> Tuner::run() {
+
+    auto dim = static_cast<Eigen::Index>(m_conf.bounds.size());
+
+    auto budget = m_conf.evaluations / m_conf.tradeoffs;
+
+    for(size_t w = 0 ; w < m_conf.tradeoffs ; w++) {
+        // Weight of the cross track error, from only time to only error
+        auto weight = m_conf.tradeoffs == 1 ? 0.5 :
+            static_cast<double>(w) / (m_conf.tradeoffs - 1);
+
+        CmaEs es(Eigen::VectorXd::Constant(dim, 0.5), 0.3, 0,
+                 m_conf.seed + static_cast<uint32_t>(w));
+
+        for(size_t used = 0 ; used < budget ; used += es.get_lambda()) {
+            auto population = es.ask();
+
+            std::vector<guidance_parameters_t> params;
+            for(const auto& x : population) {
+                params.emplace_back(f_decode(x));
+            }
+
+            auto candidates = f_evaluate(params);
+
+            std::vector<double> fitness;
+            for(size_t i = 0 ; i < population.size() ; i++) {
+                const auto& k = candidates[i];
+
+                auto e = weight * k.cross_track_error / CROSS_TRACK_SCALE;
+                auto t = (1.0 - weight) * (k.time_ratio - 1.0) / TIME_SCALE;
+
+                auto f = std::max(e, t) + AUGMENTATION * (e + t);
+                if(!k.feasible) {
+                    f += INFEASIBLE;
+                }
+
+                // Pull the strategy back into the unit box
+                auto& x = population[i];
+                f += (x - x.cwiseMax(0.0).cwiseMin(1.0)).squaredNorm();
+
+                fitness.emplace_back(f);
+            }
+
+            es.tell(population, fitness);
+
+            if(es.get_sigma() < 1e-4) {
+                break;
+            }
+        }
+    }
+
+    /**
+     * Non-dominated feasible candidates
+     */
+    std::vector<candidate_t> feasible;
+    std::copy_if(m_archive.begin(), m_archive.end(),
+        std::back_inserter(feasible),
+        [](const candidate_t& k) { return k.feasible; });
+
+    std::sort(feasible.begin(), feasible.end(),
+        [](const candidate_t& a, const candidate_t& b) {
+            return a.cross_track_error < b.cross_track_error ||
+                (a.cross_track_error == b.cross_track_error &&
+                    a.time_ratio < b.time_ratio);
+        });
+
+    std::vector<candidate_t> pareto;
+    for(const auto& k : feasible) {
+        if(pareto.empty() || k.time_ratio < pareto.back().time_ratio) {
+            pareto.emplace_back(k);
+        }
+    }
+
+    return pareto;
+}
@@ -0,0 +1,123 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#pragma once
+
+#include "cstdint"
+#include "string"
+#include "vector"
+
+#include "Eigen/Dense"
+
+#include "simulation.h"
+
+namespace helm {
+
+namespace tuner {
+
+    struct parameter_bounds_t {
+        std::string name;
+        double min;
+        double max;
+        //! @brief Search in logarithmic scale, both bounds must be positive
+        bool log;
+    };
+
+    struct tuner_configuration_t {
+        simulation_configuration_t simulation;
+        //! @brief Number of paths each candidate is simulated on
+        size_t scenarios;
+        //! @brief Length of a leg of the paths, in meters
+        double leg_length;
+        //! @brief Total number of candidates to evaluate
+        size_t evaluations;
+        //! @brief Number of trade-offs to optimize for
+        size_t tradeoffs;
+        //! @brief Number of threads, 0 for all the cores
+        size_t jobs;
+        uint32_t seed;
+        //! @brief Parameters to be tuned, the others keep their values
+        std::vector<parameter_bounds_t> bounds;
+        //! @brief Values of the parameters that are not tuned
+        guidance_parameters_t fixed;
+    };
+
+    struct candidate_t {
+        guidance_parameters_t params;
+        //! @brief Mean RMS cross track error over the scenarios, in meters
+        double cross_track_error;
+        //! @brief Mean completion time over the nominal time
+        double time_ratio;
+        //! @brief Whether every scenario completed
+        bool feasible;
+    };
+
+    /**
+     * @brief Searches for the guidance parameters
+     *
+     * Cross track error and completion time compete: a short lookahead
+     * converges fast but overshoots turns, a large acceptance radius cuts
+     * corners. The trade-off is swept with augmented Tchebycheff
+     * scalarizations, each one minimized by a CMA-ES run. Every candidate is
+     * simulated on the same scenarios, in parallel. The non-dominated
+     * feasible candidates of all runs are the Pareto set.
+     */
+    class Tuner {
+    private:
+
+        tuner_configuration_t m_conf;
+
+        std::vector<scenario_t> m_scenarios;
+
+        //! @brief Every candidate evaluated so far
+        std::vector<candidate_t> m_archive;
+
+        guidance_parameters_t f_decode(const Eigen::VectorXd& x) const;
+
+        /**
+         * @brief Simulates the candidates on all the scenarios in parallel
+         */
+        std::vector<candidate_t> f_evaluate(
+            const std::vector<guidance_parameters_t>& params);
+
+    public:
+
+        explicit Tuner(const tuner_configuration_t& conf);
+
+        /**
+         * @brief Run the search
+         *
+         * @return Pareto set, in ascending cross track error
+         */
+        std::vector<candidate_t> run();
+
+        auto get_evaluated() -> decltype(m_archive.size()) {
+            return m_archive.size();
+        }
+
+    };
+
+}
+
+}
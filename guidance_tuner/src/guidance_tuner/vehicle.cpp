@@ -0,0 +1,85 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#include "vehicle.h"
+
+#include "algorithm"
+#include "cmath"
+
+using namespace helm::tuner;
+
+Vehicle::Vehicle(const vehicle_configuration_t &conf,
+                 const disturbance_configuration_t &disturbance,
+                 uint32_t seed, double x, double y, double yaw)
+    : m_rng(seed) {
+
+    m_conf = conf;
+
+    m_disturbance = disturbance;
+
+    std::uniform_real_distribution<double> direction(-M_PI, M_PI);
+    auto d = direction(m_rng);
+
+    m_current_x = m_disturbance.current_speed * std::cos(d);
+
+    m_current_y = m_disturbance.current_speed * std::sin(d);
+
+    m_gust_x = 0;
+
+    m_gust_y = 0;
+
+    m_state = {x, y, yaw, 0, 0, 0};
+
+}
+
+void Vehicle::step(double surge, double yaw, double dt) {
+
+    auto& s = m_state;
+
+    s.u += (surge - s.u) * std::min(dt / m_conf.surge_time_constant, 1.0);
+
+    auto error = std::remainder(yaw - s.yaw, 2.0 * M_PI);
+    auto r = std::max(-m_conf.max_yaw_rate, std::min(m_conf.max_yaw_rate,
+        error / m_conf.yaw_time_constant));
+
+    s.yaw = std::remainder(s.yaw + r * dt, 2.0 * M_PI);
+
+    // Gauss-Markov gusts with the configured stationary deviation
+    if(m_disturbance.gust_intensity > 0) {
+        auto tau = m_disturbance.gust_time_constant;
+        auto k = m_disturbance.gust_intensity * std::sqrt(2.0 * dt / tau);
+        m_gust_x += -m_gust_x * dt / tau + k * m_normal(m_rng);
+        m_gust_y += -m_gust_y * dt / tau + k * m_normal(m_rng);
+    }
+
+    auto vx = s.u * std::cos(s.yaw) + m_current_x + m_gust_x;
+    auto vy = s.u * std::sin(s.yaw) + m_current_y + m_gust_y;
+
+    s.x += vx * dt;
+    s.y += vy * dt;
+
+    s.ground_u = vx * std::cos(s.yaw) + vy * std::sin(s.yaw);
+    s.ground_v = -vx * std::sin(s.yaw) + vy * std::cos(s.yaw);
+
+}
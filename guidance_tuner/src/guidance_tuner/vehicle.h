@@ -0,0 +1,118 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#pragma once
+
+#include "cstdint"
+#include "random"
+
+namespace helm {
+
+namespace tuner {
+
+    struct vehicle_configuration_t {
+        //! @brief Time constant of the surge response, in seconds
+        double surge_time_constant;
+        //! @brief Time constant of the heading response, in seconds
+        double yaw_time_constant;
+        //! @brief Largest yaw rate, in rad/s
+        double max_yaw_rate;
+    };
+
+    struct disturbance_configuration_t {
+        //! @brief Speed of the constant current, in m/s
+        double current_speed;
+        //! @brief Standard deviation of the gusts on top of it, in m/s
+        double gust_intensity;
+        //! @brief Correlation time of the gusts, in seconds
+        double gust_time_constant;
+    };
+
+    /**
+     * @brief Kinematic vehicle with first order surge and heading responses
+     *
+     * Vehicle moves with its surge through the water, plus a current. The
+     * current has a constant part in a direction picked by the seed and a
+     * first order Gauss-Markov part for the gusts. Heading follows the
+     * command with a time constant, the rate is saturated.
+     */
+    class Vehicle {
+    public:
+
+        struct state_t {
+            double x;
+            double y;
+            double yaw;
+            //! @brief Surge through the water
+            double u;
+            //! @brief Velocity over the ground in the body frame, as the
+            //!        controller reports it
+            double ground_u;
+            double ground_v;
+        };
+
+    private:
+
+        vehicle_configuration_t m_conf;
+
+        disturbance_configuration_t m_disturbance;
+
+        state_t m_state;
+
+        std::mt19937 m_rng;
+
+        std::normal_distribution<double> m_normal;
+
+        //! @brief Constant current
+        double m_current_x;
+
+        double m_current_y;
+
+        //! @brief Gust
+        double m_gust_x;
+
+        double m_gust_y;
+
+    public:
+
+        Vehicle(const vehicle_configuration_t& conf,
+                const disturbance_configuration_t& disturbance,
+                uint32_t seed, double x, double y, double yaw);
+
+        /**
+         * @brief Advance the vehicle
+         *
+         * @param surge Commanded surge in m/s
+         * @param yaw Commanded heading in radians
+         * @param dt Time step in seconds
+         */
+        void step(double surge, double yaw, double dt);
+
+        const state_t& get_state() const { return m_state; }
+
+    };
+
+}
+
+}
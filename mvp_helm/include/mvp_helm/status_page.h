@@ -0,0 +1,246 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#pragma once
+
+/**
+ * @brief Live status page of the helm in POSIX shared memory.
+ *
+ * Helm writes a fixed layout block to a shared memory object at the end of
+ * every iteration when `status_page` is enabled in the helm configuration.
+ * Monitors read it without any ROS connection and without slowing the helm
+ * down. The page is protected by a sequence lock: the helm makes
+ * #helm_status_page_t::sequence odd while it writes and even when it is done,
+ * a reader copies the status and retries if the sequence changed in between.
+ * The helm never waits for the readers.
+ *
+ * This header is plain C so that it can be used from any language with a C
+ * foreign function interface. Link against `helm_status` to use the reader:
+ *
+ * @code{.c}
+ * helm_status_reader_t* reader = helm_status_open("/mvp_helm_helm");
+ * helm_status_t status;
+ * if(reader && helm_status_read(reader, &status) == HELM_STATUS_OK) {
+ *     printf("%s %f\n", status.state, status.frequency);
+ * }
+ * helm_status_close(reader);
+ * @endcode
+ */
+
+#include "stddef.h"
+#include "stdint.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Layout
+ */
+
+//! @brief Identifies a helm status page, "MVPH"
+#define HELM_STATUS_MAGIC 0x4d565048u
+
+//! @brief Incremented every time the layout changes
+#define HELM_STATUS_VERSION 4u
+
+//! @brief Size of the name fields, including the terminating null
+#define HELM_STATUS_NAME_LENGTH 64
+
+//! @brief Behaviors after this many are not reported
+#define HELM_STATUS_MAX_BEHAVIORS 64
+
+//! @brief Number of DOFs, indexed like mvp_msgs/ControlMode DOF constants
+#define HELM_STATUS_DOF_COUNT 12
+
+//! @brief Size of the checkpoint of a behavior
+#define HELM_STATUS_CHECKPOINT_SIZE 64
+
+typedef struct {
+    //! @brief Name of the behavior in the helm configuration
+    char name[HELM_STATUS_NAME_LENGTH];
+    //! @brief 1 if the behavior is active in the active state
+    uint8_t active;
+    //! @brief Result of the last set point request
+    uint8_t result;
+    //! @brief 1 if the overload governor runs the behavior less frequently
+    uint8_t decimated;
+    //! @brief 1 if the behavior is never decimated
+    uint8_t critical;
+    //! @brief Priority in the active state, -1 if it is not active
+    int32_t priority;
+    //! @brief Number of consecutive set point requests that returned false
+    uint32_t failures;
+    //! @brief Number of valid bytes in #helm_status_behavior_t::checkpoint
+    uint32_t checkpoint_size;
+    //! @brief Duration of the last set point request in seconds
+    double duration;
+    //! @brief Bytes in use in the arena of the behavior
+    uint64_t memory_in_use;
+    //! @brief Highest #helm_status_behavior_t::memory_in_use
+    uint64_t memory_high_water;
+    //! @brief Bytes the arena of the behavior holds, including free blocks
+    uint64_t memory_reserved;
+    //! @brief Number of allocations from the arena of the behavior
+    uint64_t memory_allocations;
+    //! @brief Progress of the behavior for a standby helm, its format is
+    //!        private to the behavior
+    uint8_t checkpoint[HELM_STATUS_CHECKPOINT_SIZE];
+} helm_status_behavior_t;
+
+typedef struct {
+    //! @brief Number of iterations executed by the helm
+    uint64_t tick;
+    //! @brief ROS time at the end of the last iteration in seconds
+    double stamp;
+    //! @brief Helm frequency in hertz
+    double frequency;
+    //! @brief Duration of the last iteration in seconds
+    double duration;
+    //! @brief Level of the overload governor, 0 if nothing is shed
+    int32_t overload_level;
+    //! @brief 1 if the ticks are aligned to the controller process values
+    uint8_t aligned;
+    //! @brief 1 if the helm is a standby that mirrors another helm and
+    //!        doesn't publish set points
+    uint8_t standby;
+    uint8_t reserved[2];
+    //! @brief Name of the active state
+    char state[HELM_STATUS_NAME_LENGTH];
+    //! @brief Controller mode of the active state
+    char mode[HELM_STATUS_NAME_LENGTH];
+    //! @brief Index of the behavior that won each DOF, -1 if none did
+    int32_t dof_winners[HELM_STATUS_DOF_COUNT];
+    //! @brief Last set point sent to the controller, indexed by DOF
+    double set_point[HELM_STATUS_DOF_COUNT];
+    //! @brief ROS time of the last set point in seconds, 0 if none is sent
+    double set_point_stamp;
+    //! @brief Number of valid entries in #helm_status_t::behaviors
+    uint32_t behavior_count;
+    uint32_t reserved2;
+    helm_status_behavior_t behaviors[HELM_STATUS_MAX_BEHAVIORS];
+} helm_status_t;
+
+typedef struct {
+    //! @brief #HELM_STATUS_MAGIC once the page is initialized
+    uint32_t magic;
+    //! @brief #HELM_STATUS_VERSION of the helm
+    uint32_t version;
+    //! @brief Size of #helm_status_page_t of the helm
+    uint32_t size;
+    //! @brief Process id of the helm, 0 after the helm exits
+    int32_t pid;
+    //! @brief Sequence lock, odd while the helm writes the status
+    uint64_t sequence;
+    //! @brief Process id of the helm that took over from this one, 0 if none
+    //!        did, see helm_status_take_over
+    int32_t owner_pid;
+    //! @brief Number of times a standby took over from this helm
+    uint32_t takeovers;
+    //! @brief Status page of the helm that took over, empty if it has none
+    char owner[HELM_STATUS_NAME_LENGTH];
+    //! @brief Keeps the status on its own cache line
+    uint64_t reserved[4];
+    helm_status_t status;
+} helm_status_page_t;
+
+/*******************************************************************************
+ * Reader
+ */
+
+//! @brief Status is copied
+#define HELM_STATUS_OK 0
+
+//! @brief Status is copied, but the helm is not running anymore
+#define HELM_STATUS_STOPPED 1
+
+//! @brief Helm kept writing while the status was copied, try again later
+#define HELM_STATUS_BUSY 2
+
+//! @brief Page is not initialized or it is written by a different version
+#define HELM_STATUS_INVALID -1
+
+typedef struct helm_status_reader helm_status_reader_t;
+
+/**
+ * @brief Opens the status page of a helm
+ *
+ * Page stays valid when the helm restarts, a reader may be kept open.
+ *
+ * @param name Name of the shared memory object, see `status_page/name`
+ * @return Reader, or NULL with errno set if the page doesn't exist yet
+ */
+helm_status_reader_t* helm_status_open(const char* name);
+
+/**
+ * @brief Copies a consistent snapshot of the status
+ *
+ * Never blocks. It only retries a bounded number of times if the helm writes
+ * the page during the copy.
+ *
+ * @param reader
+ * @param status Output
+ * @return One of HELM_STATUS_OK, HELM_STATUS_STOPPED, HELM_STATUS_BUSY or
+ *         HELM_STATUS_INVALID
+ */
+int helm_status_read(helm_status_reader_t* reader, helm_status_t* status);
+
+/**
+ * @brief Current sequence number of the page
+ *
+ * It changes every time the helm writes the status. A reader may poll it
+ * and copy the status only when it changes.
+ *
+ * @param reader
+ * @return sequence number
+ */
+uint64_t helm_status_sequence(const helm_status_reader_t* reader);
+
+/**
+ * @brief Marks the page of a helm as taken over by the calling process
+ *
+ * A standby calls it before it publishes its first set point. The helm that
+ * owns the page checks the mark every iteration and stops publishing once it
+ * is set, so a primary that was only stalled doesn't drive the controller
+ * beside the standby. The mark survives a restart of that helm and is kept
+ * until the calling process exits. While it is set, the helm follows the
+ * page given here as a standby, or stays idle if none is given.
+ *
+ * @param name Name of the shared memory object of the helm taken over
+ * @param owner Status page of the calling helm, may be NULL
+ * @return 0, or -1 with errno set if the page can't be opened or it is not
+ *         initialized
+ */
+int helm_status_take_over(const char* name, const char* owner);
+
+/**
+ * @brief Unmaps the page and frees the reader
+ *
+ * @param reader May be NULL
+ */
+void helm_status_close(helm_status_reader_t* reader);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,495 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#include "analysis.h"
+
+/*******************************************************************************
+ * STD
+ */
+#include "algorithm"
+#include "cmath"
+#include "iterator"
+#include "limits"
+#include "map"
+
+/*******************************************************************************
+ * ROS
+ */
+#include "ros/serialization.h"
+
+/*******************************************************************************
+ * MVP
+ */
+#include "mvp_msgs/ControlProcess.h"
+#include "mvp_helm/HelmPath.h"
+#include "mvp_helm/HelmTick.h"
+
+using namespace helm::analyze;
+
+namespace {
+
+    /**
+     * @brief Gaps between the messages longer than this, in seconds, are
+     *        not attributed to a state or a segment
+     *
+     * Helm doesn't tick without process values, and a recording may be
+     * paused.
+     */
+    constexpr double MAX_GAP = 1.0;
+
+    enum Kind {
+        KIND_POSE,
+        KIND_TICK,
+        KIND_PATH
+    };
+
+    //! @brief Header stamp, or the receive time if it is not set
+    double stamp_or(const ros::Time& stamp, double time) {
+        return stamp.isZero() ? time : stamp.toSec();
+    }
+
+    template <typename T>
+    void deserialize(const uint8_t* data, uint32_t size, T* msg) {
+        ros::serialization::IStream stream(const_cast<uint8_t*>(data), size);
+        ros::serialization::deserialize(stream, *msg);
+    }
+
+    struct segment_acc_t {
+        const helm::analyze::path_t* path = nullptr;
+        segment_row_t row;
+        double start_x, start_y, end_x, end_y;
+        double sum_squares;
+        double last_time;
+        bool past_end;
+    };
+
+    struct state_acc_t {
+        state_row_t row;
+        double sum_duration = 0;
+    };
+
+}
+
+/*******************************************************************************
+ * NameTable
+ */
+
+NameTable::NameTable() {
+
+    m_names.emplace_back();
+
+    m_ids[""] = 0;
+
+}
+
+uint16_t NameTable::intern(const std::string& name) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_ids.find(name);
+    if(it != m_ids.end()) {
+        return it->second;
+    }
+
+    auto id = static_cast<uint16_t>(m_names.size());
+
+    m_names.emplace_back(name);
+
+    m_ids[name] = id;
+
+    return id;
+
+}
+
+std::string NameTable::get(uint16_t id) const {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return id < m_names.size() ? m_names[id] : std::string();
+
+}
+
+/*******************************************************************************
+ * Samples
+ */
+
+void samples_t::append(samples_t&& other) {
+
+    poses.insert(poses.end(), other.poses.begin(), other.poses.end());
+
+    ticks.insert(ticks.end(), other.ticks.begin(), other.ticks.end());
+
+    std::move(other.paths.begin(), other.paths.end(),
+              std::back_inserter(paths));
+
+    messages += other.messages;
+
+}
+
+void samples_t::sort() {
+
+    auto by_time = [](const auto& a, const auto& b) {
+        return a.time < b.time;
+    };
+
+    /**
+     * Chunks are mostly in order, checking first is cheaper than sorting
+     */
+    if(!std::is_sorted(poses.begin(), poses.end(), by_time)) {
+        std::stable_sort(poses.begin(), poses.end(), by_time);
+    }
+
+    if(!std::is_sorted(ticks.begin(), ticks.end(), by_time)) {
+        std::stable_sort(ticks.begin(), ticks.end(), by_time);
+    }
+
+    if(!std::is_sorted(paths.begin(), paths.end(), by_time)) {
+        std::stable_sort(paths.begin(), paths.end(), by_time);
+    }
+
+}
+
+topics_t topics_t::of_helm(const std::string& helm) {
+
+    topics_t t;
+
+    // Helm subscribes to the controller in its own namespace
+    auto ns = helm.substr(0, helm.rfind('/') + 1);
+
+    t.process_value = ns + "controller/process/value";
+
+    t.tick = helm + "/log/tick";
+
+    t.path = helm + "/log/path";
+
+    return t;
+
+}
+
+/*******************************************************************************
+ * Extraction
+ */
+
+void helm::analyze::extract(const BagFile& bag, const BagFile::chunk_t& chunk,
+                            const topics_t& topics, NameTable* names,
+                            std::vector<uint8_t>* buffer, samples_t* samples) {
+
+    std::map<uint32_t, Kind> kinds;
+    for(const auto& c : bag.get_connections()) {
+        if(c.second.topic == topics.process_value &&
+            c.second.type == "mvp_msgs/ControlProcess") {
+            kinds[c.first] = KIND_POSE;
+        } else if(c.second.topic == topics.tick &&
+            c.second.type == "mvp_helm/HelmTick") {
+            kinds[c.first] = KIND_TICK;
+        } else if(c.second.topic == topics.path &&
+            c.second.type == "mvp_helm/HelmPath") {
+            kinds[c.first] = KIND_PATH;
+        }
+    }
+
+    if(kinds.empty()) {
+        return;
+    }
+
+    /**
+     * Names repeat in every tick, only the new ones go to the shared table
+     */
+    std::unordered_map<std::string, uint16_t> cache;
+    auto id = [&](const std::string& name) {
+        auto it = cache.find(name);
+        if(it != cache.end()) {
+            return it->second;
+        }
+        return cache[name] = names->intern(name);
+    };
+
+    bag.read_chunk(chunk, buffer,
+        [&](uint32_t connection, double time, const uint8_t* data,
+            uint32_t size) {
+
+        auto kind = kinds.find(connection);
+        if(kind == kinds.end()) {
+            return;
+        }
+
+        switch(kind->second) {
+            case KIND_POSE: {
+                mvp_msgs::ControlProcess m;
+                deserialize(data, size, &m);
+
+                samples->poses.push_back({
+                    stamp_or(m.header.stamp, time),
+                    m.position.x, m.position.y});
+                break;
+            }
+            case KIND_TICK: {
+                mvp_helm::HelmTick m;
+                deserialize(data, size, &m);
+
+                tick_t t;
+                t.time = stamp_or(m.header.stamp, time);
+                t.state = id(m.state);
+                t.path_behavior = id(m.path_behavior);
+                t.path_target = m.path_target;
+                for(size_t dof = 0 ; dof < t.dof_winners.size() ; dof++) {
+                    t.dof_winners[dof] = id(m.dof_winners[dof]);
+                    t.dof_requests[dof] = m.dof_requests[dof];
+                }
+                t.duration = m.duration;
+
+                samples->ticks.emplace_back(t);
+                break;
+            }
+            case KIND_PATH: {
+                mvp_helm::HelmPath m;
+                deserialize(data, size, &m);
+
+                path_t p;
+                p.time = stamp_or(m.header.stamp, time);
+                p.behavior = id(m.behavior);
+                p.x = std::move(m.x);
+                p.y = std::move(m.y);
+
+                samples->paths.emplace_back(std::move(p));
+                break;
+            }
+        }
+
+        samples->messages++;
+    });
+
+}
+
+/*******************************************************************************
+ * Summary
+ */
+
+report_t helm::analyze::summarize(const std::string& file,
+                                  const samples_t& samples,
+                                  const NameTable& names) {
+
+    report_t report;
+
+    report.file = file;
+
+    double t0 = std::numeric_limits<double>::infinity();
+    if(!samples.poses.empty()) {
+        t0 = std::min(t0, samples.poses.front().time);
+    }
+    if(!samples.ticks.empty()) {
+        t0 = std::min(t0, samples.ticks.front().time);
+    }
+
+    /**
+     * States, from the ticks alone
+     */
+    std::map<uint16_t, state_acc_t> states;
+    std::vector<uint16_t> state_order;
+
+    const tick_t* previous = nullptr;
+    for(const auto& t : samples.ticks) {
+        auto inserted = states.emplace(t.state, state_acc_t());
+        auto& s = inserted.first->second;
+        if(inserted.second) {
+            s.row = state_row_t();
+            s.row.state = names.get(t.state);
+            state_order.push_back(t.state);
+        }
+
+        if(previous != nullptr) {
+            auto dt = t.time - previous->time;
+            if(dt > 0 && dt <= MAX_GAP) {
+                states[previous->state].row.time += dt;
+            }
+
+            for(size_t dof = 0 ; dof < t.dof_winners.size() ; dof++) {
+                if(t.dof_winners[dof] != previous->dof_winners[dof]) {
+                    s.row.winner_changes++;
+                }
+            }
+        }
+
+        if(previous == nullptr || previous->state != t.state) {
+            s.row.visits++;
+        }
+
+        s.row.ticks++;
+        s.sum_duration += t.duration;
+        s.row.max_duration = std::max(s.row.max_duration, t.duration);
+
+        if(std::any_of(t.dof_requests.begin(), t.dof_requests.end(),
+                       [](uint8_t r) { return r > 1; })) {
+            s.row.contended_ticks++;
+        }
+
+        previous = &t;
+    }
+
+    for(auto id : state_order) {
+        auto& s = states[id];
+        s.row.mean_duration = s.sum_duration / s.row.ticks;
+        report.states.emplace_back(s.row);
+    }
+
+    /**
+     * Segments, process values against the leg of the last tick
+     */
+    std::map<uint16_t, const path_t*> paths;
+    auto path_it = samples.paths.begin();
+    auto tick_it = samples.ticks.begin();
+    const tick_t* tick = nullptr;
+
+    segment_acc_t segment;
+
+    auto close = [&]() {
+        if(segment.path != nullptr && segment.row.samples > 0) {
+            segment.row.duration = segment.last_time -
+                (segment.row.start + t0);
+            segment.row.rms_cross_track =
+                std::sqrt(segment.sum_squares / segment.row.samples);
+            report.segments.emplace_back(segment.row);
+        }
+        segment.path = nullptr;
+    };
+
+    for(const auto& p : samples.poses) {
+        for( ; path_it != samples.paths.end() && path_it->time <= p.time ;
+               ++path_it) {
+            paths[path_it->behavior] = &*path_it;
+        }
+
+        for( ; tick_it != samples.ticks.end() && tick_it->time <= p.time ;
+               ++tick_it) {
+            tick = &*tick_it;
+        }
+
+        /**
+         * A leg is followed while its behavior wins a DOF and the helm ticks
+         */
+        const path_t* path = nullptr;
+        if(tick != nullptr && p.time - tick->time <= MAX_GAP &&
+            tick->path_behavior != 0 && tick->path_target >= 0 &&
+            std::find(tick->dof_winners.begin(), tick->dof_winners.end(),
+                      tick->path_behavior) != tick->dof_winners.end()) {
+            auto it = paths.find(tick->path_behavior);
+            if(it != paths.end() &&
+                static_cast<size_t>(tick->path_target) < it->second->x.size()) {
+                path = it->second;
+            }
+        }
+
+        if(path == nullptr) {
+            close();
+            continue;
+        }
+
+        if(segment.path != path || segment.row.target != tick->path_target ||
+            p.time - segment.last_time > MAX_GAP) {
+            close();
+
+            auto target = static_cast<size_t>(tick->path_target);
+
+            segment.path = path;
+            segment.row = segment_row_t();
+            segment.row.behavior = names.get(path->behavior);
+            segment.row.target = tick->path_target;
+            segment.row.start = p.time - t0;
+            segment.start_x = target > 0 ? path->x[target - 1] : p.x;
+            segment.start_y = target > 0 ? path->y[target - 1] : p.y;
+            segment.end_x = path->x[target];
+            segment.end_y = path->y[target];
+            segment.row.length = std::hypot(segment.end_x - segment.start_x,
+                                            segment.end_y - segment.start_y);
+            segment.sum_squares = 0;
+            segment.last_time = p.time;
+            segment.past_end = false;
+        }
+
+        double cross_track;
+        double past;
+        if(segment.row.length > 1e-6) {
+            auto ux = (segment.end_x - segment.start_x) / segment.row.length;
+            auto uy = (segment.end_y - segment.start_y) / segment.row.length;
+            auto dx = p.x - segment.start_x;
+            auto dy = p.y - segment.start_y;
+            cross_track = -dx * uy + dy * ux;
+            past = dx * ux + dy * uy - segment.row.length;
+        } else {
+            cross_track = std::hypot(p.x - segment.end_x, p.y - segment.end_y);
+            past = 0;
+        }
+
+        segment.row.samples++;
+        segment.sum_squares += cross_track * cross_track;
+        segment.row.max_cross_track =
+            std::max(segment.row.max_cross_track, std::fabs(cross_track));
+
+        if(past > 0) {
+            if(!segment.past_end) {
+                segment.row.overshoots++;
+            } else {
+                segment.row.overshoot_time += p.time - segment.last_time;
+            }
+        }
+        segment.past_end = past > 0;
+
+        segment.last_time = p.time;
+    }
+
+    close();
+
+    return report;
+
+}
+
+std::vector<state_row_t> helm::analyze::merge_states(
+        const std::vector<report_t>& reports) {
+
+    std::vector<state_row_t> merged;
+    std::map<std::string, size_t> index;
+
+    for(const auto& r : reports) {
+        for(const auto& s : r.states) {
+            auto inserted = index.emplace(s.state, merged.size());
+            if(inserted.second) {
+                merged.emplace_back(s);
+                continue;
+            }
+
+            auto& m = merged[inserted.first->second];
+            auto ticks = m.ticks + s.ticks;
+            m.mean_duration = ticks == 0 ? 0 :
+                (m.mean_duration * m.ticks + s.mean_duration * s.ticks) / ticks;
+            m.max_duration = std::max(m.max_duration, s.max_duration);
+            m.visits += s.visits;
+            m.time += s.time;
+            m.ticks = ticks;
+            m.contended_ticks += s.contended_ticks;
+            m.winner_changes += s.winner_changes;
+        }
+    }
+
+    return merged;
+
+}
@@ -0,0 +1,204 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#pragma once
+
+/*******************************************************************************
+ * STD
+ */
+#include "array"
+#include "cstdint"
+#include "mutex"
+#include "string"
+#include "unordered_map"
+#include "vector"
+
+#include "bag_file.h"
+
+namespace helm {
+
+namespace analyze {
+
+    /**
+     * @brief Behavior and state names, shared by the threads
+     *
+     * Identifier 0 is the empty name.
+     */
+    class NameTable {
+    private:
+
+        mutable std::mutex m_mutex;
+
+        std::vector<std::string> m_names;
+
+        std::unordered_map<std::string, uint16_t> m_ids;
+
+    public:
+
+        NameTable();
+
+        uint16_t intern(const std::string& name);
+
+        std::string get(uint16_t id) const;
+
+    };
+
+    //! @brief Process value of the controller
+    struct pose_t {
+        double time;
+        double x;
+        double y;
+    };
+
+    //! @brief An iteration of the helm, see mvp_helm/HelmTick
+    struct tick_t {
+        double time;
+        uint16_t state;
+        uint16_t path_behavior;
+        int32_t path_target;
+        std::array<uint16_t, 12> dof_winners;
+        std::array<uint8_t, 12> dof_requests;
+        double duration;
+    };
+
+    //! @brief A path reported by a behavior, see mvp_helm/HelmPath
+    struct path_t {
+        double time;
+        uint16_t behavior;
+        std::vector<double> x;
+        std::vector<double> y;
+    };
+
+    /**
+     * @brief Messages of the helm extracted from a bag
+     */
+    struct samples_t {
+        std::vector<pose_t> poses;
+        std::vector<tick_t> ticks;
+        std::vector<path_t> paths;
+        //! @brief Number of decoded messages
+        size_t messages = 0;
+
+        void append(samples_t&& other);
+
+        //! @brief Orders the samples by time, chunks may overlap
+        void sort();
+    };
+
+    /**
+     * @brief Topics of the helm to analyze
+     */
+    struct topics_t {
+        std::string process_value;
+        std::string tick;
+        std::string path;
+
+        /**
+         * @brief Topics of a helm node
+         *
+         * @param helm Name of the helm node, e.g. "/helm"
+         */
+        static topics_t of_helm(const std::string& helm);
+    };
+
+    /**
+     * @brief A visit to a leg of the path
+     *
+     * The leg ends at the waypoint the behavior heads to. It starts at the
+     * previous waypoint, or where the vehicle is for the first waypoint.
+     */
+    struct segment_row_t {
+        std::string behavior;
+        //! @brief Index of the waypoint at the end of the leg
+        int32_t target;
+        //! @brief Seconds since the start of the log
+        double start;
+        double duration;
+        //! @brief Length of the leg in meters
+        double length;
+        size_t samples;
+        //! @brief Root mean square cross track error in meters
+        double rms_cross_track;
+        double max_cross_track;
+        //! @brief Number of times the vehicle passed the end of the leg
+        size_t overshoots;
+        //! @brief Seconds spent past the end of the leg
+        double overshoot_time;
+    };
+
+    struct state_row_t {
+        std::string state;
+        //! @brief Number of times the state is entered
+        size_t visits;
+        //! @brief Seconds in the state
+        double time;
+        size_t ticks;
+        //! @brief Iteration durations in seconds
+        double mean_duration;
+        double max_duration;
+        //! @brief Ticks where more than one behavior requested a DOF
+        size_t contended_ticks;
+        //! @brief Number of times a DOF changed hands
+        size_t winner_changes;
+    };
+
+    struct report_t {
+        std::string file;
+        std::vector<segment_row_t> segments;
+        std::vector<state_row_t> states;
+    };
+
+    /**
+     * @brief Decodes the messages of the helm in a chunk
+     *
+     * Thread safe, chunks of a bag may be extracted in parallel.
+     *
+     * @param bag
+     * @param chunk
+     * @param topics
+     * @param names Receives the behavior and state names
+     * @param buffer Scratch memory of the calling thread
+     * @param samples Output
+     */
+    void extract(const BagFile& bag, const BagFile::chunk_t& chunk,
+                 const topics_t& topics, NameTable* names,
+                 std::vector<uint8_t>* buffer, samples_t* samples);
+
+    /**
+     * @brief Summarizes the samples of a log
+     *
+     * @param file Name of the log
+     * @param samples Ordered by time, see #samples_t::sort
+     * @param names
+     */
+    report_t summarize(const std::string& file, const samples_t& samples,
+                       const NameTable& names);
+
+    /**
+     * @brief Sums the state rows of several logs by state name
+     */
+    std::vector<state_row_t> merge_states(const std::vector<report_t>& reports);
+
+}
+
+}
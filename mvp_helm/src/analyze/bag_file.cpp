@@ -0,0 +1,344 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#include "bag_file.h"
+
+/*******************************************************************************
+ * STD
+ */
+#include "cerrno"
+#include "cstring"
+#include "stdexcept"
+
+/*******************************************************************************
+ * POSIX
+ */
+#include "fcntl.h"
+#include "sys/mman.h"
+#include "sys/stat.h"
+#include "unistd.h"
+
+/*******************************************************************************
+ * Compression
+ */
+#include "bzlib.h"
+#include "roslz4/lz4s.h"
+
+using namespace helm::analyze;
+
+namespace {
+
+    const char BAG_MAGIC[] = "#ROSBAG V2.0\n";
+
+    enum Op : uint8_t {
+        OP_MESSAGE_DATA = 0x02,
+        OP_BAG_HEADER = 0x03,
+        OP_INDEX_DATA = 0x04,
+        OP_CHUNK = 0x05,
+        OP_CHUNK_INFO = 0x06,
+        OP_CONNECTION = 0x07
+    };
+
+    /**
+     * @brief A record is a header of "name=value" fields and its data
+     */
+    struct record_t {
+        const uint8_t* header;
+        uint32_t header_size;
+        const uint8_t* data;
+        uint32_t data_size;
+    };
+
+    uint32_t read_u32(const uint8_t* p) {
+        uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    /**
+     * @brief Reads the record at @p p and moves @p p past it
+     */
+    record_t read_record(const uint8_t** p, const uint8_t* end) {
+        record_t r;
+
+        if(end - *p < 4) {
+            throw std::runtime_error("truncated record");
+        }
+        r.header_size = read_u32(*p);
+        r.header = *p + 4;
+
+        if(static_cast<size_t>(end - r.header) < r.header_size + 4ul) {
+            throw std::runtime_error("truncated record header");
+        }
+        r.data_size = read_u32(r.header + r.header_size);
+        r.data = r.header + r.header_size + 4;
+
+        if(static_cast<size_t>(end - r.data) < r.data_size) {
+            throw std::runtime_error("truncated record data");
+        }
+
+        *p = r.data + r.data_size;
+
+        return r;
+    }
+
+    /**
+     * @brief Finds a field of a record header or a connection header
+     *
+     * @return false if there is no such field
+     */
+    bool find_field(const uint8_t* header, uint32_t size, const char* name,
+                    const uint8_t** value, uint32_t* value_size) {
+        auto name_size = std::strlen(name);
+
+        const uint8_t* p = header;
+        const uint8_t* end = header + size;
+
+        while(end - p >= 4) {
+            auto field_size = read_u32(p);
+            p += 4;
+
+            if(static_cast<size_t>(end - p) < field_size) {
+                break;
+            }
+
+            if(field_size > name_size && p[name_size] == '=' &&
+                std::memcmp(p, name, name_size) == 0) {
+                *value = p + name_size + 1;
+                *value_size = field_size - static_cast<uint32_t>(name_size) - 1;
+                return true;
+            }
+
+            p += field_size;
+        }
+
+        return false;
+    }
+
+    template <typename T>
+    T field(const uint8_t* header, uint32_t size, const char* name) {
+        const uint8_t* value;
+        uint32_t value_size;
+        if(!find_field(header, size, name, &value, &value_size) ||
+            value_size != sizeof(T)) {
+            throw std::runtime_error(std::string("missing field ") + name);
+        }
+
+        T v;
+        std::memcpy(&v, value, sizeof(T));
+        return v;
+    }
+
+    std::string string_field(const uint8_t* header, uint32_t size,
+                             const char* name) {
+        const uint8_t* value;
+        uint32_t value_size;
+        if(!find_field(header, size, name, &value, &value_size)) {
+            return std::string();
+        }
+
+        return std::string(reinterpret_cast<const char*>(value), value_size);
+    }
+
+    //! @brief Time field, seconds and nanoseconds as two uint32
+    double time_field(const uint8_t* header, uint32_t size, const char* name) {
+        auto t = field<uint64_t>(header, size, name);
+        return static_cast<double>(t & 0xffffffffu) +
+            static_cast<double>(t >> 32) * 1e-9;
+    }
+
+    uint8_t op(const record_t& r) {
+        return field<uint8_t>(r.header, r.header_size, "op");
+    }
+
+}
+
+BagFile::BagFile(const std::string &path) {
+
+    m_path = path;
+
+    auto fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0) {
+        throw std::runtime_error(std::strerror(errno));
+    }
+
+    struct stat st;
+    if(fstat(fd, &st) != 0) {
+        auto error = errno;
+        close(fd);
+        throw std::runtime_error(std::strerror(error));
+    }
+
+    m_size = static_cast<size_t>(st.st_size);
+
+    if(m_size < sizeof(BAG_MAGIC) - 1) {
+        close(fd);
+        throw std::runtime_error("not a bag file");
+    }
+
+    auto data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    close(fd);
+
+    if(data == MAP_FAILED) {
+        throw std::runtime_error(std::strerror(errno));
+    }
+
+    m_data = static_cast<const uint8_t*>(data);
+
+    try {
+        f_read_index();
+    } catch(...) {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+        throw;
+    }
+
+}
+
+BagFile::~BagFile() {
+
+    munmap(const_cast<uint8_t*>(m_data), m_size);
+
+}
+
+void BagFile::f_read_index() {
+
+    if(std::memcmp(m_data, BAG_MAGIC, sizeof(BAG_MAGIC) - 1) != 0) {
+        throw std::runtime_error("not a version 2.0 bag file");
+    }
+
+    const uint8_t* end = m_data + m_size;
+    const uint8_t* p = m_data + sizeof(BAG_MAGIC) - 1;
+
+    auto header = read_record(&p, end);
+    if(op(header) != OP_BAG_HEADER) {
+        throw std::runtime_error("bag header is missing");
+    }
+
+    auto index_pos = field<uint64_t>(
+        header.header, header.header_size, "index_pos");
+    if(index_pos == 0 || index_pos >= m_size) {
+        throw std::runtime_error("bag is not indexed, run 'rosbag reindex'");
+    }
+
+    /**
+     * Index section is the connections followed by the chunk infos
+     */
+    p = m_data + index_pos;
+    while(p < end) {
+        auto r = read_record(&p, end);
+
+        switch(op(r)) {
+            case OP_CONNECTION: {
+                auto id = field<uint32_t>(r.header, r.header_size, "conn");
+                auto& c = m_connections[id];
+                c.topic = string_field(r.header, r.header_size, "topic");
+                c.type = string_field(r.data, r.data_size, "type");
+                break;
+            }
+            case OP_CHUNK_INFO: {
+                chunk_t c;
+                c.position = field<uint64_t>(
+                    r.header, r.header_size, "chunk_pos");
+                c.start = time_field(r.header, r.header_size, "start_time");
+                c.end = time_field(r.header, r.header_size, "end_time");
+                if(c.position >= m_size) {
+                    throw std::runtime_error("chunk is out of the file");
+                }
+                m_chunks.emplace_back(c);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+}
+
+void BagFile::read_chunk(const chunk_t& chunk, std::vector<uint8_t>* buffer,
+                         const message_cb_t& callback) const {
+
+    const uint8_t* p = m_data + chunk.position;
+
+    auto r = read_record(&p, m_data + m_size);
+    if(op(r) != OP_CHUNK) {
+        throw std::runtime_error("chunk record is expected");
+    }
+
+    auto compression = string_field(r.header, r.header_size, "compression");
+    auto size = field<uint32_t>(r.header, r.header_size, "size");
+
+    const uint8_t* records = r.data;
+
+    if(compression == "none") {
+        /**
+         * Messages are read in place, ask for the pages of the chunk ahead
+         */
+        auto page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        auto first = reinterpret_cast<uintptr_t>(r.data) & ~(page - 1);
+        madvise(reinterpret_cast<void*>(first),
+            reinterpret_cast<uintptr_t>(r.data) + r.data_size - first,
+            MADV_WILLNEED);
+
+        size = r.data_size;
+    } else {
+        buffer->resize(size);
+
+        auto output = reinterpret_cast<char*>(buffer->data());
+        auto input = reinterpret_cast<char*>(const_cast<uint8_t*>(r.data));
+        unsigned int output_size = size;
+
+        bool ok;
+        if(compression == "bz2") {
+            ok = BZ2_bzBuffToBuffDecompress(
+                output, &output_size, input, r.data_size, 0, 0) == BZ_OK;
+        } else if(compression == "lz4") {
+            ok = roslz4_buffToBuffDecompress(
+                input, r.data_size, output, &output_size) == ROSLZ4_OK;
+        } else {
+            throw std::runtime_error(
+                "unknown chunk compression " + compression);
+        }
+
+        if(!ok || output_size != size) {
+            throw std::runtime_error("chunk can not be decompressed");
+        }
+
+        records = buffer->data();
+    }
+
+    p = records;
+    const uint8_t* end = records + size;
+    while(p < end) {
+        auto m = read_record(&p, end);
+
+        if(op(m) != OP_MESSAGE_DATA) {
+            continue;
+        }
+
+        callback(field<uint32_t>(m.header, m.header_size, "conn"),
+                 time_field(m.header, m.header_size, "time"),
+                 m.data, m.data_size);
+    }
+
+}
@@ -0,0 +1,139 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#pragma once
+
+/*******************************************************************************
+ * STD
+ */
+#include "cstdint"
+#include "functional"
+#include "map"
+#include "string"
+#include "vector"
+
+namespace helm {
+
+namespace analyze {
+
+    /**
+     * @brief Memory mapped reader of ROS bag files, format version 2.0
+     *
+     * The file is mapped once and the index at its end is read when it is
+     * opened. Chunks are independent, #BagFile::read_chunk is thread safe and
+     * several threads may read different chunks of the same file at the same
+     * time. Messages of uncompressed chunks are handed out in place, without
+     * a copy. Compressed chunks, bz2 and lz4, are decompressed into a buffer
+     * of the caller.
+     *
+     * Bags that are not closed properly have no index, they should be
+     * reindexed with "rosbag reindex" first.
+     */
+    class BagFile {
+    public:
+
+        struct connection_t {
+            std::string topic;
+            //! @brief Message type, e.g. "mvp_msgs/ControlProcess"
+            std::string type;
+        };
+
+        struct chunk_t {
+            //! @brief Offset of the chunk record in the file
+            uint64_t position;
+            //! @brief Receive time of the first and the last message
+            double start;
+            double end;
+        };
+
+        /**
+         * @brief Called for every message of a chunk
+         *
+         * @param connection Identifier of the connection
+         * @param time Receive time of the message in seconds
+         * @param data Serialized message, valid until the call returns
+         * @param size Size of the message in bytes
+         */
+        typedef std::function<void(uint32_t connection, double time,
+                                   const uint8_t* data, uint32_t size)>
+            message_cb_t;
+
+    private:
+
+        std::string m_path;
+
+        const uint8_t* m_data;
+
+        size_t m_size;
+
+        std::map<uint32_t, connection_t> m_connections;
+
+        std::vector<chunk_t> m_chunks;
+
+        void f_read_index();
+
+    public:
+
+        /**
+         * @brief Maps and indexes a bag file
+         *
+         * @param path
+         * @throws std::runtime_error if the file is not an indexed bag
+         */
+        explicit BagFile(const std::string& path);
+
+        ~BagFile();
+
+        BagFile(const BagFile&) = delete;
+
+        BagFile& operator=(const BagFile&) = delete;
+
+        /**
+         * @brief Delivers the messages of a chunk in the order of the file
+         *
+         * @param chunk One of #BagFile::get_chunks
+         * @param buffer Holds the decompressed chunk, may be reused between
+         *               the calls of the same thread
+         * @param callback
+         * @throws std::runtime_error if the chunk is corrupted
+         */
+        void read_chunk(const chunk_t& chunk, std::vector<uint8_t>* buffer,
+                        const message_cb_t& callback) const;
+
+        auto get_connections() const -> const decltype(m_connections)& {
+            return m_connections;
+        }
+
+        auto get_chunks() const -> const decltype(m_chunks)& {
+            return m_chunks;
+        }
+
+        auto get_path() const -> const decltype(m_path)& { return m_path; }
+
+        size_t get_size() const { return m_size; }
+
+    };
+
+}
+
+}
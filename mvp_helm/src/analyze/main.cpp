@@ -0,0 +1,361 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+/*******************************************************************************
+ * STD
+ */
+#include "algorithm"
+#include "atomic"
+#include "chrono"
+#include "cstdlib"
+#include "fstream"
+#include "functional"
+#include "iomanip"
+#include "iostream"
+#include "memory"
+#include "mutex"
+#include "string"
+#include "thread"
+#include "vector"
+
+#include "analysis.h"
+
+/**
+ * Summarizes recorded missions of the helm.
+ *
+ * Usage:
+ *   rosrun mvp_helm helm_analyze [-j jobs] [--helm /helm] [--csv prefix]
+ *       log1.bag [log2.bag ...]
+ *
+ * Logs must contain the process values and the "~log/tick" and "~log/path"
+ * topics of the helm. Bags are memory mapped, their chunks are decoded in
+ * parallel and then each log is summarized in parallel. Prints a table of
+ * the path legs and a table of the states for each log, and the states of
+ * all the logs together. With "--csv", the tables are also written to
+ * "<prefix>segments.csv" and "<prefix>states.csv".
+ */
+
+namespace {
+
+    enum ExitStatus : int {
+        OK = 0,
+        ERROR = 2
+    };
+
+    struct options_t {
+        std::vector<std::string> logs;
+        std::string helm = "/helm";
+        std::string csv;
+        int jobs = 0;
+    };
+
+    bool parse_options(int argc, char* argv[], options_t* opts) {
+
+        for(int i = 1 ; i < argc ; i++) {
+            std::string arg = argv[i];
+
+            bool has_value = i + 1 < argc;
+
+            if(arg == "-j" && has_value) {
+                opts->jobs = std::atoi(argv[++i]);
+            } else if(arg == "--helm" && has_value) {
+                opts->helm = argv[++i];
+            } else if(arg == "--csv" && has_value) {
+                opts->csv = argv[++i];
+            } else if(!arg.empty() && arg[0] == '-') {
+                return false;
+            } else {
+                opts->logs.emplace_back(arg);
+            }
+        }
+
+        return !opts->logs.empty();
+    }
+
+    /**
+     * @brief Calls job(i) for i in [0, count) on the given number of threads
+     */
+    void parallel_for(size_t count, int jobs,
+                      const std::function<void(size_t)>& job) {
+
+        std::atomic<size_t> next(0);
+
+        auto worker = [&]() {
+            for(size_t i = next++ ; i < count ; i = next++) {
+                job(i);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for(int i = 1 ; i < jobs && static_cast<size_t>(i) < count ; i++) {
+            threads.emplace_back(worker);
+        }
+
+        worker();
+
+        for(auto& t : threads) {
+            t.join();
+        }
+    }
+
+    void print_segments(std::ostream& out, const helm::analyze::report_t& r) {
+
+        out << std::left
+            << "  " << std::setw(16) << "behavior"
+            << std::right
+            << std::setw(6) << "leg"
+            << std::setw(10) << "start[s]"
+            << std::setw(10) << "time[s]"
+            << std::setw(10) << "len[m]"
+            << std::setw(10) << "rms[m]"
+            << std::setw(10) << "max[m]"
+            << std::setw(11) << "overshoot"
+            << std::setw(10) << "past[s]" << "\n";
+
+        for(const auto& s : r.segments) {
+            out << std::left
+                << "  " << std::setw(16) << s.behavior
+                << std::right << std::fixed << std::setprecision(2)
+                << std::setw(6) << s.target
+                << std::setw(10) << s.start
+                << std::setw(10) << s.duration
+                << std::setw(10) << s.length
+                << std::setw(10) << s.rms_cross_track
+                << std::setw(10) << s.max_cross_track
+                << std::setw(11) << s.overshoots
+                << std::setw(10) << s.overshoot_time << "\n";
+        }
+    }
+
+    void print_states(std::ostream& out,
+                      const std::vector<helm::analyze::state_row_t>& states) {
+
+        out << std::left
+            << "  " << std::setw(16) << "state"
+            << std::right
+            << std::setw(8) << "visits"
+            << std::setw(11) << "time[s]"
+            << std::setw(9) << "ticks"
+            << std::setw(10) << "mean[ms]"
+            << std::setw(10) << "max[ms]"
+            << std::setw(11) << "contended"
+            << std::setw(9) << "handoff" << "\n";
+
+        for(const auto& s : states) {
+            out << std::left
+                << "  " << std::setw(16) << s.state
+                << std::right << std::fixed << std::setprecision(2)
+                << std::setw(8) << s.visits
+                << std::setw(11) << s.time
+                << std::setw(9) << s.ticks
+                << std::setw(10) << s.mean_duration * 1e3
+                << std::setw(10) << s.max_duration * 1e3
+                << std::setw(11) << s.contended_ticks
+                << std::setw(9) << s.winner_changes << "\n";
+        }
+    }
+
+    bool write_csv(const std::string& prefix,
+                   const std::vector<helm::analyze::report_t>& reports) {
+
+        std::ofstream segments(prefix + "segments.csv");
+        std::ofstream states(prefix + "states.csv");
+
+        if(!segments || !states) {
+            return false;
+        }
+
+        segments << std::setprecision(9) << "file,behavior,leg,start,duration,"
+            "length,rms_cross_track,max_cross_track,overshoots,overshoot_time\n";
+
+        states << std::setprecision(9) << "file,state,visits,time,ticks,"
+            "mean_duration,max_duration,contended_ticks,winner_changes\n";
+
+        for(const auto& r : reports) {
+            for(const auto& s : r.segments) {
+                segments << r.file << "," << s.behavior << "," << s.target
+                    << "," << s.start << "," << s.duration << "," << s.length
+                    << "," << s.rms_cross_track << "," << s.max_cross_track
+                    << "," << s.overshoots << "," << s.overshoot_time << "\n";
+            }
+
+            for(const auto& s : r.states) {
+                states << r.file << "," << s.state << "," << s.visits << ","
+                    << s.time << "," << s.ticks << "," << s.mean_duration
+                    << "," << s.max_duration << "," << s.contended_ticks
+                    << "," << s.winner_changes << "\n";
+            }
+        }
+
+        return static_cast<bool>(segments) && static_cast<bool>(states);
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+
+    options_t opts;
+    if(!parse_options(argc, argv, &opts)) {
+        std::cerr << "usage: helm_analyze [-j jobs] [--helm /helm]"
+            " [--csv prefix] log1.bag [log2.bag ...]" << std::endl;
+        return ERROR;
+    }
+
+    if(opts.jobs <= 0) {
+        opts.jobs = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    auto topics = helm::analyze::topics_t::of_helm(opts.helm);
+
+    helm::analyze::NameTable names;
+
+    auto count = opts.logs.size();
+
+    std::vector<std::unique_ptr<helm::analyze::BagFile>> bags(count);
+
+    std::vector<std::string> errors(count);
+
+    /**
+     * Index every log, then decode every chunk of every log
+     */
+    parallel_for(count, opts.jobs, [&](size_t i) {
+        try {
+            bags[i].reset(new helm::analyze::BagFile(opts.logs[i]));
+        } catch(const std::exception& e) {
+            errors[i] = e.what();
+        }
+    });
+
+    struct task_t {
+        size_t log;
+        size_t chunk;
+    };
+
+    std::vector<task_t> tasks;
+    size_t bytes = 0;
+    for(size_t i = 0 ; i < count ; i++) {
+        if(!bags[i]) {
+            continue;
+        }
+
+        bytes += bags[i]->get_size();
+
+        for(size_t c = 0 ; c < bags[i]->get_chunks().size() ; c++) {
+            tasks.push_back({i, c});
+        }
+    }
+
+    std::vector<helm::analyze::samples_t> chunk_samples(tasks.size());
+
+    std::mutex error_mutex;
+
+    parallel_for(tasks.size(), opts.jobs, [&](size_t i) {
+        thread_local std::vector<uint8_t> buffer;
+
+        const auto& bag = *bags[tasks[i].log];
+        try {
+            helm::analyze::extract(bag, bag.get_chunks()[tasks[i].chunk],
+                topics, &names, &buffer, &chunk_samples[i]);
+        } catch(const std::exception& e) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            errors[tasks[i].log] = e.what();
+        }
+    });
+
+    /**
+     * Chunks of a log are put back together in the order of the file
+     */
+    std::vector<helm::analyze::samples_t> samples(count);
+    for(size_t i = 0 ; i < tasks.size() ; i++) {
+        samples[tasks[i].log].append(std::move(chunk_samples[i]));
+    }
+    chunk_samples.clear();
+
+    std::vector<helm::analyze::report_t> reports(count);
+
+    parallel_for(count, opts.jobs, [&](size_t i) {
+        if(!bags[i] || !errors[i].empty()) {
+            return;
+        }
+
+        samples[i].sort();
+
+        if(samples[i].ticks.empty()) {
+            errors[i] = "no ticks on " + topics.tick;
+            return;
+        }
+
+        reports[i] = helm::analyze::summarize(opts.logs[i], samples[i], names);
+    });
+
+    size_t messages = 0;
+    for(const auto& s : samples) {
+        messages += s.messages;
+    }
+
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    /**
+     * Tables
+     */
+    auto status = OK;
+
+    std::vector<helm::analyze::report_t> analyzed;
+
+    for(size_t i = 0 ; i < count ; i++) {
+        if(!errors[i].empty()) {
+            std::cerr << opts.logs[i] << ": " << errors[i] << std::endl;
+            status = ERROR;
+            continue;
+        }
+
+        std::cout << opts.logs[i] << "\n";
+        print_segments(std::cout, reports[i]);
+        std::cout << "\n";
+        print_states(std::cout, reports[i].states);
+        std::cout << "\n";
+
+        analyzed.emplace_back(std::move(reports[i]));
+    }
+
+    if(analyzed.size() > 1) {
+        std::cout << "all logs\n";
+        print_states(std::cout, helm::analyze::merge_states(analyzed));
+        std::cout << "\n";
+    }
+
+    if(!opts.csv.empty() && !write_csv(opts.csv, analyzed)) {
+        std::cerr << "can not write the tables to " << opts.csv << std::endl;
+        status = ERROR;
+    }
+
+    std::cout << std::defaultfloat << analyzed.size() << " of " << count
+        << " logs, " << messages << " messages, " << std::setprecision(3)
+        << bytes / 1e6 << " MB in " << elapsed.count() << " s, "
+        << opts.jobs << " threads" << std::endl;
+
+    return status;
+}
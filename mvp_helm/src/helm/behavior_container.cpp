@@ -24,9 +24,13 @@
 
 #include "behavior_container.h"
 
+#include "chrono"
+#include "sstream"
 #include "utility"
 #include "exception.h"
 
+#include "ros/names.h"
+
 namespace helm
 {
 
@@ -54,6 +58,15 @@ namespace helm
 
         m_behavior->m_name = m_opts.name;
 
+        m_behavior->m_memory_resource = m_arena.get();
+
+        m_behavior->m_callback_queue = m_callback_queue;
+
+        auto descriptor = m_behavior->get_descriptor();
+        if(descriptor != nullptr) {
+            f_apply_descriptor(*descriptor);
+        }
+
         try {
             m_behavior->initialize();
         } catch ( BehaviorException &e) {
@@ -63,10 +76,94 @@ namespace helm
 
     }
 
+    void BehaviorContainer::f_apply_descriptor(
+        const behavior_descriptor_t& descriptor)
+    {
+        m_behavior->m_dofs.clear();
+        for(int dof = 0 ; dof < 16 ; dof++) {
+            if(descriptor.dofs & (1u << dof)) {
+                m_behavior->m_dofs.emplace_back(dof);
+            }
+        }
+
+        ros::NodeHandle nh(ros::this_node::getName() + "/" + m_opts.name);
+
+        auto errors = load_parameters(
+            nh, descriptor, &m_behavior->m_parameters);
+
+        /**
+         * Fixed names are checked by the author of the behavior, only the
+         * names coming from the configuration are validated.
+         */
+        for(size_t i = 0 ; i < descriptor.topic_count ; i++) {
+            const auto& topic = descriptor.topics[i];
+
+            std::string name = topic.name;
+            if(*topic.parameter != '\0') {
+                name = m_behavior->m_parameters.at(topic.parameter).string;
+
+                std::string error;
+                if(name.empty()) {
+                    continue;
+                }
+
+                if(!ros::names::validate(name, error)) {
+                    errors.emplace_back(std::string(topic.parameter) +
+                        " is '" + name + "', it is not a topic name: " +
+                        error);
+                }
+            }
+
+            ROS_DEBUG_STREAM(m_opts.name << (
+                topic.direction == TopicDirection::INPUT ?
+                    " subscribes " : " publishes ") <<
+                name << " [" << topic.type << "]");
+        }
+
+        if(!errors.empty()) {
+            std::stringstream ss;
+            ss << "Behavior (" << m_opts.name << ") is misconfigured:";
+            for(const auto& e : errors) {
+                ss << "\n  " << e;
+            }
+            throw HelmException(ss.str());
+        }
+    }
+
+    bool BehaviorContainer::request_set_point(
+        mvp_msgs::ControlProcess *set_point)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        m_set_point_result = m_behavior->request_set_point(set_point);
+
+        m_duration = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+
+        m_failures = m_set_point_result ? 0 : m_failures + 1;
+
+        m_set_point = *set_point;
+
+        return m_set_point_result;
+    }
+
+    bool BehaviorContainer::get_last_set_point(
+        mvp_msgs::ControlProcess *set_point)
+    {
+        *set_point = m_set_point;
+
+        return m_set_point_result;
+    }
+
     BehaviorContainer::~BehaviorContainer() {
 
         m_behavior.reset();
 
+        /**
+         * Whatever the behavior left behind goes with its arena
+         */
+        m_arena->release();
+
     }
 
 } // namespace helm
@@ -28,6 +28,7 @@
  * Behavior Interface
  */
 #include "behavior_interface/behavior_base.h"
+#include "behavior_interface/memory_resource.h"
 
 /*******************************************************************************
  * STD
@@ -63,6 +64,12 @@ namespace helm {
          */
         behavior_component_t m_opts;
 
+        /**
+         * @brief Arena of the behavior
+         * Declared before #m_behavior so that it outlives the behavior.
+         */
+        ArenaResource::Ptr m_arena = std::make_shared<ArenaResource>();
+
         /**
          * @brief Behavior defined by #m_class_name
          */
@@ -73,6 +80,37 @@ namespace helm {
          */
         std::shared_ptr<pluginlib::ClassLoader<BehaviorBase>> m_class_loader;
 
+        /**
+         * @brief Last set point requested from the behavior
+         * Helm reuses it on the iterations that the behavior is decimated.
+         */
+        mvp_msgs::ControlProcess m_set_point;
+
+        /**
+         * @brief Result of the last set point request
+         */
+        bool m_set_point_result = false;
+
+        /**
+         * @brief Duration of the last set point request in seconds
+         */
+        double m_duration = 0;
+
+        /**
+         * @brief Number of consecutive set point requests that returned false
+         */
+        uint32_t m_failures = 0;
+
+        ros::CallbackQueueInterface* m_callback_queue = nullptr;
+
+        /**
+         * @brief Sets the DOFs and reads the parameters of a behavior that
+         *        has a descriptor
+         *
+         * @throws HelmException if a parameter or a topic is invalid
+         */
+        void f_apply_descriptor(const behavior_descriptor_t& descriptor);
+
 
     public:
 
@@ -85,11 +123,52 @@ namespace helm {
 
         ~BehaviorContainer();
 
+        /**
+         * @brief Sets the queue that serves the callbacks of the behavior,
+         *        must be called before #BehaviorContainer::initialize
+         *
+         * @param queue null for the global callback queue
+         */
+        void set_callback_queue(ros::CallbackQueueInterface* queue) {
+            m_callback_queue = queue;
+        }
+
         void initialize();
 
         auto get_behavior() -> decltype(m_behavior) { return m_behavior; }
 
-        auto get_opts() -> decltype(m_opts) { return m_opts; }
+        auto get_opts() const -> const decltype(m_opts)& { return m_opts; }
+
+        /**
+         * @brief Request a set point from the behavior and keep a copy of it
+         *
+         * @param set_point
+         * @return result of #BehaviorBase::request_set_point
+         */
+        bool request_set_point(mvp_msgs::ControlProcess* set_point);
+
+        /**
+         * @brief Get the last set point without running the behavior
+         *
+         * @param set_point
+         * @return result of the last #BehaviorBase::request_set_point
+         */
+        bool get_last_set_point(mvp_msgs::ControlProcess* set_point);
+
+        auto get_last_result() -> decltype(m_set_point_result) {
+            return m_set_point_result;
+        }
+
+        auto get_duration() -> decltype(m_duration) { return m_duration; }
+
+        auto get_failures() -> decltype(m_failures) { return m_failures; }
+
+        /**
+         * @brief Allocation counters of the arena of the behavior
+         */
+        memory_stats_t get_memory_stats() const {
+            return m_arena->get_stats();
+        }
 
     };
 
@@ -26,6 +26,7 @@
 
 #include "vector"
 #include "string"
+#include "map"
 
 #define CONST_STRING static constexpr const char *
 
@@ -37,6 +38,56 @@ namespace helm {
 
     static constexpr double DEFAULT_HELM_FREQ = 50;
 
+    CONST_STRING DEFAULT_SHADOW_NAMESPACE = "shadow";
+
+    static constexpr double DEFAULT_TIME_BUDGET = 0.5;
+
+    static constexpr int DEFAULT_WORKER_THREADS = 1;
+
+    static constexpr int DEFAULT_WORKER_QUEUE = 64;
+
+    static constexpr double DEFAULT_OVERLOAD_THRESHOLD = 0.9;
+
+    static constexpr int DEFAULT_OVERLOAD_TRIGGER_COUNT = 5;
+
+    static constexpr double DEFAULT_OVERLOAD_RECOVER_THRESHOLD = 0.5;
+
+    static constexpr int DEFAULT_OVERLOAD_RECOVER_COUNT = 50;
+
+    static constexpr int DEFAULT_OVERLOAD_DECIMATION = 4;
+
+    CONST_STRING DEFAULT_ENERGY_TOPIC = "battery/energy";
+
+    static constexpr double DEFAULT_ENERGY_HOTEL_POWER = 20.0;
+
+    static constexpr double DEFAULT_ENERGY_PROPULSION_COEFFICIENT = 40.0;
+
+    static constexpr double DEFAULT_ENERGY_CORRECTION_TIME_CONSTANT = 600.0;
+
+    static constexpr double DEFAULT_ALIGNMENT_MARGIN = 0.002;
+
+    static constexpr double DEFAULT_ALIGNMENT_PHASE_GAIN = 0.2;
+
+    static constexpr double DEFAULT_ALIGNMENT_PERIOD_GAIN = 0.02;
+
+    CONST_STRING DEFAULT_STATUS_PAGE_PREFIX = "/mvp_helm";
+
+    static constexpr double DEFAULT_FAILSAFE_MAX_AGE = 1.0;
+
+    static constexpr int DEFAULT_STANDBY_MISSED_HEARTBEATS = 3;
+
+    //! @brief Jiffy of the timing wheel in seconds
+    static constexpr double DEFAULT_TIMER_RESOLUTION = 0.01;
+
+    /**
+     * @brief Names of the degrees of freedom in the configuration files,
+     *        indexed as mvp_msgs::ControlMode::DOF_*
+     */
+    static constexpr const char* DOF_NAMES[12] = {
+        "x", "y", "z", "roll", "pitch", "yaw",
+        "surge", "sway", "heave", "roll_rate", "pitch_rate", "yaw_rate"
+    };
+
 
    /****************************************************************************
     * structs and types
@@ -46,6 +97,12 @@ namespace helm {
         std::string name;
         std::string mode;
         std::vector<std::string> transitions;
+        //! @brief Helm frequency while the state is active, 0 for the default
+        double frequency;
+        //! @brief Seconds after entering the state that #timeout_to is
+        //!        requested, 0 to disable
+        double timeout;
+        std::string timeout_to;
     };
 
     struct behavior_sm_state_t{
@@ -58,20 +115,152 @@ namespace helm {
         std::string plugin;
         std::map<std::string, int> states;
         std::string params;
+        bool critical;
+    };
+
+    struct overload_configuration_t{
+        bool enabled;
+        double threshold;
+        int trigger_count;
+        double recover_threshold;
+        int recover_count;
+        int decimation;
+    };
+
+    struct shadow_configuration_t{
+        bool enabled;
+        std::string ns;
+        int cpu;
+    };
+
+    struct energy_configuration_t{
+        bool enabled;
+        //! @brief Topic of the measured remaining energy, in watt hours
+        std::string topic;
+        //! @brief Energy before any measurement arrives, in watt hours
+        double capacity;
+        //! @brief Power drawn at rest, in watts
+        double hotel_power;
+        //! @brief Propulsion power per cubed speed, in W/(m/s)^3
+        double propulsion_coefficient;
+        //! @brief Energy that must be left at the end, in watt hours
+        double reserve;
+        //! @brief Time constant of the model correction, in seconds
+        double correction_time_constant;
+        //! @brief State to be requested when the margin goes negative
+        std::string state;
+    };
+
+    struct alignment_configuration_t{
+        bool enabled;
+        //! @brief Time between the expected process value and the tick, in
+        //!        seconds
+        double margin;
+        //! @brief Fraction of the phase error corrected at each sample
+        double phase_gain;
+        //! @brief Fraction of the phase error added to the period estimate
+        double period_gain;
+    };
+
+    struct status_page_configuration_t{
+        bool enabled;
+        //! @brief Shared memory object, derived from the node name if empty
+        std::string name;
+    };
+
+    struct failsafe_configuration_t{
+        bool enabled;
+        //! @brief State that is entered without checking the transitions
+        std::string state;
+        //! @brief Age of the process values that triggers the failsafe state,
+        //!        in seconds, 0 to disable
+        double max_age;
+        //! @brief Set point published on entering the failsafe state, by DOF
+        //!        name. The DOFs that are not given are zero.
+        std::map<std::string, double> set_point;
+    };
+
+    struct standby_configuration_t{
+        bool enabled;
+        //! @brief Status page of the primary helm
+        std::string primary;
+        //! @brief Iterations of the primary that can be missed before the
+        //!        standby takes over
+        int missed_heartbeats;
     };
 
     struct helm_configuration_t{
         double frequency;
+        overload_configuration_t overload;
+        shadow_configuration_t shadow;
+        energy_configuration_t energy;
+        alignment_configuration_t alignment;
+        status_page_configuration_t status_page;
+        failsafe_configuration_t failsafe;
+        standby_configuration_t standby;
+        double time_budget;
+        int worker_threads;
     };
 
     CONST_STRING CONF_HELM = "helm_configuration";
     CONST_STRING CONF_HELM_FREQ = "frequency";
+    CONST_STRING CONF_HELM_TIME_BUDGET = "time_budget";
+    CONST_STRING CONF_HELM_WORKER_THREADS = "worker_threads";
+
+    CONST_STRING CONF_HELM_SHADOW = "shadow";
+    CONST_STRING CONF_HELM_SHADOW_ENABLED = "enabled";
+    CONST_STRING CONF_HELM_SHADOW_NAMESPACE = "namespace";
+    CONST_STRING CONF_HELM_SHADOW_CPU = "cpu";
+
+    CONST_STRING CONF_HELM_OVERLOAD = "overload";
+    CONST_STRING CONF_HELM_OVERLOAD_ENABLED = "enabled";
+    CONST_STRING CONF_HELM_OVERLOAD_THRESHOLD = "threshold";
+    CONST_STRING CONF_HELM_OVERLOAD_TRIGGER_COUNT = "trigger_count";
+    CONST_STRING CONF_HELM_OVERLOAD_RECOVER_THRESHOLD = "recover_threshold";
+    CONST_STRING CONF_HELM_OVERLOAD_RECOVER_COUNT = "recover_count";
+    CONST_STRING CONF_HELM_OVERLOAD_DECIMATION = "decimation";
+
+    CONST_STRING CONF_HELM_ENERGY = "energy";
+    CONST_STRING CONF_HELM_ENERGY_ENABLED = "enabled";
+    CONST_STRING CONF_HELM_ENERGY_TOPIC = "topic";
+    CONST_STRING CONF_HELM_ENERGY_CAPACITY = "capacity";
+    CONST_STRING CONF_HELM_ENERGY_HOTEL_POWER = "hotel_power";
+    CONST_STRING CONF_HELM_ENERGY_PROPULSION_COEFFICIENT =
+        "propulsion_coefficient";
+    CONST_STRING CONF_HELM_ENERGY_RESERVE = "reserve";
+    CONST_STRING CONF_HELM_ENERGY_CORRECTION_TIME_CONSTANT =
+        "correction_time_constant";
+    CONST_STRING CONF_HELM_ENERGY_STATE = "state";
+
+    CONST_STRING CONF_HELM_ALIGNMENT = "alignment";
+    CONST_STRING CONF_HELM_ALIGNMENT_ENABLED = "enabled";
+    CONST_STRING CONF_HELM_ALIGNMENT_MARGIN = "margin";
+    CONST_STRING CONF_HELM_ALIGNMENT_PHASE_GAIN = "phase_gain";
+    CONST_STRING CONF_HELM_ALIGNMENT_PERIOD_GAIN = "period_gain";
+
+    CONST_STRING CONF_HELM_STATUS_PAGE = "status_page";
+    CONST_STRING CONF_HELM_STATUS_PAGE_ENABLED = "enabled";
+    CONST_STRING CONF_HELM_STATUS_PAGE_NAME = "name";
+
+    CONST_STRING CONF_HELM_FAILSAFE = "failsafe";
+    CONST_STRING CONF_HELM_FAILSAFE_ENABLED = "enabled";
+    CONST_STRING CONF_HELM_FAILSAFE_STATE = "state";
+    CONST_STRING CONF_HELM_FAILSAFE_MAX_AGE = "max_age";
+    CONST_STRING CONF_HELM_FAILSAFE_SET_POINT = "set_point";
+
+    CONST_STRING CONF_HELM_STANDBY = "standby";
+    CONST_STRING CONF_HELM_STANDBY_ENABLED = "enabled";
+    CONST_STRING CONF_HELM_STANDBY_PRIMARY = "primary";
+    CONST_STRING CONF_HELM_STANDBY_MISSED_HEARTBEATS = "missed_heartbeats";
 
     CONST_STRING CONF_FSM = "finite_state_machine";
     CONST_STRING CONF_FSM_NAME = "name";
     CONST_STRING CONF_FSM_MODE = "mode";
     CONST_STRING CONF_FSM_INITIAL = "initial";
     CONST_STRING CONF_FSM_TRANSITIONS = "transitions";
+    CONST_STRING CONF_FSM_FREQUENCY = "frequency";
+    CONST_STRING CONF_FSM_TIMEOUT = "timeout";
+    CONST_STRING CONF_FSM_TIMEOUT_TO = "timeout_to";
 
     CONST_STRING CONF_BHV = "behaviors";
     CONST_STRING CONF_BHV_NAME = "name";
@@ -79,6 +268,7 @@ namespace helm {
     CONST_STRING CONF_BHV_STATES = "states";
     CONST_STRING CONF_BHV_STATES_NAME = "name";
     CONST_STRING CONF_BHV_STATES_PRIORITY = "priority";
+    CONST_STRING CONF_BHV_CRITICAL = "critical";
 
 
 }
\ No newline at end of file
@@ -0,0 +1,175 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#include "energy.h"
+
+#include "algorithm"
+#include "cmath"
+
+using namespace helm;
+
+EnergyEstimator::EnergyEstimator() {
+
+    m_conf.enabled = false;
+
+    m_speed = 0;
+
+    m_target = 0;
+
+    m_correction = 1.0;
+
+    m_energy_remaining = 0;
+
+    m_measured = false;
+
+    m_modeled_since_measurement = 0;
+
+    m_elapsed_since_measurement = 0;
+
+    m_status = status_t();
+
+}
+
+void EnergyEstimator::configure(const energy_configuration_t& conf) {
+
+    m_conf = conf;
+
+    m_energy_remaining = conf.capacity;
+
+}
+
+double EnergyEstimator::f_power(double speed) const {
+
+    return m_conf.hotel_power +
+        m_conf.propulsion_coefficient * std::pow(std::fabs(speed), 3);
+
+}
+
+void EnergyEstimator::set_path(const std::vector<double>& x,
+                               const std::vector<double>& y,
+                               double speed) {
+
+    m_x = x;
+    m_y = y;
+    m_speed = speed;
+    m_target = 0;
+
+    auto n = std::min(m_x.size(), m_y.size());
+
+    m_arc.assign(n, 0.0);
+    m_time.assign(n, 0.0);
+    m_energy.assign(n, 0.0);
+
+    // Watt hours per meter at the planned speed
+    auto per_meter = speed > 0 ? f_power(speed) / speed / 3600.0 : 0.0;
+
+    for(size_t i = 1 ; i < n ; i++) {
+        auto l = std::hypot(m_x[i] - m_x[i - 1], m_y[i] - m_y[i - 1]);
+        m_arc[i] = m_arc[i - 1] + l;
+        m_time[i] = m_time[i - 1] + (speed > 0 ? l / speed : 0.0);
+        m_energy[i] = m_energy[i - 1] + l * per_meter;
+    }
+
+}
+
+void EnergyEstimator::set_target(size_t index) {
+
+    m_target = index;
+
+}
+
+void EnergyEstimator::set_measured_energy(double energy) {
+
+    /**
+     * Compare the measured drop with the modeled one since the last
+     * measurement. Correction follows the ratio with a time constant.
+     */
+    if(m_measured && m_modeled_since_measurement > 1e-6) {
+        auto drop = m_energy_remaining - energy;
+
+        if(drop >= 0) {
+            auto ratio = drop / m_modeled_since_measurement;
+
+            auto a = m_conf.correction_time_constant > 0 ?
+                std::min(m_elapsed_since_measurement /
+                    m_conf.correction_time_constant, 1.0) : 1.0;
+
+            m_correction += a * (ratio - m_correction);
+        }
+    }
+
+    m_energy_remaining = energy;
+
+    m_measured = true;
+
+    m_modeled_since_measurement = 0;
+
+    m_elapsed_since_measurement = 0;
+
+}
+
+void EnergyEstimator::update(double x, double y, double speed, double dt) {
+
+    auto modeled = f_power(speed) * dt / 3600.0;
+
+    m_modeled_since_measurement += modeled;
+
+    m_elapsed_since_measurement += dt;
+
+    if(!m_measured) {
+        // Dead reckon the battery until a measurement arrives
+        m_energy_remaining -= modeled * m_correction;
+    }
+
+    auto n = m_arc.size();
+
+    m_status.energy_remaining = m_energy_remaining;
+    m_status.correction = m_correction;
+
+    if(n == 0 || m_target >= n) {
+        m_status.valid = false;
+        m_status.remaining_distance = 0;
+        m_status.eta = 0;
+        m_status.energy_required = 0;
+        m_status.margin = m_energy_remaining - m_conf.reserve;
+        return;
+    }
+
+    auto to_target = std::hypot(m_x[m_target] - x, m_y[m_target] - y);
+
+    auto per_meter = m_speed > 0 ? f_power(m_speed) / m_speed / 3600.0 : 0.0;
+
+    m_status.valid = true;
+
+    m_status.remaining_distance = to_target + m_arc[n - 1] - m_arc[m_target];
+
+    m_status.eta = (m_speed > 0 ? to_target / m_speed : 0.0) +
+        m_time[n - 1] - m_time[m_target];
+
+    m_status.energy_required = m_correction *
+        (to_target * per_meter + m_energy[n - 1] - m_energy[m_target]);
+
+    m_status.margin =
+        m_energy_remaining - m_status.energy_required - m_conf.reserve;
+
+}
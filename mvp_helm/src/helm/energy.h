@@ -0,0 +1,163 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#pragma once
+
+/*******************************************************************************
+ * STD
+ */
+#include "memory"
+#include "vector"
+
+/*******************************************************************************
+ * Helm
+ */
+#include "dictionary.h"
+
+namespace helm {
+
+    /**
+     * @brief Estimates the energy needed to finish the active path
+     *
+     * When a path is reported, cumulative arc length, travel time and
+     * expected energy up to each waypoint are computed once into prefix
+     * tables. Afterwards the remaining distance, time and energy are a
+     * distance to the next waypoint plus a lookup, no matter how long the
+     * path is. Path is never scanned again until a new one is reported.
+     *
+     * Power is modeled as
+     *
+     *     hotel_power + propulsion_coefficient * speed^3
+     *
+     * and corrected with the ratio of the measured consumption to the modeled
+     * one.
+     */
+    class EnergyEstimator {
+    public:
+
+        struct status_t {
+            //! @brief True if there is a path to estimate
+            bool valid;
+            //! @brief Meters left on the path
+            double remaining_distance;
+            //! @brief Seconds left on the path
+            double eta;
+            //! @brief Watt hours needed to finish the path
+            double energy_required;
+            //! @brief Watt hours left in the battery
+            double energy_remaining;
+            //! @brief Watt hours left after the path and the reserve
+            double margin;
+            //! @brief Ratio of the measured consumption to the model
+            double correction;
+        };
+
+    private:
+
+        energy_configuration_t m_conf;
+
+        std::vector<double> m_x;
+
+        std::vector<double> m_y;
+
+        //! @brief Arc length from the first waypoint to each waypoint
+        std::vector<double> m_arc;
+
+        //! @brief Travel time from the first waypoint to each waypoint
+        std::vector<double> m_time;
+
+        //! @brief Modeled energy from the first waypoint to each waypoint
+        std::vector<double> m_energy;
+
+        //! @brief Planned speed of the path
+        double m_speed;
+
+        //! @brief Index of the waypoint that the vehicle is heading to
+        size_t m_target;
+
+        double m_correction;
+
+        //! @brief Energy left, measured or dead reckoned with the model
+        double m_energy_remaining;
+
+        bool m_measured;
+
+        //! @brief Modeled consumption since the last measurement
+        double m_modeled_since_measurement;
+
+        //! @brief Seconds since the last measurement
+        double m_elapsed_since_measurement;
+
+        status_t m_status;
+
+        /**
+         * @brief Modeled power at the given speed in watts
+         */
+        double f_power(double speed) const;
+
+    public:
+
+        typedef std::shared_ptr<EnergyEstimator> Ptr;
+
+        EnergyEstimator();
+
+        void configure(const energy_configuration_t& conf);
+
+        /**
+         * @brief Set the path and build the prefix tables. O(n).
+         *
+         * @param x Waypoints
+         * @param y Waypoints
+         * @param speed Planned speed in m/s
+         */
+        void set_path(const std::vector<double>& x,
+                      const std::vector<double>& y,
+                      double speed);
+
+        /**
+         * @brief Set the waypoint that the vehicle is heading to. O(1).
+         */
+        void set_target(size_t index);
+
+        /**
+         * @brief Feed a measurement of the remaining energy
+         *
+         * @param energy Remaining energy in watt hours
+         */
+        void set_measured_energy(double energy);
+
+        /**
+         * @brief Update the estimate. O(1).
+         *
+         * @param x Vehicle position
+         * @param y Vehicle position
+         * @param speed Vehicle speed in m/s
+         * @param dt Time since the last update in seconds
+         */
+        void update(double x, double y, double speed, double dt);
+
+        const status_t& get_status() const { return m_status; }
+
+    };
+
+}
@@ -23,6 +23,7 @@
 
 
 #include "exception"
+#include "stdexcept"
 
 #include <utility>
 #include "string"
@@ -0,0 +1,117 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#include "governor.h"
+
+#include "algorithm"
+
+using namespace helm;
+
+OverloadGovernor::OverloadGovernor() {
+
+    m_conf.enabled = false;
+
+    m_period = 1.0 / DEFAULT_HELM_FREQ;
+
+    m_level = 0;
+
+    m_max_level = 1;
+
+    m_overrun_count = 0;
+
+    m_headroom_count = 0;
+
+}
+
+void OverloadGovernor::configure(const overload_configuration_t &conf,
+                                 double period) {
+
+    m_conf = conf;
+
+    m_conf.trigger_count = std::max(m_conf.trigger_count, 1);
+
+    m_conf.recover_count = std::max(m_conf.recover_count, 1);
+
+    m_conf.decimation = std::max(m_conf.decimation, 1);
+
+    m_period = period;
+
+    m_level = 0;
+
+    m_overrun_count = 0;
+
+    m_headroom_count = 0;
+}
+
+void OverloadGovernor::set_period(double period) {
+
+    m_period = period;
+
+    m_overrun_count = 0;
+
+    m_headroom_count = 0;
+
+}
+
+void OverloadGovernor::set_max_level(int level) {
+
+    m_max_level = std::max(level, 0);
+
+    m_level = std::min(m_level, m_max_level);
+
+}
+
+bool OverloadGovernor::update(double duration) {
+
+    if(!m_conf.enabled) {
+        return false;
+    }
+
+    double load = duration / m_period;
+
+    if(load > m_conf.threshold) {
+        m_overrun_count++;
+        m_headroom_count = 0;
+    } else if (load < m_conf.recover_threshold) {
+        m_headroom_count++;
+        m_overrun_count = 0;
+    } else {
+        m_overrun_count = 0;
+        m_headroom_count = 0;
+    }
+
+    if(m_overrun_count >= m_conf.trigger_count && m_level < m_max_level) {
+        m_overrun_count = 0;
+        m_level++;
+        return true;
+    }
+
+    if(m_headroom_count >= m_conf.recover_count && m_level > 0) {
+        m_headroom_count = 0;
+        m_level--;
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,130 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#pragma once
+
+/*******************************************************************************
+ * STD
+ */
+#include "memory"
+
+/*******************************************************************************
+ * Helm
+ */
+#include "dictionary.h"
+
+namespace helm {
+
+    /**
+     * @brief Watches the iteration duration of the helm and decides how much
+     *        work should be shed.
+     *
+     * Governor doesn't know anything about behaviors. It only produces a
+     * shedding level. Level 0 is the nominal operation. Level 1 drops
+     * visualization and logging work. Each level above that decimates one
+     * more non-critical behavior, starting from the lowest priority.
+     *
+     * A level is escalated after #overload_configuration_t::trigger_count
+     * consecutive iterations exceed #overload_configuration_t::threshold of
+     * the period. It is restored one step at a time after
+     * #overload_configuration_t::recover_count consecutive iterations stay
+     * below #overload_configuration_t::recover_threshold of the period.
+     */
+    class OverloadGovernor {
+    private:
+
+        overload_configuration_t m_conf;
+
+        /**
+         * @brief Helm period in seconds
+         */
+        double m_period;
+
+        int m_level;
+
+        int m_max_level;
+
+        int m_overrun_count;
+
+        int m_headroom_count;
+
+    public:
+
+        typedef std::shared_ptr<OverloadGovernor> Ptr;
+
+        OverloadGovernor();
+
+        /**
+         * @brief Configure the governor
+         *
+         * @param conf Overload configuration
+         * @param period Helm period in seconds
+         */
+        void configure(const overload_configuration_t& conf, double period);
+
+        /**
+         * @brief Change the helm period
+         *
+         * Overrun and headroom counts are reset since they were measured
+         * against the old period. The shedding level is kept.
+         *
+         * @param period Helm period in seconds
+         */
+        void set_period(double period);
+
+        /**
+         * @brief Set the highest level governor can escalate to
+         *
+         * @param level
+         */
+        void set_max_level(int level);
+
+        /**
+         * @brief Feed the duration of the last iteration
+         *
+         * @param duration Duration of the iteration in seconds
+         * @return true if the shedding level changed
+         */
+        bool update(double duration);
+
+        auto get_level() -> decltype(m_level) { return m_level; }
+
+        /**
+         * @brief Visualization and logging is allowed only at nominal level
+         */
+        bool visualization_enabled() { return m_level < 1; }
+
+        /**
+         * @brief Number of behaviors that should be decimated
+         */
+        int get_decimated_count() { return m_level > 1 ? m_level - 1 : 0; }
+
+        /**
+         * @brief A decimated behavior runs once in every this many iterations
+         */
+        int get_decimation() { return m_conf.decimation; }
+
+    };
+
+}
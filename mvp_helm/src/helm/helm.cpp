@@ -24,7 +24,13 @@
 /*******************************************************************************
  * STD
  */
+#include "algorithm"
+#include "cerrno"
+#include "chrono"
+#include "cmath"
+#include "cstring"
 #include "functional"
+#include "sstream"
 #include "utility"
 
 /*******************************************************************************
@@ -42,6 +48,7 @@
 #include "dictionary.h"
 #include "utils.h"
 #include "exception.h"
+#include "probes.h"
 
 /*******************************************************************************
  * namespaces
@@ -59,6 +66,32 @@ using namespace helm;
 
 Helm::Helm() : HelmObj() {
 
+    m_tick = 0;
+
+    m_dof_winners.fill(-1);
+
+    m_dof_requests.fill(0);
+
+    m_set_point.fill(0);
+
+    m_path_target = -1;
+
+    m_energy_triggered = false;
+
+    m_tick_locked = false;
+
+    m_failsafe_count = 0;
+
+    m_process_arrival = 0;
+
+    m_process_stale = false;
+
+    m_state_timer = 0;
+
+    m_state_entries = 0;
+
+    m_standby_mode = false;
+
 };
 
 Helm::~Helm() {
@@ -73,6 +106,18 @@ Helm::~Helm() {
 
     m_change_state_srv.shutdown();
 
+    m_set_frequency_srv.shutdown();
+
+    m_sub_energy.shutdown();
+
+    m_pub_log_change_state.shutdown();
+
+    m_pub_log_set_frequency.shutdown();
+
+    m_pub_log_controller_modes.shutdown();
+
+    m_pub_energy.shutdown();
+
 }
 
 void Helm::initialize() {
@@ -85,6 +130,14 @@ void Helm::initialize() {
 
     m_state_machine.reset(new StateMachine());
 
+    m_governor.reset(new OverloadGovernor());
+
+    m_energy.reset(new EnergyEstimator());
+
+    m_tick_scheduler.reset(new TickScheduler());
+
+    m_timing_wheel.reset(new TimingWheel(DEFAULT_TIMER_RESOLUTION));
+
     /***************************************************************************
      * Parse mission file
      */
@@ -119,6 +172,32 @@ void Helm::initialize() {
         100
     );
 
+    if(m_energy_conf.enabled) {
+        m_sub_energy = m_nh->subscribe(
+            m_energy_conf.topic,
+            10,
+            &Helm::f_cb_energy,
+            this
+        );
+
+        m_pub_energy = m_pnh->advertise<mvp_helm::EnergyStatus>("energy", 10);
+    }
+
+    m_pub_log_change_state = m_pnh->advertise<mvp_msgs::ChangeStateRequest>(
+        "log/change_state", 10);
+
+    m_pub_log_set_frequency =
+        m_pnh->advertise<mvp_helm::SetHelmFrequencyRequest>(
+            "log/set_frequency", 10);
+
+    m_pub_log_controller_modes = m_pnh->advertise<mvp_msgs::ControlModes>(
+        "log/controller_modes", 1, true);
+
+    m_pub_log_tick = m_pnh->advertise<mvp_helm::HelmTick>("log/tick", 100);
+
+    m_pub_log_path = m_pnh->advertise<mvp_helm::HelmPath>(
+        "log/path", 1, true);
+
     /***************************************************************************
      * Initialize ros services
      */
@@ -140,22 +219,98 @@ void Helm::initialize() {
         this
     );
 
+    m_set_frequency_srv = m_pnh->advertiseService(
+        "set_frequency",
+        &Helm::f_cb_set_frequency,
+        this
+    );
+
     /***************************************************************************
      * Initialize state machine
      */
     m_state_machine->initialize();
 
+    f_schedule_state_timeout(m_state_machine->get_active_state().name);
+
     /***************************************************************************
      * Initialize behavior plugins
      */
     f_initialize_behaviors();
 
+    /***************************************************************************
+     * Initialize status page
+     */
+    if(m_status_page_conf.enabled) {
+        auto name = m_status_page_conf.name;
+        if(name.empty()) {
+            name = ros::this_node::getName();
+            std::replace(name.begin(), name.end(), '/', '_');
+            name = DEFAULT_STATUS_PAGE_PREFIX + name;
+        }
+
+        try {
+            m_status_page.reset(new StatusPage(name));
+
+            ROS_INFO_STREAM("Helm status is written to " << name);
+        } catch(HelmException& e) {
+            ROS_ERROR_STREAM("Status page is disabled, " << e.what());
+        }
+
+        if(m_behavior_containers.size() > HELM_STATUS_MAX_BEHAVIORS) {
+            ROS_WARN_STREAM("Status page reports the first " <<
+                HELM_STATUS_MAX_BEHAVIORS << " behaviors only");
+        }
+    }
+
+    /***************************************************************************
+     * Initialize standby
+     */
+    if(m_standby_conf.enabled) {
+        if(m_standby_conf.primary.empty() ||
+            (m_status_page &&
+                m_status_page->get_name() == m_standby_conf.primary)) {
+            throw HelmException("Standby needs the status page of another"
+                " helm as its primary!");
+        }
+
+        m_standby.reset(new Standby(m_standby_conf));
+
+        m_standby_mode = true;
+
+        m_mirrored_checkpoints.resize(m_behavior_containers.size());
+
+        ROS_INFO_STREAM("Helm is a standby of " << m_standby_conf.primary);
+    }
+
+    /***************************************************************************
+     * Initialize shadow mission
+     */
+    if(m_shadow_conf.enabled) {
+        m_shadow.reset(new Shadow(m_shadow_conf.ns, m_shadow_conf.cpu));
+
+        m_shadow->initialize(m_helm_freq);
+    }
+
 
     /***************************************************************************
      * setup connection with low level controller
      */
     f_get_controller_modes();
 
+    m_pub_log_controller_modes.publish(m_controller_modes);
+
+    f_check_arbitration();
+
+    if(m_failsafe_conf.enabled) {
+        f_initialize_failsafe();
+    }
+
+    if(m_shadow) {
+        m_shadow->set_controller_modes(m_controller_modes);
+
+        m_shadow->start();
+    }
+
 }
 
 void Helm::run() {
@@ -173,16 +328,73 @@ void Helm::run() {
 
 void Helm::f_initialize_behaviors() {
 
+    int non_critical = 0;
+
     for(const auto& i : m_behavior_containers) {
 
+        if(!i->get_opts().critical) {
+            non_critical++;
+        }
+
         i->initialize();
 
         i->get_behavior()->f_change_state =
             std::bind(&Helm::f_change_state, this, std::placeholders::_1);
 
+        i->get_behavior()->f_submit_work =
+            std::bind(&WorkerPool::submit, m_worker_pool.get(),
+                std::placeholders::_1);
+
+        i->get_behavior()->f_schedule_timer =
+            [this](double delay, std::function<void()> callback,
+                   double period) {
+                return m_timing_wheel->schedule(ros::Time::now().toSec(),
+                    delay, std::move(callback), period);
+            };
+
+        i->get_behavior()->f_cancel_timer =
+            std::bind(&TimingWheel::cancel, m_timing_wheel.get(),
+                std::placeholders::_1);
+
+        i->get_behavior()->f_send_path =
+            [this](const std::string& behavior, const std::string& frame_id,
+                   const std::vector<double>& x,
+                   const std::vector<double>& y) {
+                for(const auto& c : m_behavior_containers) {
+                    if(c->get_opts().name == behavior) {
+                        return c->get_behavior()->path_received(
+                            frame_id, x, y);
+                    }
+                }
+                return false;
+            };
+
         i->get_behavior()->m_helm_frequency = m_helm_freq;
+
+        /**
+         * Paths are logged for the offline analysis even if the energy
+         * estimator is disabled.
+         */
+        auto name = i->get_opts().name;
+
+        i->get_behavior()->f_report_path =
+            [this, name](const std::vector<double>& x,
+                         const std::vector<double>& y, double speed) {
+                f_report_path(name, x, y, speed);
+            };
+
+        i->get_behavior()->f_report_path_target =
+            [this, name](size_t index) {
+                f_report_path_target(name, index);
+            };
     }
 
+    /**
+     * First level drops visualization, every other level decimates one more
+     * non-critical behavior.
+     */
+    m_governor->set_max_level(1 + non_critical);
+
 }
 
 void Helm::f_get_controller_modes() {
@@ -208,6 +420,65 @@ void Helm::f_get_controller_modes() {
 
 }
 
+void Helm::f_check_arbitration() {
+
+    for(const auto& state : m_state_machine->get_states()) {
+
+        auto mode = std::find_if(
+            m_controller_modes.modes.begin(),
+            m_controller_modes.modes.end(),
+            [&state](const mvp_msgs::ControlMode& m){
+                return m.name == state.mode;
+            }
+        );
+
+        if(mode == m_controller_modes.modes.end()) {
+            ROS_WARN_STREAM("State '" << state.name << "' has mode '" <<
+                state.mode << "' that the controller doesn't provide");
+            continue;
+        }
+
+        /**
+         * Behavior that wins each DOF at each priority, the first one in the
+         * configuration wins a tie
+         */
+        std::array<std::map<int, std::string>, 12> table;
+
+        for(const auto& i : m_behavior_containers) {
+            const auto& opts = i->get_opts();
+
+            auto priority = opts.states.find(state.name);
+            if(priority == opts.states.end()) {
+                continue;
+            }
+
+            for(const auto& dof : i->get_behavior()->get_dofs()) {
+                if(dof < 0 || dof >= static_cast<int>(table.size())) {
+                    continue;
+                }
+
+                if(std::find(mode->dofs.begin(), mode->dofs.end(), dof) ==
+                    mode->dofs.end()) {
+                    ROS_WARN_STREAM("Behavior (" << opts.name << ") requests "
+                        << DOF_NAMES[dof] << " in state '" << state.name <<
+                        "', mode '" << state.mode << "' doesn't control it");
+                    continue;
+                }
+
+                auto winner = table[dof].emplace(priority->second, opts.name);
+                if(!winner.second) {
+                    ROS_WARN_STREAM("Behaviors (" << winner.first->second <<
+                        ") and (" << opts.name << ") request " <<
+                        DOF_NAMES[dof] << " with priority " <<
+                        priority->second << " in state '" << state.name <<
+                        "', (" << winner.first->second << ") wins");
+                }
+            }
+        }
+    }
+
+}
+
 void Helm::f_generate_behaviors(const behavior_component_t& component)
 {
     /**
@@ -234,17 +505,77 @@ void Helm::f_configure_helm(helm_configuration_t conf) {
 
     m_helm_freq = conf.frequency;
 
+    m_base_freq = conf.frequency;
+
+    m_governor->configure(conf.overload, 1.0 / m_helm_freq);
+
+    m_time_budget = conf.time_budget;
+
+    m_shadow_conf = conf.shadow;
+
+    m_energy_conf = conf.energy;
+
+    m_energy->configure(conf.energy);
+
+    m_alignment_conf = conf.alignment;
+
+    m_tick_scheduler->configure(conf.alignment, 1.0 / m_helm_freq);
+
+    m_status_page_conf = conf.status_page;
+
+    m_failsafe_conf = conf.failsafe;
+
+    m_standby_conf = conf.standby;
+
+    m_worker_pool.reset(new WorkerPool(
+        static_cast<size_t>(std::max(conf.worker_threads, 0)),
+        DEFAULT_WORKER_QUEUE
+    ));
+
 }
 
 void Helm::f_cb_controller_process(
     const mvp_msgs::ControlProcess::ConstPtr& msg) {
+    HELM_PROBE2(process_value_ingest,
+        msg->header.stamp.sec, msg->header.stamp.nsec);
+
     m_controller_process_values = msg;
+
+    /**
+     * Arrival time is used rather than the stamp, it is when the process
+     * value becomes available to the behaviors.
+     */
+    auto now = ros::Time::now().toSec();
+
+    m_process_arrival = now;
+
+    if(m_alignment_conf.enabled) {
+        m_tick_scheduler->sample(now);
+    }
 }
 
 void Helm::f_iterate() {
     if(m_controller_process_values == nullptr) {
         return;
     }
+
+    /**
+     * Behaviors can't be trusted with stale process values, the safe set
+     * point is repeated until they arrive again.
+     */
+    if(f_check_process_age()) {
+        std::lock_guard<std::mutex> lock(m_publish_mutex);
+
+        m_set_point = utils::control_process_to_array(m_failsafe_set_point);
+        m_set_point_stamp = f_publish_failsafe();
+        m_dof_winners.fill(-1);
+        m_dof_requests.fill(0);
+
+        return;
+    }
+
+    auto failsafe_count = m_failsafe_count.load();
+
     /**
      * Acquire state information from finite state machine. Get state name and
      * respective mode to that state.
@@ -275,13 +606,32 @@ void Helm::f_iterate() {
         }
     );
 
+    /**
+     * Behaviors share a fraction of the helm period. Whatever a behavior
+     * doesn't use is passed to the ones after it.
+     */
+    auto tick_deadline = std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(m_time_budget / m_helm_freq));
+
     /**
      * Create holders for priorities and control inputs.
      */
     std::array<double, 12> dof_ctrl{};
     std::array<int, 12> dof_priority{};
+    std::array<int, 12> dof_winners;
+    dof_winners.fill(-1);
+    std::array<uint8_t, 12> dof_requests{};
 
-    for(const auto& i : m_behavior_containers) {
+    /**
+     * Governor may ask for some of the behaviors to run less frequently.
+     */
+    std::vector<bool> decimated(m_behavior_containers.size(), false);
+    f_select_decimated_behaviors(active_state.name, &decimated);
+
+    for(size_t idx = 0 ; idx < m_behavior_containers.size() ; idx++) {
+
+        const auto& i = m_behavior_containers[idx];
 
         /**
          * Inform the behavior about the active DOFs
@@ -294,6 +644,18 @@ void Helm::f_iterate() {
 
         i->get_behavior()->m_process_values = *m_controller_process_values;
 
+        /**
+         * A decimated behavior is called once in every few iterations, it
+         * integrates with its own rate rather than the helm's
+         */
+        auto frequency = decimated[idx] ?
+            m_helm_freq / m_governor->get_decimation() : m_helm_freq;
+        if(i->get_behavior()->m_helm_frequency != frequency) {
+            i->get_behavior()->m_helm_frequency = frequency;
+
+            i->get_behavior()->helm_frequency_changed(frequency);
+        }
+
         /*
          * Check if behavior should be active in active state
          */
@@ -310,7 +672,30 @@ void Helm::f_iterate() {
          * TODO: request set point must be multithreaded with timeout
          */
         mvp_msgs::ControlProcess set_point;
-        if(!i->get_behavior()->request_set_point(&set_point)) {
+
+        bool result;
+        if(decimated[idx] &&
+            (m_tick + idx) % m_governor->get_decimation() != 0) {
+            /**
+             * Decimated behavior keeps its last decision until its next turn
+             */
+            result = i->get_last_set_point(&set_point);
+        } else {
+            auto now = std::chrono::steady_clock::now();
+            i->get_behavior()->m_deadline = now +
+                (tick_deadline - now) /
+                    static_cast<int>(m_behavior_containers.size() - idx);
+
+            HELM_PROBE2(behavior_start,
+                m_tick, i->get_behavior()->m_name.c_str());
+
+            result = i->request_set_point(&set_point);
+
+            HELM_PROBE3(behavior_end,
+                m_tick, i->get_behavior()->m_name.c_str(), result);
+        }
+
+        if(!result) {
             // todo: do something about dysfunctional behavior
             continue;
         }
@@ -329,7 +714,7 @@ void Helm::f_iterate() {
         /**
          * Get the priority of the behavior in given state
          */
-        auto priority = i->get_opts().states[active_state.name];
+        auto priority = i->get_opts().states.at(active_state.name);
 
         /**
          * A behavior might only check for system state and take other actions
@@ -350,17 +735,40 @@ void Helm::f_iterate() {
             utils::control_process_to_array(set_point);
 
         for(const auto& dof : i->get_behavior()->get_dofs()) {
+            dof_requests[dof]++;
+
             /**
              * This is where the magic happens
              */
             if(priority > dof_priority[dof]) {
                 dof_ctrl[dof] = bhv_control_array[dof];
                 dof_priority[dof] = priority;
+                dof_winners[dof] = static_cast<int>(idx);
             }
         }
 
     }
 
+    /**
+     * Report the DOFs that changed hands since the last iteration
+     */
+    for(size_t dof = 0 ; dof < dof_winners.size() ; dof++) {
+        if(dof_winners[dof] == m_dof_winners[dof]) {
+            continue;
+        }
+
+        HELM_PROBE3(winner_change,
+            dof,
+            dof_winners[dof] < 0 ? "" :
+                m_behavior_containers[dof_winners[dof]]->
+                    get_behavior()->m_name.c_str(),
+            dof_priority[dof]
+        );
+    }
+    m_dof_winners = dof_winners;
+
+    m_dof_requests = dof_requests;
+
     /**
      * Push commands to low level controller
      */
@@ -368,24 +776,753 @@ void Helm::f_iterate() {
 
     msg.control_mode = active_state.mode;
     msg.header.stamp = ros::Time::now();
-    m_pub_controller_set_point.publish(msg);
+
+    {
+        std::lock_guard<std::mutex> lock(m_publish_mutex);
+
+        /**
+         * A failsafe transition happened during the iteration, its set point
+         * is already published and this one belongs to the previous state.
+         */
+        if(failsafe_count == m_failsafe_count) {
+            HELM_PROBE2(set_point_publish, m_tick, msg.control_mode.c_str());
+
+            m_pub_controller_set_point.publish(msg);
+
+            m_set_point = dof_ctrl;
+            m_set_point_stamp = msg.header.stamp;
+        }
+    }
+
+    /**
+     * Shadow gets the same snapshot. It never blocks the live iteration.
+     */
+    if(m_shadow) {
+        m_shadow->offer(
+            m_controller_process_values, active_state.name, msg.header.stamp,
+            m_helm_freq);
+    }
+
+    if(m_energy_conf.enabled) {
+        f_update_energy();
+    }
+
+}
+
+void Helm::step() {
+
+    /**
+     * Frequency may be changed by the service or by a state transition.
+     * It is applied between iterations so that behaviors never see it
+     * change in the middle of one.
+     */
+    auto frequency = f_desired_frequency();
+    if(frequency != m_helm_freq) {
+        f_set_frequency(frequency);
+    }
+
+    HELM_PROBE1(tick_start, m_tick);
+
+    auto start = std::chrono::steady_clock::now();
+
+    if(m_status_page && !m_standby_mode) {
+        f_follow_owner();
+    }
+
+    /**
+     * Standby mirrors the primary until it misses its heartbeats, then the
+     * iteration continues and publishes in the same tick. A helm that
+     * another one took over from and that has nothing to follow stays idle.
+     */
+    if(m_standby_mode) {
+        if(m_standby == nullptr || m_standby->update()) {
+            if(m_standby) {
+                f_mirror();
+            }
+
+            std::chrono::duration<double> duration =
+                std::chrono::steady_clock::now() - start;
+
+            HELM_PROBE1(tick_end, m_tick);
+
+            m_tick++;
+
+            if(m_status_page) {
+                f_write_status(duration.count());
+            }
+
+            return;
+        }
+
+        f_take_over();
+    }
+
+    /**
+     * Timers fire at the tick boundary, behaviors see their effects in this
+     * iteration.
+     */
+    try {
+        m_timing_wheel->advance(ros::Time::now().toSec());
+    } catch(const std::exception& e) {
+        ROS_ERROR_STREAM("Timer callback failed: " << e.what());
+    }
+
+    f_iterate();
+
+    std::chrono::duration<double> duration =
+        std::chrono::steady_clock::now() - start;
+
+    HELM_PROBE1(tick_end, m_tick);
+
+    if(m_governor->update(duration.count())) {
+        f_apply_overload_level(duration.count());
+    }
+
+    if(m_pub_log_tick.getNumSubscribers() > 0) {
+        f_log_tick(duration.count());
+    }
+
+    m_tick++;
+
+    if(m_status_page) {
+        f_write_status(duration.count());
+    }
+
+}
+
+void Helm::f_log_tick(double duration) {
+
+    mvp_helm::HelmTick msg;
+
+    msg.header.stamp = ros::Time::now();
+
+    msg.tick = m_tick;
+
+    msg.state = m_state_machine->get_active_state().name;
+
+    for(size_t dof = 0 ; dof < m_dof_winners.size() ; dof++) {
+        if(m_dof_winners[dof] >= 0) {
+            msg.dof_winners[dof] =
+                m_behavior_containers[m_dof_winners[dof]]->get_opts().name;
+        }
+        msg.dof_requests[dof] = m_dof_requests[dof];
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_energy_mutex);
+
+        msg.path_behavior = m_path_owner;
+
+        msg.path_target = m_path_target;
+    }
+
+    msg.duration = duration;
+
+    m_pub_log_tick.publish(msg);
 
 }
 
 void Helm::f_helm_loop() {
 
-    ros::Rate r(m_helm_freq);
+    auto rate_frequency = m_helm_freq;
+
+    ros::Rate r(rate_frequency);
     while(ros::ok() && !ros::isShuttingDown()) {
-        f_iterate();
-        r.sleep();
+
+        step();
+
+        if(rate_frequency != m_helm_freq) {
+            rate_frequency = m_helm_freq;
+
+            r = ros::Rate(rate_frequency);
+        }
+
+        if(m_alignment_conf.enabled) {
+            f_sleep_aligned();
+        } else {
+            r.sleep();
+        }
+    }
+
+}
+
+void Helm::f_sleep_aligned() {
+
+    auto next = m_tick_scheduler->next_tick(ros::Time::now().toSec());
+
+    auto locked = m_tick_scheduler->locked();
+    if(locked != m_tick_locked) {
+        m_tick_locked = locked;
+
+        if(locked) {
+            ROS_INFO_STREAM("Helm ticks are aligned to the controller, sample"
+                " period is " << m_tick_scheduler->get_sample_period() * 1000.0
+                << "ms");
+        } else {
+            ROS_WARN_STREAM("Helm ticks lost the alignment to the controller,"
+                " running on the helm period");
+        }
+    }
+
+    ros::Time::sleepUntil(ros::Time(next));
+
+}
+
+void Helm::f_write_status(double duration) {
+
+    auto active_state = m_state_machine->get_active_state();
+
+    std::vector<bool> decimated(m_behavior_containers.size(), false);
+    f_select_decimated_behaviors(active_state.name, &decimated);
+
+    auto count = std::min<size_t>(
+        m_behavior_containers.size(), HELM_STATUS_MAX_BEHAVIORS);
+
+    /**
+     * Only plain stores between begin and commit, readers retry for as long
+     * as the page is being written.
+     */
+    auto s = m_status_page->begin();
+
+    s->tick = m_tick;
+    s->stamp = ros::Time::now().toSec();
+    s->frequency = m_helm_freq;
+    s->duration = duration;
+    s->overload_level = m_governor->get_level();
+    s->aligned = m_alignment_conf.enabled && m_tick_scheduler->locked();
+    s->standby = m_standby_mode;
+
+    StatusPage::set_string(s->state, active_state.name);
+    StatusPage::set_string(s->mode, active_state.mode);
+
+    for(size_t dof = 0 ; dof < HELM_STATUS_DOF_COUNT ; dof++) {
+        s->dof_winners[dof] = m_dof_winners[dof] < static_cast<int>(count) ?
+            m_dof_winners[dof] : -1;
+        s->set_point[dof] = m_set_point[dof];
+    }
+    s->set_point_stamp = m_set_point_stamp.toSec();
+
+    s->behavior_count = static_cast<uint32_t>(count);
+    for(size_t idx = 0 ; idx < count ; idx++) {
+        const auto& i = m_behavior_containers[idx];
+        const auto& opts = i->get_opts();
+        auto& b = s->behaviors[idx];
+
+        auto priority = opts.states.find(active_state.name);
+
+        StatusPage::set_string(b.name, opts.name);
+        b.active = i->get_behavior()->m_activated;
+        b.result = i->get_last_result();
+        b.decimated = decimated[idx];
+        b.critical = opts.critical;
+        b.priority = priority == opts.states.end() ? -1 : priority->second;
+        b.failures = i->get_failures();
+        b.duration = i->get_duration();
+        auto memory = i->get_memory_stats();
+        b.memory_in_use = memory.in_use;
+        b.memory_high_water = memory.high_water;
+        b.memory_reserved = memory.reserved;
+        b.memory_allocations = memory.allocations;
+        b.checkpoint_size = static_cast<uint32_t>(std::min<size_t>(
+            i->get_behavior()->save_checkpoint(
+                b.checkpoint, sizeof(b.checkpoint)),
+            sizeof(b.checkpoint)));
+    }
+
+    m_status_page->commit();
+
+}
+
+void Helm::f_initialize_failsafe() {
+
+    sm_state_t state;
+    if(!m_state_machine->get_state(m_failsafe_conf.state, &state)) {
+        throw HelmException("Failsafe state '" + m_failsafe_conf.state +
+            "' is not defined!");
+    }
+
+    std::array<double, 12> set_point{};
+    for(const auto& i : m_failsafe_conf.set_point) {
+        auto dof = std::find_if(
+            std::begin(DOF_NAMES),
+            std::end(DOF_NAMES),
+            [&i](const char* name) {
+                return i.first == name;
+            }
+        );
+
+        if(dof == std::end(DOF_NAMES)) {
+            throw HelmException("Failsafe set point has an unknown DOF '" +
+                i.first + "'!");
+        }
+
+        set_point[dof - std::begin(DOF_NAMES)] = i.second;
+    }
+
+    m_failsafe_set_point = utils::array_to_control_process_msg(set_point);
+    m_failsafe_set_point.control_mode = state.mode;
+
+    auto mode = std::find_if(
+        m_controller_modes.modes.begin(),
+        m_controller_modes.modes.end(),
+        [&state](const mvp_msgs::ControlMode& m) {
+            return m.name == state.mode;
+        }
+    );
+
+    if(mode == std::end(m_controller_modes.modes)) {
+        ROS_WARN_STREAM("Mode '" << state.mode << "' of the failsafe state"
+            " can not be found in low level controller configuration!");
+    }
+
+}
+
+ros::Time Helm::f_publish_failsafe() {
+
+    auto msg = m_failsafe_set_point;
+    msg.header.stamp = ros::Time::now();
+
+    HELM_PROBE1(failsafe_publish, msg.control_mode.c_str());
+
+    m_pub_controller_set_point.publish(msg);
+
+    return msg.header.stamp;
+
+}
+
+bool Helm::f_check_process_age() {
+
+    if(!m_failsafe_conf.enabled || m_failsafe_conf.max_age <= 0) {
+        return false;
+    }
+
+    auto age = ros::Time::now().toSec() - m_process_arrival.load();
+
+    bool stale = age > m_failsafe_conf.max_age;
+    if(stale == m_process_stale) {
+        return stale;
+    }
+
+    m_process_stale = stale;
+
+    if(stale) {
+        ROS_ERROR_STREAM("No process value is received for " << age <<
+            "s, requesting the failsafe state '" << m_failsafe_conf.state <<
+            "'");
+
+        f_change_state(m_failsafe_conf.state);
+    } else {
+        ROS_WARN_STREAM("Process values are received again, helm stays in"
+            " state '" << m_state_machine->get_active_state().name << "'");
+    }
+
+    return stale;
+
+}
+
+void Helm::f_schedule_state_timeout(const std::string& name) {
+
+    auto entry = ++m_state_entries;
+
+    m_timing_wheel->cancel(m_state_timer.exchange(0));
+
+    sm_state_t state;
+    if(!m_state_machine->get_state(name, &state) ||
+        state.timeout <= 0 || state.timeout_to.empty()) {
+        return;
+    }
+
+    m_state_timer = m_timing_wheel->schedule(
+        ros::Time::now().toSec(),
+        state.timeout,
+        [this, entry, state] {
+            if(entry != m_state_entries) {
+                return;
+            }
+
+            ROS_INFO_STREAM("State '" << state.name << "' timed out after " <<
+                state.timeout << "s, requesting '" << state.timeout_to << "'");
+
+            if(!f_change_state(state.timeout_to)) {
+                ROS_WARN_STREAM("Transition from '" << state.name << "' to '"
+                    << state.timeout_to << "' is not allowed");
+            }
+        }
+    );
+
+}
+
+void Helm::f_mirror() {
+
+    if(!m_standby->is_synced()) {
+        return;
+    }
+
+    const auto& s = m_standby->get_status();
+
+    /**
+     * State is followed without checking the transitions, its timeout starts
+     * when the standby sees it.
+     */
+    auto from = m_state_machine->get_active_state().name;
+    std::string state(s.state, strnlen(s.state, sizeof(s.state)));
+    if(state != from) {
+        bool result = m_state_machine->set_active_state(state);
+
+        HELM_PROBE3(state_transition, from.c_str(), state.c_str(), result);
+
+        if(result) {
+            f_schedule_state_timeout(state);
+        } else {
+            ROS_WARN_STREAM_THROTTLE(10, "Primary helm is in state '" <<
+                state << "' which is not defined");
+        }
+    }
+
+    /**
+     * Behaviors are activated like the ones of the primary so that their
+     * checkpoints are loaded on top of their activation.
+     */
+    auto count = std::min<size_t>(s.behavior_count, HELM_STATUS_MAX_BEHAVIORS);
+    for(size_t idx = 0 ; idx < m_behavior_containers.size() ; idx++) {
+        const auto& i = m_behavior_containers[idx];
+        auto behavior = i->get_behavior();
+
+        if(m_controller_process_values != nullptr) {
+            behavior->m_process_values = *m_controller_process_values;
+        }
+
+        if(idx >= count || i->get_opts().name.compare(
+            0, HELM_STATUS_NAME_LENGTH - 1, s.behaviors[idx].name) != 0) {
+            ROS_WARN_STREAM_THROTTLE(10, "Behavior '" << i->get_opts().name <<
+                "' is not found at the same place in the primary helm");
+            continue;
+        }
+
+        const auto& b = s.behaviors[idx];
+
+        bool activated = b.active && !behavior->m_activated;
+        if(b.active) {
+            behavior->f_activate();
+        } else {
+            behavior->f_disable();
+        }
+
+        auto& last = m_mirrored_checkpoints[idx];
+        auto size = std::min<size_t>(
+            b.checkpoint_size, HELM_STATUS_CHECKPOINT_SIZE);
+
+        if(activated || last.size() != size ||
+            !std::equal(last.begin(), last.end(), b.checkpoint)) {
+            last.assign(b.checkpoint, b.checkpoint + size);
+
+            if(size > 0) {
+                behavior->load_checkpoint(b.checkpoint, size);
+            }
+        }
+    }
+
+    for(size_t dof = 0 ; dof < m_dof_winners.size() ; dof++) {
+        m_dof_winners[dof] = s.dof_winners[dof];
+        m_set_point[dof] = s.set_point[dof];
+    }
+    m_set_point_stamp.fromSec(s.set_point_stamp);
+
+}
+
+void Helm::f_take_over() {
+
+    ROS_ERROR_STREAM("Primary helm " << m_standby_conf.primary <<
+        " missed its heartbeats, taking over");
+
+    /**
+     * Primary is marked before the first set point is published. If it was
+     * only stalled, or once it is restarted, it finds the mark and follows
+     * this helm instead of publishing beside it.
+     */
+    std::string owner = m_status_page ? m_status_page->get_name() : "";
+    if(helm_status_take_over(
+        m_standby_conf.primary.c_str(), owner.c_str()) < 0) {
+        ROS_WARN_STREAM("Status page of the primary helm can not be marked, "
+            << std::strerror(errno));
+    }
+
+    /**
+     * This helm may have been taken over from before, the mark on its own
+     * page is left by the helm it just replaced.
+     */
+    if(m_status_page) {
+        m_status_page->clear_owner();
+    }
+
+    m_standby.reset();
+
+    m_standby_mode = false;
+
+}
+
+void Helm::f_follow_owner() {
+
+    std::string owner;
+    auto pid = m_status_page->get_owner(&owner);
+    if(pid == 0) {
+        return;
+    }
+
+    m_standby_mode = true;
+
+    if(owner.empty() || owner == m_status_page->get_name()) {
+        ROS_ERROR_STREAM("Helm with pid " << pid << " took over, no set"
+            " point is published until it exits and this helm restarts");
+        return;
+    }
+
+    ROS_ERROR_STREAM("Helm " << owner << " took over, this helm is its"
+        " standby now");
+
+    m_standby_conf.primary = owner;
+
+    m_standby.reset(new Standby(m_standby_conf));
+
+    m_mirrored_checkpoints.assign(m_behavior_containers.size(), {});
+
+}
+
+void Helm::f_select_decimated_behaviors(const std::string& state,
+                                        std::vector<bool>* decimated) {
+
+    auto count = static_cast<size_t>(m_governor->get_decimated_count());
+
+    if(count == 0) {
+        return;
+    }
+
+    /**
+     * Candidates are sorted by their priority in the given state. Behaviors
+     * that are not active in the state have the lowest priority.
+     */
+    std::vector<std::pair<int, size_t>> candidates;
+    for(size_t idx = 0 ; idx < m_behavior_containers.size() ; idx++) {
+        const auto& opts = m_behavior_containers[idx]->get_opts();
+
+        if(opts.critical) {
+            continue;
+        }
+
+        auto priority = opts.states.find(state);
+
+        candidates.emplace_back(
+            priority == opts.states.end() ? -1 : priority->second, idx);
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(),
+        [](const std::pair<int, size_t>& a, const std::pair<int, size_t>& b) {
+            return a.first < b.first;
+        }
+    );
+
+    for(size_t k = 0 ; k < count && k < candidates.size() ; k++) {
+        (*decimated)[candidates[k].second] = true;
+    }
+
+}
+
+void Helm::f_apply_overload_level(double duration) {
+
+    auto level = m_governor->get_level();
+
+    for(const auto& i : m_behavior_containers) {
+        i->get_behavior()->m_visualization_enabled =
+            m_governor->visualization_enabled();
+    }
+
+    std::vector<bool> decimated(m_behavior_containers.size(), false);
+    f_select_decimated_behaviors(
+        m_state_machine->get_active_state().name, &decimated);
+
+    std::stringstream ss;
+    for(size_t idx = 0 ; idx < decimated.size() ; idx++) {
+        if(decimated[idx]) {
+            ss << " " << m_behavior_containers[idx]->get_opts().name;
+        }
+    }
+
+    HELM_PROBE2(overload_level, m_tick, level);
+
+    ROS_WARN_STREAM("Helm overload level is " << level << ". Last iteration"
+        " took " << duration * 1000.0 << "ms of " << 1000.0 / m_helm_freq <<
+        "ms. Visualization " <<
+        (m_governor->visualization_enabled() ? "enabled" : "disabled") <<
+        ", decimated behaviors:" << (ss.str().empty() ? " none" : ss.str()));
+
+}
+
+void Helm::f_report_path(const std::string& behavior,
+                         const std::vector<double>& x,
+                         const std::vector<double>& y,
+                         double speed) {
+
+    mvp_helm::HelmPath msg;
+    msg.header.stamp = ros::Time::now();
+    msg.behavior = behavior;
+    msg.x = x;
+    msg.y = y;
+    msg.speed = speed;
+
+    m_pub_log_path.publish(msg);
+
+    std::lock_guard<std::mutex> lock(m_energy_mutex);
+
+    m_path_owner = behavior;
+
+    m_path_target = -1;
+
+    if(m_energy_conf.enabled) {
+        m_energy->set_path(x, y, speed);
+    }
+
+}
+
+void Helm::f_report_path_target(const std::string& behavior, size_t index) {
+
+    std::lock_guard<std::mutex> lock(m_energy_mutex);
+
+    if(behavior != m_path_owner) {
+        return;
+    }
+
+    m_path_target = static_cast<int32_t>(index);
+
+    if(m_energy_conf.enabled) {
+        m_energy->set_target(index);
+    }
+
+}
+
+void Helm::f_cb_energy(const std_msgs::Float64::ConstPtr& msg) {
+
+    std::lock_guard<std::mutex> lock(m_energy_mutex);
+
+    m_energy->set_measured_energy(msg->data);
+
+}
+
+void Helm::f_update_energy() {
+
+    auto now = ros::Time::now();
+
+    double dt = m_energy_last_update.isZero() ?
+        0.0 : (now - m_energy_last_update).toSec();
+
+    m_energy_last_update = now;
+
+    EnergyEstimator::status_t status;
+    std::string owner;
+    {
+        std::lock_guard<std::mutex> lock(m_energy_mutex);
+
+        m_energy->update(
+            m_controller_process_values->position.x,
+            m_controller_process_values->position.y,
+            std::hypot(m_controller_process_values->velocity.x,
+                       m_controller_process_values->velocity.y),
+            dt
+        );
+
+        status = m_energy->get_status();
+        owner = m_path_owner;
+    }
+
+    if(status.valid && status.margin < 0) {
+        if(!m_energy_triggered) {
+            m_energy_triggered = true;
+
+            ROS_WARN_STREAM("Remaining energy " << status.energy_remaining <<
+                "Wh is not enough for the path of " << owner << ", " <<
+                status.energy_required << "Wh is required.");
+
+            if(!m_energy_conf.state.empty()) {
+                f_change_state(m_energy_conf.state);
+            }
+        }
+    } else {
+        m_energy_triggered = false;
     }
 
+    if((now - m_energy_last_publish).toSec() < 1.0) {
+        return;
+    }
+
+    m_energy_last_publish = now;
+
+    mvp_helm::EnergyStatus msg;
+    msg.header.stamp = now;
+    msg.behavior = owner;
+    msg.valid = status.valid;
+    msg.remaining_distance = status.remaining_distance;
+    msg.eta = status.eta;
+    msg.energy_required = status.energy_required;
+    msg.energy_remaining = status.energy_remaining;
+    msg.margin = status.margin;
+    msg.correction = status.correction;
+
+    m_pub_energy.publish(msg);
+
+}
+
+double Helm::f_desired_frequency() {
+
+    auto state_freq = m_state_machine->get_active_state().frequency;
+
+    return state_freq > 0 ? state_freq : m_base_freq.load();
+
+}
+
+void Helm::f_set_frequency(double frequency) {
+
+    ROS_INFO_STREAM("Helm frequency is changed from " << m_helm_freq <<
+        "Hz to " << frequency << "Hz");
+
+    m_helm_freq = frequency;
+
+    m_governor->set_period(1.0 / m_helm_freq);
+
+    m_tick_scheduler->set_period(1.0 / m_helm_freq);
+
+    for(const auto& i : m_behavior_containers) {
+        i->get_behavior()->m_helm_frequency = m_helm_freq;
+
+        i->get_behavior()->helm_frequency_changed(m_helm_freq);
+    }
+
+}
+
+bool Helm::f_cb_set_frequency(mvp_helm::SetHelmFrequency::Request &req,
+                              mvp_helm::SetHelmFrequency::Response &resp) {
+
+    m_pub_log_set_frequency.publish(req);
+
+    if(!std::isfinite(req.frequency) || req.frequency <= 0) {
+        resp.status = false;
+        resp.frequency = f_desired_frequency();
+        return true;
+    }
+
+    m_base_freq = req.frequency;
+
+    resp.status = true;
+    resp.frequency = f_desired_frequency();
+
+    return true;
 }
 
 bool Helm::f_cb_change_state(mvp_msgs::ChangeState::Request &req,
                              mvp_msgs::ChangeState::Response &resp) {
 
-    if(f_change_state(req.state)) {
+    m_pub_log_change_state.publish(req);
+
+    // Standby follows the state of the primary
+    if(!m_standby_mode && f_change_state(req.state)) {
 
         sm_state_t s;
         m_state_machine->get_state(req.state, &s);
@@ -447,5 +1584,34 @@ bool Helm::f_cb_get_states(mvp_msgs::GetStates::Request &req,
 }
 
 bool Helm::f_change_state(const std::string& name) {
-    return m_state_machine->translate_to(name);
+
+    auto from = m_state_machine->get_active_state().name;
+
+    bool result;
+    if(m_failsafe_conf.enabled && name == m_failsafe_conf.state) {
+        /**
+         * The safe set point doesn't wait for the next tick, the iteration
+         * in progress is discarded instead.
+         */
+        std::lock_guard<std::mutex> lock(m_publish_mutex);
+
+        result = m_state_machine->set_active_state(name);
+        if(result) {
+            m_failsafe_count++;
+
+            if(!m_standby_mode) {
+                f_publish_failsafe();
+            }
+        }
+    } else {
+        result = m_state_machine->translate_to(name);
+    }
+
+    if(result) {
+        f_schedule_state_timeout(name);
+    }
+
+    HELM_PROBE3(state_transition, from.c_str(), name.c_str(), result);
+
+    return result;
 }
\ No newline at end of file
@@ -27,7 +27,10 @@
 /*******************************************************************************
  * STD
  */
+#include "array"
+#include "atomic"
 #include "memory"
+#include "mutex"
 #include "thread"
 
 /*******************************************************************************
@@ -43,13 +46,28 @@
 #include "mvp_msgs/GetState.h"
 #include "mvp_msgs/GetStates.h"
 #include "mvp_msgs/ChangeState.h"
+
+#include "mvp_helm/EnergyStatus.h"
+#include "mvp_helm/HelmPath.h"
+#include "mvp_helm/HelmTick.h"
+#include "mvp_helm/SetHelmFrequency.h"
+
+#include "std_msgs/Float64.h"
 /*******************************************************************************
  * Helm
  */
 #include "behavior_container.h"
+#include "energy.h"
+#include "governor.h"
 #include "obj.h"
 #include "parser.h"
+#include "shadow.h"
 #include "sm.h"
+#include "standby.h"
+#include "status_page.h"
+#include "tick_scheduler.h"
+#include "timing_wheel.h"
+#include "worker_pool.h"
 
 namespace helm {
 
@@ -58,11 +76,44 @@ namespace helm {
 
         friend class BehaviorBase;
 
+        friend class Replay;
+
         /**
          * @brief Helm frequency in hertz
          */
         double m_helm_freq;
 
+        /**
+         * @brief Helm frequency requested by the configuration or the service
+         * States with their own frequency override it while they are active.
+         */
+        std::atomic<double> m_base_freq;
+
+        /**
+         * @brief Number of iterations executed by the helm
+         */
+        uint64_t m_tick;
+
+        /**
+         * @brief Index of the behavior that won each DOF in the last iteration
+         * Negative value means that no behavior controlled that DOF.
+         */
+        std::array<int, 12> m_dof_winners;
+
+        /**
+         * @brief Number of active behaviors that requested each DOF in the
+         *        last iteration
+         */
+        std::array<uint8_t, 12> m_dof_requests;
+
+        /**
+         * @brief Last set point sent to the controller, indexed by DOF
+         */
+        std::array<double, 12> m_set_point;
+
+        //! @brief Time of #Helm::m_set_point, zero if none is sent
+        ros::Time m_set_point_stamp;
+
         /**
          * @brief Controller state
          * This variable holds the state of the low level controller such as
@@ -83,12 +134,34 @@ namespace helm {
          */
         std::vector<std::shared_ptr<BehaviorContainer>> m_behavior_containers;
 
+        /**
+         * @brief Fraction of the helm period shared by the behaviors
+         * Each behavior gets its share as a deadline before its set point is
+         * requested.
+         */
+        double m_time_budget;
+
+        /**
+         * @brief Worker threads for background work of the behaviors
+         * It must be destroyed before the behaviors.
+         */
+        WorkerPool::Ptr m_worker_pool;
+
         /**
          * @brief Gets controller modes from low level controller
          *
          */
         void f_get_controller_modes();
 
+        /**
+         * @brief Checks the arbitration of every state against the DOFs of
+         *        the behaviors and the controller modes
+         *
+         * Warns about the DOFs that the mode of a state doesn't control and
+         * the DOFs that two behaviors request with the same priority.
+         */
+        void f_check_arbitration();
+
         /**
          *
          * @param behavior_component
@@ -125,6 +198,253 @@ namespace helm {
          */
         StateMachine::Ptr m_state_machine;
 
+        /**
+         * @brief Shadow mission configuration
+         */
+        shadow_configuration_t m_shadow_conf;
+
+        /**
+         * @brief Shadow helm
+         * Evaluates the shadow mission with the same process values. It is
+         * null if the shadow mode is not enabled.
+         */
+        Shadow::Ptr m_shadow;
+
+        /**
+         * @brief Overload governor
+         * Decides how much work should be shed when the iterations overrun
+         * the helm period.
+         */
+        OverloadGovernor::Ptr m_governor;
+
+        /**
+         * @brief Energy estimator configuration
+         */
+        energy_configuration_t m_energy_conf;
+
+        /**
+         * @brief Estimates the energy needed for the reported path
+         * Guarded by #Helm::m_energy_mutex, paths may be reported from the
+         * subscriber callbacks of the behaviors.
+         */
+        EnergyEstimator::Ptr m_energy;
+
+        std::mutex m_energy_mutex;
+
+        //! @brief Name of the behavior that reported the path last
+        std::string m_path_owner;
+
+        //! @brief Waypoint the owner of the path heads to, -1 if unknown
+        int32_t m_path_target;
+
+        //! @brief True once the configured state is requested for a deficit
+        bool m_energy_triggered;
+
+        ros::Time m_energy_last_update;
+
+        ros::Time m_energy_last_publish;
+
+        /**
+         * @brief Tick alignment configuration
+         */
+        alignment_configuration_t m_alignment_conf;
+
+        /**
+         * @brief Schedules the ticks after the controller process values
+         */
+        TickScheduler::Ptr m_tick_scheduler;
+
+        //! @brief Last reported lock status of #Helm::m_tick_scheduler
+        bool m_tick_locked;
+
+        /**
+         * @brief Sleeps until the next tick given by the tick scheduler
+         */
+        void f_sleep_aligned();
+
+        /**
+         * @brief Status page configuration
+         */
+        status_page_configuration_t m_status_page_conf;
+
+        /**
+         * @brief Shared memory status for the external monitors
+         * It is null if the status page is not enabled.
+         */
+        StatusPage::Ptr m_status_page;
+
+        /**
+         * @brief Writes the result of the last iteration to the status page
+         *
+         * @param duration Duration of the last iteration in seconds
+         */
+        void f_write_status(double duration);
+
+        /**
+         * @brief Standby configuration
+         */
+        standby_configuration_t m_standby_conf;
+
+        /**
+         * @brief Follows the primary helm
+         * It is null if the helm is not a standby or after it takes over.
+         */
+        Standby::Ptr m_standby;
+
+        /**
+         * @brief True while the helm is a standby or another helm took over
+         * Read by the service callbacks, no set point is published while it
+         * is true.
+         */
+        std::atomic<bool> m_standby_mode;
+
+        //! @brief Last checkpoint loaded into each behavior
+        std::vector<std::vector<uint8_t>> m_mirrored_checkpoints;
+
+        /**
+         * @brief Copies the state of the primary helm
+         */
+        void f_mirror();
+
+        /**
+         * @brief Marks the page of the primary and stops being a standby
+         */
+        void f_take_over();
+
+        /**
+         * @brief Stops publishing if another helm took over from this one
+         *
+         * Helm becomes a standby of the helm that took over, or stays idle
+         * if that helm has no status page.
+         */
+        void f_follow_owner();
+
+        /**
+         * @brief Timers of the behaviors and the states
+         * Advanced at the beginning of each tick.
+         */
+        TimingWheel::Ptr m_timing_wheel;
+
+        //! @brief Timer of the state timeout, 0 if there is none
+        std::atomic<TimingWheel::timer_id_t> m_state_timer;
+
+        /**
+         * @brief Number of the state transitions
+         * A state timeout that fires after the state is left does nothing.
+         */
+        std::atomic<uint64_t> m_state_entries;
+
+        /**
+         * @brief Schedules the timeout of the state that is just entered
+         *
+         * @param name Name of the state
+         */
+        void f_schedule_state_timeout(const std::string& name);
+
+        /**
+         * @brief Failsafe configuration
+         */
+        failsafe_configuration_t m_failsafe_conf;
+
+        /**
+         * @brief Set point published on entering the failsafe state
+         * Built once in #Helm::initialize, only the stamp is set on publish.
+         */
+        mvp_msgs::ControlProcess m_failsafe_set_point;
+
+        /**
+         * @brief Serializes the set point publishing of the helm thread and
+         *        the failsafe transitions requested from the other threads
+         */
+        std::mutex m_publish_mutex;
+
+        /**
+         * @brief Number of transitions to the failsafe state
+         * An iteration that started before a failsafe transition doesn't
+         * publish its set point, it would override the safe one.
+         */
+        std::atomic<uint64_t> m_failsafe_count;
+
+        //! @brief Arrival time of the last process value, in seconds
+        std::atomic<double> m_process_arrival;
+
+        //! @brief True while the process values are older than allowed
+        bool m_process_stale;
+
+        /**
+         * @brief Builds #Helm::m_failsafe_set_point from the configuration
+         */
+        void f_initialize_failsafe();
+
+        /**
+         * @brief Publishes the failsafe set point
+         * Caller must hold #Helm::m_publish_mutex.
+         *
+         * @return Stamp of the published set point
+         */
+        ros::Time f_publish_failsafe();
+
+        /**
+         * @brief Checks the age of the process values and requests the
+         *        failsafe state once they are older than allowed
+         *
+         * @return true if the process values are stale
+         */
+        bool f_check_process_age();
+
+        /**
+         * @brief Marks the behaviors that should be decimated in the state
+         *
+         * Non-critical behaviors are picked in ascending priority order. The
+         * behaviors that are not active in the state are picked first.
+         *
+         * @param state Name of the state
+         * @param decimated Output, one flag per behavior container
+         */
+        void f_select_decimated_behaviors(
+            const std::string& state, std::vector<bool>* decimated);
+
+        /**
+         * @brief Applies and reports the shedding level of the governor
+         *
+         * @param duration Duration of the last iteration in seconds
+         */
+        void f_apply_overload_level(double duration);
+
+        /**
+         * @brief Frequency that the helm should run at in the active state
+         */
+        double f_desired_frequency();
+
+        /**
+         * @brief Changes the helm frequency and notifies the behaviors
+         *
+         * Must be called from the helm thread.
+         *
+         * @param frequency New frequency in hertz
+         */
+        void f_set_frequency(double frequency);
+
+        /**
+         * @brief Path report of a behavior, see #BehaviorBase::report_path
+         */
+        void f_report_path(const std::string& behavior,
+                           const std::vector<double>& x,
+                           const std::vector<double>& y,
+                           double speed);
+
+        /**
+         * @brief Path progress of a behavior, see
+         *        #BehaviorBase::report_path_target
+         */
+        void f_report_path_target(const std::string& behavior, size_t index);
+
+        /**
+         * @brief Updates the energy estimate and requests the configured state
+         *        if the energy is not enough to finish the path
+         */
+        void f_update_energy();
+
         /**
          * @brief Executes one iteration of helm
          *
@@ -162,6 +482,45 @@ namespace helm {
 
         ros::ServiceServer m_get_state_srv;
 
+        ros::ServiceServer m_set_frequency_srv;
+
+        //! @brief Measured remaining energy subscriber
+        ros::Subscriber m_sub_energy;
+
+        //! @brief Energy estimate publisher
+        ros::Publisher m_pub_energy;
+
+        /**
+         * @brief Publishers of the inputs that don't arrive through topics
+         *
+         * Service requests and the controller modes are published under
+         * "~log" so that a recorded log can be replayed, see #Replay.
+         */
+        ros::Publisher m_pub_log_change_state;
+
+        ros::Publisher m_pub_log_set_frequency;
+
+        ros::Publisher m_pub_log_controller_modes;
+
+        /**
+         * @brief Publishers of the helm decisions for offline analysis
+         *
+         * A tick is only built when there is a subscriber, e.g. a recorder.
+         * Paths are latched.
+         */
+        ros::Publisher m_pub_log_tick;
+
+        ros::Publisher m_pub_log_path;
+
+        /**
+         * @brief Publishes the last iteration to "~log/tick"
+         *
+         * @param duration Duration of the iteration in seconds
+         */
+        void f_log_tick(double duration);
+
+        void f_cb_energy(const std_msgs::Float64::ConstPtr& msg);
+
         bool f_cb_change_state(
             mvp_msgs::ChangeState::Request& req,
             mvp_msgs::ChangeState::Response& resp);
@@ -174,6 +533,19 @@ namespace helm {
             mvp_msgs::GetStates::Request& req,
             mvp_msgs::GetStates::Response& resp);
 
+        bool f_cb_set_frequency(
+            mvp_helm::SetHelmFrequency::Request& req,
+            mvp_helm::SetHelmFrequency::Response& resp);
+
+        /**
+         * @brief Requests a state transition
+         *
+         * Transition to the failsafe state is accepted from any state and its
+         * set point is published right away from the calling thread.
+         *
+         * @param name Name of the state
+         * @return false if the transition is not allowed
+         */
         bool f_change_state(const std::string& name);
 
     public:
@@ -193,6 +565,15 @@ namespace helm {
          */
         void run();
 
+        /**
+         * @brief Executes a single iteration without waiting for the period
+         *
+         * Frequency changes are applied before the iteration. #Helm::run
+         * calls this every period, a caller that drives the clock itself, such
+         * as the replay tool, calls it at the time of each tick.
+         */
+        void step();
+
         ~Helm();
 
     };
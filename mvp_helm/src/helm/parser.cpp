@@ -43,6 +43,12 @@ Parser::Parser() : HelmObj() {
 
 }
 
+Parser::Parser(const std::string& ns) : HelmObj() {
+
+    m_pnh = std::make_shared<ros::NodeHandle>(*m_pnh, ns);
+
+}
+
 void Parser::initialize() {
 
     if(!m_pnh->hasParam("finite_state_machine")) {
@@ -63,15 +69,264 @@ void Parser::initialize() {
 
 }
 
+/**
+ * @brief Reads a numeric member of a struct typed XmlRpc value
+ *
+ * Yaml doesn't distinguish "1" from "1.0" the way XmlRpc does. Both of them
+ * are accepted here.
+ *
+ * @param v struct typed XmlRpc value
+ * @param key member name
+ * @param def default value if the member doesn't exist
+ * @return double
+ */
+static double f_xmlrpc_number(XmlRpc::XmlRpcValue& v,
+                              const std::string& key,
+                              double def)
+{
+    if(v.getType() != XmlRpc::XmlRpcValue::TypeStruct || !v.hasMember(key)) {
+        return def;
+    }
+
+    if(v[key].getType() == XmlRpc::XmlRpcValue::TypeInt) {
+        return static_cast<int>(v[key]);
+    }
+
+    if(v[key].getType() == XmlRpc::XmlRpcValue::TypeDouble) {
+        return static_cast<double>(v[key]);
+    }
+
+    throw HelmException("'" + key + "' must be a number!");
+}
+
 void Parser::f_parse_helm_configuration() {
 
     XmlRpc::XmlRpcValue helm_config;
 
     m_pnh->getParam(CONF_HELM, helm_config);
 
+    overload_configuration_t overload {
+        .enabled = false,
+        .threshold = DEFAULT_OVERLOAD_THRESHOLD,
+        .trigger_count = DEFAULT_OVERLOAD_TRIGGER_COUNT,
+        .recover_threshold = DEFAULT_OVERLOAD_RECOVER_THRESHOLD,
+        .recover_count = DEFAULT_OVERLOAD_RECOVER_COUNT,
+        .decimation = DEFAULT_OVERLOAD_DECIMATION
+    };
+
+    if(helm_config.hasMember(CONF_HELM_OVERLOAD)) {
+        auto& o = helm_config[CONF_HELM_OVERLOAD];
+
+        overload.enabled = true;
+        if(o.hasMember(CONF_HELM_OVERLOAD_ENABLED)) {
+            overload.enabled = o[CONF_HELM_OVERLOAD_ENABLED];
+        }
+
+        overload.threshold = f_xmlrpc_number(
+            o, CONF_HELM_OVERLOAD_THRESHOLD, overload.threshold);
+
+        overload.trigger_count = static_cast<int>(f_xmlrpc_number(
+            o, CONF_HELM_OVERLOAD_TRIGGER_COUNT, overload.trigger_count));
+
+        overload.recover_threshold = f_xmlrpc_number(
+            o, CONF_HELM_OVERLOAD_RECOVER_THRESHOLD,
+            overload.recover_threshold);
+
+        overload.recover_count = static_cast<int>(f_xmlrpc_number(
+            o, CONF_HELM_OVERLOAD_RECOVER_COUNT, overload.recover_count));
+
+        overload.decimation = static_cast<int>(f_xmlrpc_number(
+            o, CONF_HELM_OVERLOAD_DECIMATION, overload.decimation));
+    }
+
+    shadow_configuration_t shadow {
+        .enabled = false,
+        .ns = DEFAULT_SHADOW_NAMESPACE,
+        .cpu = -1
+    };
+
+    if(helm_config.hasMember(CONF_HELM_SHADOW)) {
+        auto& o = helm_config[CONF_HELM_SHADOW];
+
+        shadow.enabled = true;
+        if(o.hasMember(CONF_HELM_SHADOW_ENABLED)) {
+            shadow.enabled = o[CONF_HELM_SHADOW_ENABLED];
+        }
+
+        if(o.hasMember(CONF_HELM_SHADOW_NAMESPACE)) {
+            shadow.ns = static_cast<std::string>(o[CONF_HELM_SHADOW_NAMESPACE]);
+        }
+
+        shadow.cpu = static_cast<int>(
+            f_xmlrpc_number(o, CONF_HELM_SHADOW_CPU, shadow.cpu));
+    }
+
+    energy_configuration_t energy {
+        .enabled = false,
+        .topic = DEFAULT_ENERGY_TOPIC,
+        .capacity = 0,
+        .hotel_power = DEFAULT_ENERGY_HOTEL_POWER,
+        .propulsion_coefficient = DEFAULT_ENERGY_PROPULSION_COEFFICIENT,
+        .reserve = 0,
+        .correction_time_constant = DEFAULT_ENERGY_CORRECTION_TIME_CONSTANT,
+        .state = ""
+    };
+
+    if(helm_config.hasMember(CONF_HELM_ENERGY)) {
+        auto& o = helm_config[CONF_HELM_ENERGY];
+
+        energy.enabled = true;
+        if(o.hasMember(CONF_HELM_ENERGY_ENABLED)) {
+            energy.enabled = o[CONF_HELM_ENERGY_ENABLED];
+        }
+
+        if(o.hasMember(CONF_HELM_ENERGY_TOPIC)) {
+            energy.topic = static_cast<std::string>(o[CONF_HELM_ENERGY_TOPIC]);
+        }
+
+        energy.capacity = f_xmlrpc_number(
+            o, CONF_HELM_ENERGY_CAPACITY, energy.capacity);
+
+        energy.hotel_power = f_xmlrpc_number(
+            o, CONF_HELM_ENERGY_HOTEL_POWER, energy.hotel_power);
+
+        energy.propulsion_coefficient = f_xmlrpc_number(
+            o, CONF_HELM_ENERGY_PROPULSION_COEFFICIENT,
+            energy.propulsion_coefficient);
+
+        energy.reserve = f_xmlrpc_number(
+            o, CONF_HELM_ENERGY_RESERVE, energy.reserve);
+
+        energy.correction_time_constant = f_xmlrpc_number(
+            o, CONF_HELM_ENERGY_CORRECTION_TIME_CONSTANT,
+            energy.correction_time_constant);
+
+        if(o.hasMember(CONF_HELM_ENERGY_STATE)) {
+            energy.state = static_cast<std::string>(o[CONF_HELM_ENERGY_STATE]);
+        }
+    }
+
+    alignment_configuration_t alignment {
+        .enabled = false,
+        .margin = DEFAULT_ALIGNMENT_MARGIN,
+        .phase_gain = DEFAULT_ALIGNMENT_PHASE_GAIN,
+        .period_gain = DEFAULT_ALIGNMENT_PERIOD_GAIN
+    };
+
+    if(helm_config.hasMember(CONF_HELM_ALIGNMENT)) {
+        auto& o = helm_config[CONF_HELM_ALIGNMENT];
+
+        alignment.enabled = true;
+        if(o.hasMember(CONF_HELM_ALIGNMENT_ENABLED)) {
+            alignment.enabled = o[CONF_HELM_ALIGNMENT_ENABLED];
+        }
+
+        alignment.margin = f_xmlrpc_number(
+            o, CONF_HELM_ALIGNMENT_MARGIN, alignment.margin);
+
+        alignment.phase_gain = f_xmlrpc_number(
+            o, CONF_HELM_ALIGNMENT_PHASE_GAIN, alignment.phase_gain);
+
+        alignment.period_gain = f_xmlrpc_number(
+            o, CONF_HELM_ALIGNMENT_PERIOD_GAIN, alignment.period_gain);
+    }
+
+    status_page_configuration_t status_page {
+        .enabled = false,
+        .name = ""
+    };
+
+    if(helm_config.hasMember(CONF_HELM_STATUS_PAGE)) {
+        auto& o = helm_config[CONF_HELM_STATUS_PAGE];
+
+        status_page.enabled = true;
+        if(o.hasMember(CONF_HELM_STATUS_PAGE_ENABLED)) {
+            status_page.enabled = o[CONF_HELM_STATUS_PAGE_ENABLED];
+        }
+
+        if(o.hasMember(CONF_HELM_STATUS_PAGE_NAME)) {
+            status_page.name =
+                static_cast<std::string>(o[CONF_HELM_STATUS_PAGE_NAME]);
+        }
+    }
+
+    failsafe_configuration_t failsafe {
+        .enabled = false,
+        .state = "",
+        .max_age = DEFAULT_FAILSAFE_MAX_AGE,
+        .set_point = {}
+    };
+
+    if(helm_config.hasMember(CONF_HELM_FAILSAFE)) {
+        auto& o = helm_config[CONF_HELM_FAILSAFE];
+
+        failsafe.enabled = true;
+        if(o.hasMember(CONF_HELM_FAILSAFE_ENABLED)) {
+            failsafe.enabled = o[CONF_HELM_FAILSAFE_ENABLED];
+        }
+
+        if(o.hasMember(CONF_HELM_FAILSAFE_STATE)) {
+            failsafe.state =
+                static_cast<std::string>(o[CONF_HELM_FAILSAFE_STATE]);
+        }
+
+        failsafe.max_age = f_xmlrpc_number(
+            o, CONF_HELM_FAILSAFE_MAX_AGE, failsafe.max_age);
+
+        if(o.hasMember(CONF_HELM_FAILSAFE_SET_POINT)) {
+            auto& sp = o[CONF_HELM_FAILSAFE_SET_POINT];
+            if(sp.getType() != XmlRpc::XmlRpcValue::TypeStruct) {
+                throw HelmException("'" +
+                    std::string(CONF_HELM_FAILSAFE_SET_POINT) +
+                    "' must be a map of DOF names to values!");
+            }
+
+            for(const auto& i : sp) {
+                failsafe.set_point[i.first] =
+                    f_xmlrpc_number(sp, i.first, 0.0);
+            }
+        }
+    }
+
+    standby_configuration_t standby {
+        .enabled = false,
+        .primary = "",
+        .missed_heartbeats = DEFAULT_STANDBY_MISSED_HEARTBEATS
+    };
+
+    if(helm_config.hasMember(CONF_HELM_STANDBY)) {
+        auto& o = helm_config[CONF_HELM_STANDBY];
+
+        standby.enabled = true;
+        if(o.hasMember(CONF_HELM_STANDBY_ENABLED)) {
+            standby.enabled = o[CONF_HELM_STANDBY_ENABLED];
+        }
+
+        if(o.hasMember(CONF_HELM_STANDBY_PRIMARY)) {
+            standby.primary =
+                static_cast<std::string>(o[CONF_HELM_STANDBY_PRIMARY]);
+        }
+
+        standby.missed_heartbeats = static_cast<int>(f_xmlrpc_number(
+            o, CONF_HELM_STANDBY_MISSED_HEARTBEATS,
+            standby.missed_heartbeats));
+    }
+
     m_op_helmconf_component(
         {
-            .frequency = static_cast<double>(helm_config[CONF_HELM_FREQ])
+            .frequency = f_xmlrpc_number(
+                helm_config, CONF_HELM_FREQ, DEFAULT_HELM_FREQ),
+            .overload = overload,
+            .shadow = shadow,
+            .energy = energy,
+            .alignment = alignment,
+            .status_page = status_page,
+            .failsafe = failsafe,
+            .standby = standby,
+            .time_budget = f_xmlrpc_number(
+                helm_config, CONF_HELM_TIME_BUDGET, DEFAULT_TIME_BUDGET),
+            .worker_threads = static_cast<int>(f_xmlrpc_number(
+                helm_config, CONF_HELM_WORKER_THREADS, DEFAULT_WORKER_THREADS))
         }
     );
 }
@@ -93,11 +348,17 @@ void Parser::f_parse_behavior_components() {
         }
 
 
+        bool critical = false;
+        if(bhv_list[i].hasMember(CONF_BHV_CRITICAL)) {
+            critical = bhv_list[i][CONF_BHV_CRITICAL];
+        }
+
         m_op_behavior_component(
             {
                 .name = bhv_list[i][CONF_BHV_NAME],
                 .plugin = bhv_list[i][CONF_BHV_PLUGIN],
-                .states = states
+                .states = states,
+                .critical = critical
             }
         );
     }
@@ -124,12 +385,23 @@ void Parser::f_parse_sm_components() {
             transitions.emplace_back(fsm_list[i][CONF_FSM_TRANSITIONS][j]);
         }
 
+        std::string timeout_to;
+        if(fsm_list[i].hasMember(CONF_FSM_TIMEOUT_TO)) {
+            timeout_to =
+                static_cast<std::string>(fsm_list[i][CONF_FSM_TIMEOUT_TO]);
+        }
+
         m_op_sm_component(
             {
                 .initial = initial,
                 .name = fsm_list[i][CONF_FSM_NAME],
                 .mode = fsm_list[i][CONF_FSM_MODE],
-                .transitions = transitions
+                .transitions = transitions,
+                .frequency = f_xmlrpc_number(
+                    fsm_list[i], CONF_FSM_FREQUENCY, 0.0),
+                .timeout = f_xmlrpc_number(
+                    fsm_list[i], CONF_FSM_TIMEOUT, 0.0),
+                .timeout_to = timeout_to
             }
         );
     }
@@ -92,6 +92,14 @@ namespace helm {
 
         Parser();
 
+        /**
+         * @brief Construct a parser that reads the configuration from a sub
+         *        namespace of the helm
+         *
+         * @param ns Namespace relative to the private namespace of the helm
+         */
+        explicit Parser(const std::string& ns);
+
         void initialize();
 
         void set_op_behavior_component(decltype(m_op_behavior_component));
@@ -0,0 +1,78 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#pragma once
+
+/**
+ * @brief USDT (SDT) static probes of the helm.
+ *
+ * Probes are compiled in when CMake finds `sys/sdt.h` (package
+ * `systemtap-sdt-dev`) and `HELM_USDT` option is enabled. Each probe is a
+ * single `nop` instruction until a tracer such as `perf` or `bpftrace`
+ * attaches to it, hence they are left in release builds. Probe arguments must
+ * be cheap to evaluate, they are computed even if nothing is attached.
+ *
+ * All the probes are under the `mvp_helm` provider:
+ *
+ *  - tick_start(tick)
+ *  - tick_end(tick)
+ *  - behavior_start(tick, name)
+ *  - behavior_end(tick, name, result)
+ *  - winner_change(dof, name, priority)
+ *  - state_transition(from, to, result)
+ *  - set_point_publish(tick, mode)
+ *  - failsafe_publish(mode)
+ *  - process_value_ingest(stamp_sec, stamp_nsec)
+ *  - overload_level(tick, level)
+ *
+ * Example scripts can be found in `mvp_helm/scripts/bpftrace`.
+ */
+
+#ifdef HELM_USDT_ENABLED
+
+#include "sys/sdt.h"
+
+#define HELM_PROBE0(name) \
+    DTRACE_PROBE(mvp_helm, name)
+
+#define HELM_PROBE1(name, a1) \
+    DTRACE_PROBE1(mvp_helm, name, a1)
+
+#define HELM_PROBE2(name, a1, a2) \
+    DTRACE_PROBE2(mvp_helm, name, a1, a2)
+
+#define HELM_PROBE3(name, a1, a2, a3) \
+    DTRACE_PROBE3(mvp_helm, name, a1, a2, a3)
+
+#else
+
+#define HELM_PROBE0(name) do {} while(0)
+
+#define HELM_PROBE1(name, a1) do {} while(0)
+
+#define HELM_PROBE2(name, a1, a2) do {} while(0)
+
+#define HELM_PROBE3(name, a1, a2, a3) do {} while(0)
+
+#endif
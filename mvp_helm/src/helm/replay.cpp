@@ -0,0 +1,360 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+/*******************************************************************************
+ * STD
+ */
+#include "algorithm"
+#include "chrono"
+#include "cmath"
+#include "cstring"
+#include "sstream"
+
+/*******************************************************************************
+ * ROS
+ */
+#include "rosbag/bag.h"
+#include "rosbag/view.h"
+#include "topic_tools/shape_shifter.h"
+
+/*******************************************************************************
+ * Helm
+ */
+#include "replay.h"
+#include "utils.h"
+
+using namespace helm;
+
+/**
+ * @brief Topics that are never replayed
+ */
+static const std::vector<std::string> IGNORED_TOPICS = {
+    "/rosout", "/rosout_agg", "/clock"
+};
+
+Replay::Replay(const std::string &bag_file, const std::string &live_helm,
+               double tolerance) {
+
+    m_bag_file = bag_file;
+
+    m_live_helm = live_helm;
+
+    m_live_ns = m_live_helm.substr(0, m_live_helm.rfind('/') + 1);
+
+    m_tolerance = tolerance;
+
+    m_report.ticks = 0;
+
+    m_report.mismatches = 0;
+
+    m_report.missing = 0;
+
+    m_report.max_error.fill(0);
+
+    m_report.first_mismatch = -1;
+
+    m_report.speed_up = 0;
+
+}
+
+std::string Replay::f_map_topic(const std::string &topic) {
+
+    // Private topics of the helm and its behaviors
+    if(topic.compare(0, m_live_helm.size() + 1, m_live_helm + "/") == 0) {
+        return ros::this_node::getName() + topic.substr(m_live_helm.size());
+    }
+
+    if(topic.compare(0, m_live_ns.size(), m_live_ns) == 0) {
+        return ros::names::append(
+            ros::this_node::getNamespace(), topic.substr(m_live_ns.size()));
+    }
+
+    return topic;
+}
+
+bool Replay::f_is_log_topic(const std::string &topic,
+                            const std::string &name) {
+
+    return topic == m_live_helm + "/log/" + name;
+
+}
+
+bool Replay::f_cb_get_modes(mvp_msgs::GetControlModes::Request &req,
+                            mvp_msgs::GetControlModes::Response &resp) {
+
+    resp.modes = m_controller_modes.modes;
+
+    return true;
+}
+
+void Replay::f_cb_set_point(const mvp_msgs::ControlProcess::ConstPtr &msg) {
+
+    m_outputs.emplace_back(*msg);
+
+}
+
+bool Replay::run() {
+
+    rosbag::Bag bag;
+    try {
+        bag.open(m_bag_file, rosbag::bagmode::Read);
+    } catch (const rosbag::BagException& e) {
+        std::cerr << m_bag_file << ": " << e.what() << std::endl;
+        return false;
+    }
+
+    auto set_point_topic = m_live_ns + "controller/process/set_point";
+
+    /**
+     * Collect the controller modes and the recorded set points first
+     */
+    std::vector<mvp_msgs::ControlProcess::ConstPtr> expected;
+
+    bool has_modes = false;
+
+    rosbag::View outputs(bag, rosbag::TopicQuery(std::vector<std::string>{
+        set_point_topic, m_live_helm + "/log/controller_modes"}));
+
+    for(const auto& m : outputs) {
+        if(m.getTopic() == set_point_topic) {
+            auto msg = m.instantiate<mvp_msgs::ControlProcess>();
+            if(msg) {
+                expected.emplace_back(msg);
+            }
+        } else if(!has_modes) {
+            auto msg = m.instantiate<mvp_msgs::ControlModes>();
+            if(msg) {
+                m_controller_modes = *msg;
+                has_modes = true;
+            }
+        }
+    }
+
+    if(expected.empty() || !has_modes) {
+        std::cerr << m_bag_file << ": log must contain '" << set_point_topic
+            << "' and '" << m_live_helm << "/log/controller_modes'"
+            << std::endl;
+        return false;
+    }
+
+    /**
+     * Inputs are every other topic
+     */
+    rosbag::View inputs(bag, [&](const rosbag::ConnectionInfo* c) {
+        return c->topic != set_point_topic &&
+            !f_is_log_topic(c->topic, "controller_modes") &&
+            !f_is_log_topic(c->topic, "tick") &&
+            !f_is_log_topic(c->topic, "path") &&
+            std::find(IGNORED_TOPICS.begin(), IGNORED_TOPICS.end(), c->topic)
+                == IGNORED_TOPICS.end();
+    });
+
+    m_nh.reset(new ros::NodeHandle());
+
+    // Simulated clock, nothing else sets it unless /use_sim_time is set
+    ros::Time::setNow(std::min(inputs.getBeginTime(),
+                               expected.front()->header.stamp));
+
+    /**
+     * Controller modes are served from a separate queue while the helm
+     * initializes, the global queue is only processed in the ticks.
+     */
+    ros::NodeHandle service_nh;
+    service_nh.setCallbackQueue(&m_service_queue);
+
+    auto modes_srv = service_nh.advertiseService(
+        "controller/get_modes", &Replay::f_cb_get_modes, this);
+
+    ros::AsyncSpinner spinner(1, &m_service_queue);
+    spinner.start();
+
+    m_helm.reset(new Helm());
+
+    m_helm->initialize();
+
+    spinner.stop();
+
+    modes_srv.shutdown();
+
+    m_sub_set_point = m_nh->subscribe(
+        "controller/process/set_point", 100, &Replay::f_cb_set_point, this);
+
+    /**
+     * Publishers are created once the helm has subscribed, then the
+     * connections within the process are made immediately.
+     */
+    for(const auto& c : inputs.getConnections()) {
+        if(f_is_log_topic(c->topic, "change_state") ||
+            f_is_log_topic(c->topic, "set_frequency") ||
+            m_publishers.count(c->topic)) {
+            continue;
+        }
+
+        auto latching = c->header->count("latching") ?
+            c->header->at("latching") : "0";
+
+        topic_tools::ShapeShifter s;
+        s.morph(c->md5sum, c->datatype, c->msg_def, latching);
+
+        m_publishers[c->topic] =
+            s.advertise(*m_nh, f_map_topic(c->topic), 100, latching == "1");
+    }
+
+    ros::getGlobalCallbackQueue()->callAvailable();
+
+    auto start = std::chrono::steady_clock::now();
+
+    size_t k = 0;
+    for(const auto& m : inputs) {
+        while(k < expected.size() && expected[k]->header.stamp < m.getTime()) {
+            f_tick(*expected[k++]);
+        }
+
+        f_input(m);
+    }
+
+    while(k < expected.size()) {
+        f_tick(*expected[k++]);
+    }
+
+    std::chrono::duration<double> wall =
+        std::chrono::steady_clock::now() - start;
+
+    auto duration = (expected.back()->header.stamp -
+        expected.front()->header.stamp).toSec();
+
+    m_report.speed_up = wall.count() > 0 ? duration / wall.count() : 0;
+
+    m_sub_set_point.shutdown();
+
+    m_publishers.clear();
+
+    m_helm.reset();
+
+    bag.close();
+
+    return true;
+}
+
+void Replay::f_input(const rosbag::MessageInstance &m) {
+
+    ros::Time::setNow(std::max(ros::Time::now(), m.getTime()));
+
+    const auto& topic = m.getTopic();
+
+    if(f_is_log_topic(topic, "change_state")) {
+        auto req = m.instantiate<mvp_msgs::ChangeStateRequest>();
+        if(req) {
+            mvp_msgs::ChangeStateResponse resp;
+            m_helm->f_cb_change_state(*req, resp);
+        }
+    } else if(f_is_log_topic(topic, "set_frequency")) {
+        auto req = m.instantiate<mvp_helm::SetHelmFrequencyRequest>();
+        if(req) {
+            mvp_helm::SetHelmFrequencyResponse resp;
+            m_helm->f_cb_set_frequency(*req, resp);
+        }
+    } else {
+        auto it = m_publishers.find(topic);
+        if(it != m_publishers.end()) {
+            it->second.publish(m.instantiate<topic_tools::ShapeShifter>());
+        }
+    }
+
+    ros::getGlobalCallbackQueue()->callAvailable();
+
+}
+
+void Replay::f_tick(const mvp_msgs::ControlProcess &expected) {
+
+    ros::Time::setNow(std::max(ros::Time::now(), expected.header.stamp));
+
+    ros::getGlobalCallbackQueue()->callAvailable();
+
+    m_outputs.clear();
+
+    m_helm->step();
+
+    // Delivers the set point of this tick to the subscriber
+    ros::getGlobalCallbackQueue()->callAvailable();
+
+    if(m_outputs.empty()) {
+        m_report.missing++;
+        if(m_report.first_mismatch < 0) {
+            m_report.first_mismatch = static_cast<long>(m_report.ticks);
+            m_report.first_mismatch_detail = "no set point is published";
+        }
+    } else {
+        f_compare(expected, m_outputs.back());
+    }
+
+    m_report.ticks++;
+
+}
+
+void Replay::f_compare(const mvp_msgs::ControlProcess &expected,
+                       const mvp_msgs::ControlProcess &actual) {
+
+    auto e = utils::control_process_to_array(expected);
+    auto a = utils::control_process_to_array(actual);
+
+    std::stringstream detail;
+
+    bool mismatch = false;
+
+    if(expected.control_mode != actual.control_mode) {
+        mismatch = true;
+        detail << "mode '" << expected.control_mode << "' != '"
+            << actual.control_mode << "' ";
+    }
+
+    for(size_t i = 0 ; i < e.size() ; i++) {
+        auto error = std::fabs(e[i] - a[i]);
+
+        bool differs = m_tolerance > 0 ?
+            !(error <= m_tolerance) :
+            std::memcmp(&e[i], &a[i], sizeof(double)) != 0;
+
+        if(std::isfinite(error)) {
+            m_report.max_error[i] = std::max(m_report.max_error[i], error);
+        }
+
+        if(differs) {
+            mismatch = true;
+            detail << DOF_NAMES[i] << " " << e[i] << " != " << a[i] << " ";
+        }
+    }
+
+    if(!mismatch) {
+        return;
+    }
+
+    m_report.mismatches++;
+
+    if(m_report.first_mismatch < 0) {
+        m_report.first_mismatch = static_cast<long>(m_report.ticks);
+        m_report.first_mismatch_detail = detail.str();
+    }
+
+}
@@ -0,0 +1,179 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#pragma once
+
+/*******************************************************************************
+ * STD
+ */
+#include "array"
+#include "deque"
+#include "map"
+#include "memory"
+#include "string"
+
+/*******************************************************************************
+ * ROS
+ */
+#include "ros/ros.h"
+#include "ros/callback_queue.h"
+#include "rosbag/message_instance.h"
+
+/*******************************************************************************
+ * Helm
+ */
+#include "helm.h"
+
+namespace helm {
+
+    /**
+     * @brief Replays a recorded log through the helm and compares set points
+     *
+     * The log is a bag recorded from a live helm. It must contain the set
+     * points, "controller/process/set_point", and the latched
+     * "~log/controller_modes" topic of the helm. Every other topic is an
+     * input: process values, waypoint updates, joystick and so on. Service
+     * requests of the helm are replayed from "~log/change_state" and
+     * "~log/set_frequency".
+     *
+     * Replay is in lock-step with a simulated clock. Each recorded set point
+     * is a tick: the clock is set to its stamp, inputs received until then
+     * are delivered, the helm executes a single iteration and its output is
+     * compared to the recorded one. Nothing waits for the wall clock, so a
+     * log replays as fast as the helm can iterate.
+     *
+     * Topics are moved from the namespace of the recorded helm to the
+     * namespace of this node, so that several replays can share a master.
+     * Topics outside of that namespace are published as they are.
+     */
+    class Replay {
+    public:
+
+        struct report_t {
+            //! @brief Number of recorded set points
+            size_t ticks;
+            //! @brief Ticks where the set point doesn't match
+            size_t mismatches;
+            //! @brief Ticks where helm didn't publish a set point
+            size_t missing;
+            //! @brief Largest absolute error of each DOF
+            std::array<double, 12> max_error;
+            //! @brief First mismatch, negative if there is none
+            long first_mismatch;
+            std::string first_mismatch_detail;
+            //! @brief Duration of the log over the wall time of the replay
+            double speed_up;
+        };
+
+    private:
+
+        std::string m_bag_file;
+
+        //! @brief Name of the helm node in the log, e.g. "/helm"
+        std::string m_live_helm;
+
+        //! @brief Namespace of the helm node in the log, ends with "/"
+        std::string m_live_ns;
+
+        /**
+         * @brief Largest error in a set point that is still a match
+         * Zero requires bit identical set points.
+         */
+        double m_tolerance;
+
+        ros::NodeHandlePtr m_nh;
+
+        std::shared_ptr<Helm> m_helm;
+
+        /**
+         * @brief Controller modes recorded by the helm
+         *
+         * They are served as "controller/get_modes" from a separate queue
+         * while the helm initializes.
+         */
+        mvp_msgs::ControlModes m_controller_modes;
+
+        ros::CallbackQueue m_service_queue;
+
+        //! @brief Publishers of the inputs, by recorded topic
+        std::map<std::string, ros::Publisher> m_publishers;
+
+        ros::Subscriber m_sub_set_point;
+
+        //! @brief Set points published by the helm since the last tick
+        std::deque<mvp_msgs::ControlProcess> m_outputs;
+
+        report_t m_report;
+
+        std::string f_map_topic(const std::string& topic);
+
+        bool f_is_log_topic(const std::string& topic, const std::string& name);
+
+        bool f_cb_get_modes(mvp_msgs::GetControlModes::Request& req,
+                            mvp_msgs::GetControlModes::Response& resp);
+
+        void f_cb_set_point(const mvp_msgs::ControlProcess::ConstPtr& msg);
+
+        /**
+         * @brief Delivers a recorded input to the helm
+         */
+        void f_input(const rosbag::MessageInstance& m);
+
+        /**
+         * @brief Executes the tick of a recorded set point and compares
+         */
+        void f_tick(const mvp_msgs::ControlProcess& expected);
+
+        void f_compare(const mvp_msgs::ControlProcess& expected,
+                       const mvp_msgs::ControlProcess& actual);
+
+    public:
+
+        typedef std::shared_ptr<Replay> Ptr;
+
+        /**
+         * @brief Construct a replay
+         *
+         * @param bag_file Recorded log
+         * @param live_helm Name of the helm node in the log
+         * @param tolerance Largest error in a set point that still matches
+         */
+        Replay(const std::string& bag_file, const std::string& live_helm,
+               double tolerance);
+
+        /**
+         * @brief Replay the log
+         *
+         * Helm is initialized from the parameters of this node. Must be
+         * called once.
+         *
+         * @return false if the log can't be replayed
+         */
+        bool run();
+
+        auto get_report() -> const decltype(m_report)& { return m_report; }
+
+    };
+
+}
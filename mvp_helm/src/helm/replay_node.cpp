@@ -0,0 +1,260 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+/*******************************************************************************
+ * STD
+ */
+#include "algorithm"
+#include "cstdlib"
+#include "iomanip"
+#include "iostream"
+#include "map"
+#include "sstream"
+#include "string"
+#include "thread"
+#include "vector"
+
+/*******************************************************************************
+ * POSIX
+ */
+#include "sys/wait.h"
+#include "unistd.h"
+
+/*******************************************************************************
+ * Helm
+ */
+#include "dictionary.h"
+#include "replay.h"
+
+/**
+ * Replays recorded logs through the helm and compares the set points.
+ *
+ * Usage:
+ *   rosrun mvp_helm helm_replay [-j jobs] [--helm /helm] [--tolerance 0]
+ *       log1.bag [log2.bag ...]
+ *
+ * Helm configuration is read from the private parameters of this node, see
+ * launch/replay.launch. Each log is replayed by a child process in its own
+ * namespace, up to "jobs" of them at the same time. Exit status is zero if
+ * the set points of all the logs match.
+ */
+
+namespace {
+
+    enum ExitStatus : int {
+        MATCH = 0,
+        MISMATCH = 1,
+        ERROR = 2
+    };
+
+    struct options_t {
+        std::vector<std::string> logs;
+        std::string live_helm = "/helm";
+        double tolerance = 0;
+        int jobs = 0;
+        //! @brief Log to replay in this process, only set for the children
+        std::string child;
+    };
+
+    bool parse_options(int argc, char* argv[], options_t* opts) {
+
+        for(int i = 1 ; i < argc ; i++) {
+            std::string arg = argv[i];
+
+            bool has_value = i + 1 < argc;
+
+            if(arg == "-j" && has_value) {
+                opts->jobs = std::atoi(argv[++i]);
+            } else if(arg == "--helm" && has_value) {
+                opts->live_helm = argv[++i];
+            } else if(arg == "--tolerance" && has_value) {
+                opts->tolerance = std::atof(argv[++i]);
+            } else if(arg == "--child" && has_value) {
+                opts->child = argv[++i];
+            } else if(!arg.empty() && arg[0] == '-') {
+                return false;
+            } else {
+                opts->logs.emplace_back(arg);
+            }
+        }
+
+        return !opts->logs.empty() || !opts->child.empty();
+    }
+
+    int run_child(const options_t& opts) {
+
+        helm::Replay replay(opts.child, opts.live_helm, opts.tolerance);
+
+        if(!replay.run()) {
+            return ERROR;
+        }
+
+        const auto& r = replay.get_report();
+
+        std::stringstream out;
+        out << opts.child << ": " << r.ticks << " ticks, " << r.mismatches
+            << " mismatched, " << r.missing << " missing, "
+            << std::setprecision(3) << r.speed_up << "x real time\n";
+
+        if(r.first_mismatch >= 0) {
+            out << "    first mismatch at tick " << r.first_mismatch << ": "
+                << r.first_mismatch_detail << "\n";
+            out << "    max error:";
+            for(const auto& e : r.max_error) {
+                out << " " << e;
+            }
+            out << "\n";
+        }
+
+        // Single write, the children share the terminal
+        std::cout << out.str() << std::flush;
+
+        return r.mismatches == 0 && r.missing == 0 ? MATCH : MISMATCH;
+    }
+
+    pid_t spawn_child(const options_t& opts, const std::string& log,
+                      const std::string& ns) {
+
+        std::vector<std::string> args = {
+            "helm_replay",
+            "--child", log,
+            "--helm", opts.live_helm,
+            "--tolerance", std::to_string(opts.tolerance),
+            "__name:=helm",
+            "__ns:=" + ns
+        };
+
+        std::vector<char*> argv;
+        for(auto& a : args) {
+            argv.emplace_back(&a[0]);
+        }
+        argv.emplace_back(nullptr);
+
+        auto pid = fork();
+        if(pid == 0) {
+            execv("/proc/self/exe", argv.data());
+            _exit(ERROR);
+        }
+
+        return pid;
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+
+    ros::init(argc, argv, "helm_replay");
+
+    options_t opts;
+    if(!parse_options(argc, argv, &opts)) {
+        std::cerr << "usage: helm_replay [-j jobs] [--helm /helm]"
+            " [--tolerance 0] log1.bag [log2.bag ...]" << std::endl;
+        return ERROR;
+    }
+
+    if(!opts.child.empty()) {
+        return run_child(opts);
+    }
+
+    /**
+     * Children read the configuration of this node from their own
+     * namespace. Everything that depends on the wall clock or on thread
+     * scheduling is turned off so that the replay is deterministic.
+     */
+    XmlRpc::XmlRpcValue conf;
+    if(!ros::param::get(ros::this_node::getName(), conf) ||
+        conf.getType() != XmlRpc::XmlRpcValue::TypeStruct ||
+        !conf.hasMember(helm::CONF_HELM)) {
+        std::cerr << "helm configuration is not found under "
+            << ros::this_node::getName() << std::endl;
+        return ERROR;
+    }
+
+    auto& helm_conf = conf[helm::CONF_HELM];
+    helm_conf[helm::CONF_HELM_WORKER_THREADS] = 0;
+    helm_conf[helm::CONF_HELM_OVERLOAD][helm::CONF_HELM_OVERLOAD_ENABLED] =
+        false;
+    helm_conf[helm::CONF_HELM_SHADOW][helm::CONF_HELM_SHADOW_ENABLED] = false;
+    helm_conf[helm::CONF_HELM_ALIGNMENT][helm::CONF_HELM_ALIGNMENT_ENABLED] =
+        false;
+    helm_conf[helm::CONF_HELM_STATUS_PAGE]
+        [helm::CONF_HELM_STATUS_PAGE_ENABLED] = false;
+    helm_conf[helm::CONF_HELM_STANDBY][helm::CONF_HELM_STANDBY_ENABLED] = false;
+
+    if(opts.jobs <= 0) {
+        opts.jobs = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::map<pid_t, std::string> running;
+
+    size_t next = 0;
+    size_t failed = 0;
+
+    while(next < opts.logs.size() || !running.empty()) {
+
+        if(next < opts.logs.size() &&
+            running.size() < static_cast<size_t>(opts.jobs)) {
+            auto ns = "/helm_replay_" + std::to_string(getpid()) + "_" +
+                std::to_string(next);
+
+            ros::param::set(ns + "/helm", conf);
+
+            auto pid = spawn_child(opts, opts.logs[next], ns);
+            if(pid < 0) {
+                std::cerr << opts.logs[next] << ": can't start the replay"
+                    << std::endl;
+                ros::param::del(ns);
+                failed++;
+            } else {
+                running[pid] = ns;
+            }
+
+            next++;
+            continue;
+        }
+
+        int status;
+        auto pid = waitpid(-1, &status, 0);
+        if(pid < 0) {
+            break;
+        }
+
+        auto it = running.find(pid);
+        if(it == running.end()) {
+            continue;
+        }
+
+        ros::param::del(it->second);
+        running.erase(it);
+
+        if(!WIFEXITED(status) || WEXITSTATUS(status) != MATCH) {
+            failed++;
+        }
+    }
+
+    std::cout << opts.logs.size() - failed << " of " << opts.logs.size()
+        << " logs match" << std::endl;
+
+    return failed == 0 ? MATCH : MISMATCH;
+}
@@ -0,0 +1,377 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#include "shadow.h"
+
+#include "algorithm"
+#include "array"
+#include "chrono"
+#include "functional"
+
+#include "pthread.h"
+#include "sched.h"
+#include "sys/resource.h"
+#include "sys/syscall.h"
+#include "unistd.h"
+
+#include "utils.h"
+
+using namespace helm;
+
+Shadow::Shadow(const std::string& ns, int cpu) : HelmObj() {
+
+    m_namespace = ns;
+
+    m_cpu = cpu;
+
+    m_helm_freq = DEFAULT_HELM_FREQ;
+
+    m_live_freq = DEFAULT_HELM_FREQ;
+
+    m_fresh = false;
+
+    m_stop = false;
+
+}
+
+Shadow::~Shadow() {
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_cv.notify_all();
+
+    if(m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    m_pub_set_point.shutdown();
+
+}
+
+void Shadow::initialize(double helm_freq) {
+
+    m_helm_freq = helm_freq;
+
+    m_live_freq = helm_freq;
+
+    m_parser.reset(new Parser(m_namespace));
+
+    m_state_machine.reset(new StateMachine());
+
+    m_timing_wheel.reset(new TimingWheel(DEFAULT_TIMER_RESOLUTION));
+
+    m_now = ros::Time::now().toSec();
+
+    m_parser->set_op_behavior_component(std::bind(
+        &Shadow::f_generate_behaviors, this, std::placeholders::_1
+    ));
+
+    m_parser->set_op_sm_component(std::bind(
+        &Shadow::f_generate_sm_states, this, std::placeholders::_1
+    ));
+
+    // Shadow runs with the configuration of the live helm
+    m_parser->set_op_helmconf_component([](const helm_configuration_t&){});
+
+    m_parser->initialize();
+
+    m_state_machine->initialize();
+
+    for(const auto& i : m_behavior_containers) {
+
+        i->set_callback_queue(&m_callback_queue);
+
+        i->initialize();
+
+        i->get_behavior()->f_change_state =
+            std::bind(&Shadow::f_change_state, this, std::placeholders::_1);
+
+        i->get_behavior()->f_schedule_timer =
+            [this](double delay, std::function<void()> callback,
+                   double period) {
+                return m_timing_wheel->schedule(m_now,
+                    delay, std::move(callback), period);
+            };
+
+        i->get_behavior()->f_cancel_timer =
+            std::bind(&TimingWheel::cancel, m_timing_wheel.get(),
+                std::placeholders::_1);
+
+        // Paths stay within the shadow mission
+        i->get_behavior()->f_send_path =
+            [this](const std::string& behavior, const std::string& frame_id,
+                   const std::vector<double>& x,
+                   const std::vector<double>& y) {
+                for(const auto& c : m_behavior_containers) {
+                    if(c->get_opts().name == m_namespace + "/" + behavior) {
+                        return c->get_behavior()->path_received(
+                            frame_id, x, y);
+                    }
+                }
+                return false;
+            };
+
+        i->get_behavior()->m_helm_frequency = m_helm_freq;
+
+        // Shadow must stay cheap
+        i->get_behavior()->m_visualization_enabled = false;
+    }
+
+    m_pub_set_point = m_pnh->advertise<mvp_msgs::ControlProcess>(
+        m_namespace + "/set_point", 100);
+
+}
+
+void Shadow::set_controller_modes(const mvp_msgs::ControlModes& modes) {
+
+    m_controller_modes = modes;
+
+}
+
+void Shadow::start() {
+
+    m_thread = std::thread([this] { f_loop(); });
+
+}
+
+bool Shadow::offer(const mvp_msgs::ControlProcess::ConstPtr& process_values,
+                   const std::string& live_state,
+                   const ros::Time& stamp,
+                   double helm_freq) {
+
+    std::unique_lock<std::mutex> lock(m_mutex, std::try_to_lock);
+
+    if(!lock.owns_lock()) {
+        return false;
+    }
+
+    m_process_values = process_values;
+    m_live_state = live_state;
+    m_stamp = stamp;
+    m_live_freq = helm_freq;
+    m_fresh = true;
+
+    lock.unlock();
+
+    m_cv.notify_one();
+
+    return true;
+}
+
+void Shadow::f_generate_behaviors(const behavior_component_t& component) {
+
+    /**
+     * Behaviors of the shadow use "<namespace>/<name>" as their name so that
+     * their parameters and topics don't collide with the live ones.
+     */
+    auto c = component;
+    c.name = m_namespace + "/" + component.name;
+
+    m_behavior_containers.emplace_back(std::make_shared<BehaviorContainer>(c));
+
+}
+
+void Shadow::f_generate_sm_states(const sm_state_t& state) {
+
+    m_state_machine->append_state(state);
+
+}
+
+void Shadow::f_set_frequency(double helm_freq) {
+
+    if(helm_freq == m_helm_freq) {
+        return;
+    }
+
+    m_helm_freq = helm_freq;
+
+    for(const auto& i : m_behavior_containers) {
+        i->get_behavior()->m_helm_frequency = m_helm_freq;
+
+        i->get_behavior()->helm_frequency_changed(m_helm_freq);
+    }
+
+}
+
+bool Shadow::f_change_state(const std::string& name) {
+
+    return m_state_machine->translate_to(name);
+
+}
+
+void Shadow::f_loop() {
+
+    /**
+     * Shadow work must never compete with the live helm.
+     */
+    if(setpriority(PRIO_PROCESS,
+        static_cast<id_t>(syscall(SYS_gettid)), 19) != 0) {
+        ROS_WARN_STREAM("Can not lower the priority of the shadow helm");
+    }
+
+    if(m_cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(m_cpu, &set);
+        if(pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+            ROS_WARN_STREAM("Can not pin the shadow helm to cpu " << m_cpu);
+        }
+    }
+
+    while(true) {
+
+        mvp_msgs::ControlProcess::ConstPtr process_values;
+        std::string live_state;
+        ros::Time stamp;
+        double helm_freq;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            /**
+             * Wakes up now and then to serve the callbacks even if the live
+             * helm stops offering snapshots
+             */
+            m_cv.wait_for(lock, std::chrono::milliseconds(100),
+                [this] { return m_stop || m_fresh; });
+
+            if(m_stop) {
+                return;
+            }
+
+            if(!m_fresh) {
+                lock.unlock();
+                m_callback_queue.callAvailable();
+                continue;
+            }
+
+            process_values = m_process_values;
+            live_state = m_live_state;
+            stamp = m_stamp;
+            helm_freq = m_live_freq;
+            m_fresh = false;
+        }
+
+        if(process_values == nullptr) {
+            continue;
+        }
+
+        m_callback_queue.callAvailable();
+
+        try {
+            f_set_frequency(helm_freq);
+
+            f_iterate(*process_values, live_state, stamp);
+        } catch (const std::exception& e) {
+            ROS_ERROR_STREAM_THROTTLE(10, "Shadow helm failed: " << e.what());
+        }
+    }
+
+}
+
+void Shadow::f_iterate(const mvp_msgs::ControlProcess& process_values,
+                       const std::string& live_state,
+                       const ros::Time& stamp) {
+
+    /**
+     * Follow the state transitions of the live helm if the shadow mission
+     * has the same state.
+     */
+    if(live_state != m_followed_state) {
+        m_followed_state = live_state;
+        m_state_machine->set_active_state(live_state);
+    }
+
+    // Timers fire at the time of the live tick that is evaluated
+    m_now = stamp.toSec();
+    m_timing_wheel->advance(m_now);
+
+    auto active_state = m_state_machine->get_active_state();
+
+    auto active_mode = std::find_if(
+        m_controller_modes.modes.begin(),
+        m_controller_modes.modes.end(),
+        [active_state](const mvp_msgs::ControlMode& mode){
+            return mode.name == active_state.mode;
+        }
+    );
+
+    if(active_mode == std::end(m_controller_modes.modes)) {
+        return;
+    }
+
+    std::vector<int> dofs(active_mode->dofs.begin(), active_mode->dofs.end());
+
+    std::array<double, 12> dof_ctrl{};
+    std::array<int, 12> dof_priority{};
+
+    for(const auto& i : m_behavior_containers) {
+
+        i->get_behavior()->m_active_dofs = dofs;
+
+        i->get_behavior()->m_process_values = process_values;
+
+        const auto& opts = i->get_opts();
+
+        bool pass = false;
+        if(!opts.states.count(active_state.name)) {
+            i->get_behavior()->f_disable();
+            pass = true;
+        } else {
+            i->get_behavior()->f_activate();
+        }
+
+        // Shadow has the whole period for itself
+        i->get_behavior()->m_deadline = std::chrono::steady_clock::now() +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(1.0 / m_helm_freq));
+
+        mvp_msgs::ControlProcess set_point;
+        if(!i->request_set_point(&set_point) || pass) {
+            continue;
+        }
+
+        auto priority = opts.states.at(active_state.name);
+
+        auto bhv_control_array = utils::control_process_to_array(set_point);
+
+        for(const auto& dof : i->get_behavior()->get_dofs()) {
+            if(priority > dof_priority[dof]) {
+                dof_ctrl[dof] = bhv_control_array[dof];
+                dof_priority[dof] = priority;
+            }
+        }
+    }
+
+    auto msg = utils::array_to_control_process_msg(dof_ctrl);
+
+    msg.control_mode = active_state.mode;
+    msg.header.stamp = stamp;
+
+    m_pub_set_point.publish(msg);
+
+}
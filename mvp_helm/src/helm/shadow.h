@@ -0,0 +1,201 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#pragma once
+
+/*******************************************************************************
+ * STD
+ */
+#include "condition_variable"
+#include "memory"
+#include "mutex"
+#include "string"
+#include "thread"
+#include "vector"
+
+/*******************************************************************************
+ * ROS
+ */
+#include "ros/ros.h"
+#include "ros/callback_queue.h"
+
+#include "mvp_msgs/ControlModes.h"
+#include "mvp_msgs/ControlProcess.h"
+
+/*******************************************************************************
+ * Helm
+ */
+#include "behavior_container.h"
+#include "obj.h"
+#include "parser.h"
+#include "sm.h"
+#include "timing_wheel.h"
+
+namespace helm {
+
+    /**
+     * @brief Shadow helm evaluates an alternative mission configuration
+     *
+     * Shadow mission is read from a sub namespace of the helm, e.g.
+     * "/helm/shadow/finite_state_machine" and "/helm/shadow/behaviors".
+     * Parameters of a shadow behavior named "bhv00" are read from
+     * "/helm/shadow/bhv00".
+     *
+     * Every iteration, the live helm offers its process snapshot to the
+     * shadow. Shadow evaluates its behaviors in its own low priority thread,
+     * optionally pinned to a spare core, and publishes the resulting set point
+     * to "~<namespace>/set_point" with the same stamp as the live set point.
+     * Shadow set points never reach the low level controller.
+     */
+    class Shadow : public HelmObj {
+    private:
+
+        //! @brief Namespace of the shadow mission
+        std::string m_namespace;
+
+        //! @brief CPU core that the shadow thread is pinned to, -1 for any
+        int m_cpu;
+
+        double m_helm_freq;
+
+        Parser::Ptr m_parser;
+
+        StateMachine::Ptr m_state_machine;
+
+        std::vector<BehaviorContainer::Ptr> m_behavior_containers;
+
+        //! @brief Timers of the shadow behaviors, advanced on each snapshot
+        TimingWheel::Ptr m_timing_wheel;
+
+        /**
+         * @brief Stamp of the last snapshot in seconds, the clock of the
+         *        shadow timers
+         */
+        double m_now;
+
+        /**
+         * @brief Callbacks of the shadow behaviors, served by the shadow
+         *        thread so that they never run on the spin thread of the
+         *        live helm
+         */
+        ros::CallbackQueue m_callback_queue;
+
+        mvp_msgs::ControlModes m_controller_modes;
+
+        //! @brief Publisher for the would-be set points
+        ros::Publisher m_pub_set_point;
+
+        /***********************************************************************
+         * Snapshot handed over by the live helm
+         */
+
+        std::mutex m_mutex;
+
+        std::condition_variable m_cv;
+
+        mvp_msgs::ControlProcess::ConstPtr m_process_values;
+
+        std::string m_live_state;
+
+        ros::Time m_stamp;
+
+        double m_live_freq;
+
+        bool m_fresh;
+
+        bool m_stop;
+
+        std::thread m_thread;
+
+        //! @brief Last live state that shadow followed
+        std::string m_followed_state;
+
+        void f_generate_behaviors(const behavior_component_t& component);
+
+        void f_generate_sm_states(const sm_state_t& state);
+
+        /**
+         * @brief Follows the frequency of the live helm
+         */
+        void f_set_frequency(double helm_freq);
+
+        bool f_change_state(const std::string& name);
+
+        void f_loop();
+
+        /**
+         * @brief Evaluates the shadow behaviors on a snapshot
+         */
+        void f_iterate(const mvp_msgs::ControlProcess& process_values,
+                       const std::string& live_state,
+                       const ros::Time& stamp);
+
+    public:
+
+        typedef std::shared_ptr<Shadow> Ptr;
+
+        /**
+         * @brief Construct a new Shadow object
+         *
+         * @param ns Namespace of the shadow mission under the helm
+         * @param cpu CPU core to run on, -1 to let the scheduler decide
+         */
+        Shadow(const std::string& ns, int cpu);
+
+        ~Shadow();
+
+        /**
+         * @brief Parse the shadow mission and initialize its behaviors
+         *
+         * @param helm_freq Frequency of the live helm
+         */
+        void initialize(double helm_freq);
+
+        void set_controller_modes(const mvp_msgs::ControlModes& modes);
+
+        /**
+         * @brief Start the shadow thread
+         */
+        void start();
+
+        /**
+         * @brief Hand a snapshot over to the shadow
+         *
+         * This function never blocks. If the shadow is busy picking up the
+         * previous snapshot, the new one is dropped.
+         *
+         * @param process_values Process values used by the live iteration
+         * @param live_state Active state of the live helm
+         * @param stamp Stamp of the live set point
+         * @param helm_freq Frequency of the live helm
+         * @return true if the snapshot is accepted
+         */
+        bool offer(const mvp_msgs::ControlProcess::ConstPtr& process_values,
+                   const std::string& live_state,
+                   const ros::Time& stamp,
+                   double helm_freq);
+
+    };
+
+}
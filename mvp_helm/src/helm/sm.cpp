@@ -27,19 +27,28 @@
 
 using namespace helm;
 
+auto StateMachine::f_find_state(const std::string& name) const
+    -> std::vector<sm_state_t>::const_iterator
+{
+    return std::find_if(
+        m_states.begin(),
+        m_states.end(),
+        [&name](const sm_state_t& val) {
+            return val.name == name;
+        }
+    );
+}
+
 void StateMachine::append_state(const sm_state_t& state) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_states.emplace_back(state);
 }
 
 auto StateMachine::translate_to(const std::string& state_name) -> bool {
 
-    auto state_idx = std::find_if(
-        m_states.begin(),
-        m_states.end(),
-        [state_name](const sm_state_t& val) {
-            return val.name == state_name;
-        }
-    );
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto state_idx = f_find_state(state_name);
 
     auto transition_idx = std::find_if(
         m_active_state.transitions.begin(),
@@ -63,12 +72,34 @@ auto StateMachine::translate_to(const std::string& state_name) -> bool {
 
 }
 
+auto StateMachine::set_active_state(const std::string& state_name) -> bool {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto state_idx = f_find_state(state_name);
+    if(state_idx == m_states.end()) {
+        return false;
+    }
+
+    m_active_state = *state_idx;
+
+    return true;
+}
+
 auto StateMachine::get_active_state() -> decltype(m_active_state) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     return m_active_state;
 }
 
+auto StateMachine::get_states() -> decltype(m_states) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_states;
+}
+
 void StateMachine::initialize() {
 
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     auto initial_state = std::find_if(
         m_states.begin(),
         m_states.end(),
@@ -89,13 +120,9 @@ void StateMachine::initialize() {
 auto StateMachine::get_state(const std::string &name,
                              sm_state_t *state) -> bool {
 
-    auto state_idx = std::find_if(
-        m_states.begin(),
-        m_states.end(),
-        [name](const sm_state_t& val) {
-            return val.name == name;
-        }
-    );
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto state_idx = f_find_state(name);
 
     if(state_idx != m_states.end()) {
         *state = *state_idx;
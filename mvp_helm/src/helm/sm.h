@@ -31,6 +31,7 @@
 #include "map"
 #include "memory"
 #include "cinttypes"
+#include "mutex"
 #include "vector"
 
 /*******************************************************************************
@@ -40,13 +41,25 @@
 
 namespace helm {
 
+    /**
+     * @brief Finite state machine of the mission
+     *
+     * Thread safe. The helm thread reads the active state every iteration
+     * while the failsafe and the service requests change it from the other
+     * threads.
+     */
     class StateMachine {
     private:
 
+        mutable std::mutex m_mutex;
+
         std::vector<sm_state_t> m_states;
 
         sm_state_t m_active_state;
 
+        auto f_find_state(const std::string& name) const
+            -> std::vector<sm_state_t>::const_iterator;
+
     public:
 
         typedef std::shared_ptr<StateMachine> Ptr;
@@ -59,11 +72,19 @@ namespace helm {
 
         auto translate_to(const std::string& state_name) -> bool;
 
+        /**
+         * @brief Activates a state without checking the transitions
+         *
+         * @param state_name
+         * @return false if there is no such state
+         */
+        auto set_active_state(const std::string& state_name) -> bool;
+
         auto get_active_state() -> decltype(m_active_state);
 
         auto get_state(const std::string &name, sm_state_t *state) -> bool;
 
-        auto get_states() -> decltype(m_states) { return m_states; }
+        auto get_states() -> decltype(m_states);
 
     };
 }
\ No newline at end of file
@@ -0,0 +1,97 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#include "standby.h"
+
+using namespace helm;
+
+Standby::Standby(const standby_configuration_t& conf) {
+
+    m_conf = conf;
+
+    m_reader = nullptr;
+
+    m_status.reset(new helm_status_t());
+
+    m_buffer.reset(new helm_status_t());
+
+    m_sequence = 0;
+
+    m_read = false;
+
+    m_alive = false;
+
+    m_last_beat = std::chrono::steady_clock::now();
+
+}
+
+Standby::~Standby() {
+
+    helm_status_close(m_reader);
+
+}
+
+bool Standby::update() {
+
+    auto now = std::chrono::steady_clock::now();
+
+    /**
+     * Primary may not have created its page yet
+     */
+    if(m_reader == nullptr) {
+        m_reader = helm_status_open(m_conf.primary.c_str());
+    }
+
+    if(m_reader != nullptr &&
+        helm_status_sequence(m_reader) != m_sequence) {
+
+        auto sequence = helm_status_sequence(m_reader);
+
+        auto result = helm_status_read(m_reader, m_buffer.get());
+
+        if(result == HELM_STATUS_STOPPED && m_alive) {
+            return false;
+        }
+
+        if(result == HELM_STATUS_OK) {
+            if(m_read && m_buffer->tick != m_status->tick) {
+                m_alive = true;
+                m_last_beat = now;
+            }
+
+            m_read = true;
+            m_sequence = sequence;
+
+            std::swap(m_status, m_buffer);
+        }
+    }
+
+    if(!m_alive || m_status->frequency <= 0) {
+        return true;
+    }
+
+    std::chrono::duration<double> silence = now - m_last_beat;
+
+    return silence.count() * m_status->frequency <= m_conf.missed_heartbeats;
+
+}
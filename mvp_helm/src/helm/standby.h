@@ -0,0 +1,113 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#pragma once
+
+/*******************************************************************************
+ * STD
+ */
+#include "chrono"
+#include "memory"
+
+/*******************************************************************************
+ * Helm
+ */
+#include "dictionary.h"
+#include "mvp_helm/status_page.h"
+
+namespace helm {
+
+    /**
+     * @brief Follows the status page of a primary helm
+     *
+     * A standby helm runs the same mission but doesn't publish set points. It
+     * reads the status page of the primary every tick and mirrors its state,
+     * the activity and the checkpoints of its behaviors and its last
+     * arbitration. Each iteration of the primary is a heartbeat. Once the
+     * primary misses #standby_configuration_t::missed_heartbeats of them, or
+     * it exits, the standby takes over.
+     *
+     * Primary pays nothing more than writing its status page. A standby only
+     * copies the page when its sequence changes.
+     */
+    class Standby {
+    private:
+
+        standby_configuration_t m_conf;
+
+        helm_status_reader_t* m_reader;
+
+        //! @brief Last consistent status of the primary
+        std::unique_ptr<helm_status_t> m_status;
+
+        //! @brief Status is read into this first, it may be torn
+        std::unique_ptr<helm_status_t> m_buffer;
+
+        //! @brief Sequence of the page when it was last read
+        uint64_t m_sequence;
+
+        //! @brief True once a status is read
+        bool m_read;
+
+        /**
+         * @brief True once the primary is seen ticking
+         * A page that is left by a primary that crashed before the standby
+         * started doesn't count.
+         */
+        bool m_alive;
+
+        std::chrono::steady_clock::time_point m_last_beat;
+
+    public:
+
+        typedef std::shared_ptr<Standby> Ptr;
+
+        explicit Standby(const standby_configuration_t& conf);
+
+        ~Standby();
+
+        Standby(const Standby&) = delete;
+
+        Standby& operator=(const Standby&) = delete;
+
+        /**
+         * @brief Reads the status of the primary if it changed
+         *
+         * @return false if the primary missed its heartbeats or exited, the
+         *         standby should take over
+         */
+        bool update();
+
+        /**
+         * @brief Whether the primary is seen ticking and the status is valid
+         */
+        bool is_synced() { return m_alive; }
+
+        /**
+         * @brief Last consistent status of the primary
+         */
+        const helm_status_t& get_status() { return *m_status; }
+
+    };
+
+}
@@ -0,0 +1,163 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+/*******************************************************************************
+ * STD
+ */
+#include "cerrno"
+#include "cstring"
+#include "utility"
+
+/*******************************************************************************
+ * POSIX
+ */
+#include "fcntl.h"
+#include "signal.h"
+#include "sys/mman.h"
+#include "unistd.h"
+
+/*******************************************************************************
+ * Helm
+ */
+#include "status_page.h"
+
+#include "exception.h"
+
+using namespace helm;
+
+StatusPage::StatusPage(std::string name)
+    : m_name(std::move(name)), m_fd(-1), m_page(nullptr), m_sequence(0) {
+
+    m_fd = shm_open(m_name.c_str(), O_CREAT | O_RDWR, 0644);
+    if(m_fd < 0) {
+        throw HelmException("can not open shared memory " + m_name + ": " +
+            std::strerror(errno));
+    }
+
+    if(ftruncate(m_fd, sizeof(helm_status_page_t)) < 0) {
+        auto e = errno;
+        close(m_fd);
+        throw HelmException("can not resize shared memory " + m_name + ": " +
+            std::strerror(e));
+    }
+
+    auto addr = mmap(nullptr, sizeof(helm_status_page_t),
+        PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if(addr == MAP_FAILED) {
+        auto e = errno;
+        close(m_fd);
+        throw HelmException("can not map shared memory " + m_name + ": " +
+            std::strerror(e));
+    }
+
+    m_page = static_cast<helm_status_page_t*>(addr);
+
+    /**
+     * A page left by a previous run is reused. Readers reject it while the
+     * magic is cleared, the sequence continues from where it was so that a
+     * reader polling the sequence sees a change.
+     */
+    __atomic_store_n(&m_page->magic, 0u, __ATOMIC_RELAXED);
+
+    m_sequence = __atomic_load_n(&m_page->sequence, __ATOMIC_RELAXED);
+    m_sequence += m_sequence & 1u;
+
+    __atomic_store_n(&m_page->sequence, m_sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    /**
+     * Helm that took over keeps this one idle until it exits. A page of
+     * another version may hold anything in place of the mark.
+     */
+    auto owner = __atomic_load_n(&m_page->owner_pid, __ATOMIC_ACQUIRE);
+    if(m_page->version != HELM_STATUS_VERSION) {
+        clear_owner();
+        m_page->takeovers = 0;
+    } else if(owner == getpid() ||
+        (owner != 0 && kill(owner, 0) < 0 && errno == ESRCH)) {
+        clear_owner();
+    }
+
+    m_page->version = HELM_STATUS_VERSION;
+    m_page->size = sizeof(helm_status_page_t);
+    m_page->pid = static_cast<int32_t>(getpid());
+    std::memset(&m_page->status, 0, sizeof(helm_status_t));
+
+    m_sequence += 2;
+    __atomic_store_n(&m_page->sequence, m_sequence, __ATOMIC_RELEASE);
+
+    __atomic_store_n(&m_page->magic, HELM_STATUS_MAGIC, __ATOMIC_RELEASE);
+
+}
+
+StatusPage::~StatusPage() {
+
+    __atomic_store_n(&m_page->pid, 0, __ATOMIC_RELEASE);
+
+    munmap(m_page, sizeof(helm_status_page_t));
+
+    close(m_fd);
+
+}
+
+helm_status_t* StatusPage::begin() {
+
+    __atomic_store_n(&m_page->sequence, m_sequence + 1, __ATOMIC_RELAXED);
+
+    /**
+     * Writes to the status must not be seen before the odd sequence
+     */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    return &m_page->status;
+
+}
+
+void StatusPage::commit() {
+
+    m_sequence += 2;
+
+    __atomic_store_n(&m_page->sequence, m_sequence, __ATOMIC_RELEASE);
+
+}
+
+int32_t StatusPage::get_owner(std::string* owner) const {
+
+    auto pid = __atomic_load_n(&m_page->owner_pid, __ATOMIC_ACQUIRE);
+
+    if(pid != 0) {
+        owner->assign(m_page->owner,
+            strnlen(m_page->owner, HELM_STATUS_NAME_LENGTH));
+    }
+
+    return pid;
+
+}
+
+void StatusPage::clear_owner() {
+
+    __atomic_store_n(&m_page->owner_pid, 0, __ATOMIC_RELEASE);
+
+    std::memset(m_page->owner, 0, HELM_STATUS_NAME_LENGTH);
+
+}
@@ -0,0 +1,124 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#pragma once
+
+/*******************************************************************************
+ * STD
+ */
+#include "algorithm"
+#include "cstring"
+#include "memory"
+#include "string"
+
+/*******************************************************************************
+ * MVP
+ */
+#include "mvp_helm/status_page.h"
+
+namespace helm {
+
+    /**
+     * @brief Writer of the shared memory status page
+     *
+     * Layout and the reader are in "mvp_helm/status_page.h". Helm is the
+     * only writer, it fills the status between #StatusPage::begin and
+     * #StatusPage::commit. The shared memory object is not removed when the
+     * helm exits so that the readers can stay attached across restarts.
+     */
+    class StatusPage {
+    private:
+
+        std::string m_name;
+
+        int m_fd;
+
+        helm_status_page_t* m_page;
+
+        uint64_t m_sequence;
+
+    public:
+
+        typedef std::shared_ptr<StatusPage> Ptr;
+
+        /**
+         * @brief Creates or opens the shared memory object and maps it
+         *
+         * @param name Name of the shared memory object, starts with '/'
+         * @throw HelmException if the object can't be created or mapped
+         */
+        explicit StatusPage(std::string name);
+
+        ~StatusPage();
+
+        StatusPage(const StatusPage&) = delete;
+
+        StatusPage& operator=(const StatusPage&) = delete;
+
+        /**
+         * @brief Starts writing the status
+         *
+         * Readers retry until #StatusPage::commit is called.
+         *
+         * @return Status in the shared memory
+         */
+        helm_status_t* begin();
+
+        /**
+         * @brief Publishes the status written since #StatusPage::begin
+         */
+        void commit();
+
+        auto get_name() -> decltype(m_name) { return m_name; }
+
+        /**
+         * @brief Helm that took over from this one, see
+         *        helm_status_take_over
+         *
+         * Mark left on the page is kept across a restart while that helm is
+         * still running.
+         *
+         * @param owner Output, status page of that helm, empty if it has none
+         * @return Process id of that helm, 0 if no helm took over
+         */
+        int32_t get_owner(std::string* owner) const;
+
+        /**
+         * @brief Removes the mark of the helm that took over
+         */
+        void clear_owner();
+
+        /**
+         * @brief Copies a string into a fixed size field, truncating it
+         */
+        template <size_t N>
+        static void set_string(char (&field)[N], const std::string& value) {
+            auto n = std::min(value.size(), N - 1);
+            std::memcpy(field, value.data(), n);
+            field[n] = '\0';
+        }
+
+    };
+
+}
@@ -0,0 +1,224 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#include "tick_scheduler.h"
+
+#include "algorithm"
+#include "cmath"
+
+using namespace helm;
+
+/**
+ * @brief Samples that the period is first estimated from
+ */
+static constexpr int LOCK_SAMPLES = 10;
+
+/**
+ * @brief Loop is locked while the phase error stays below this fraction of
+ *        the sample period.
+ */
+static constexpr double LOCK_ERROR = 0.1;
+
+/**
+ * @brief Loop restarts if no sample arrives for this many sample periods
+ */
+static constexpr double LOCK_TIMEOUT = 5.0;
+
+TickScheduler::TickScheduler() {
+
+    m_conf.enabled = false;
+
+    m_period = 1.0 / DEFAULT_HELM_FREQ;
+
+    m_nominal = 0;
+
+    m_last_tick = 0;
+
+    m_sample_period = 0;
+
+    m_reference = 0;
+
+    m_first_sample = 0;
+
+    m_last_sample = 0;
+
+    m_error = 0;
+
+    m_samples = 0;
+
+    m_locked = false;
+
+}
+
+void TickScheduler::configure(const alignment_configuration_t &conf,
+                              double period) {
+
+    m_conf = conf;
+
+    m_conf.margin = std::max(m_conf.margin, 0.0);
+
+    m_conf.phase_gain = std::min(std::max(m_conf.phase_gain, 0.0), 1.0);
+
+    m_conf.period_gain = std::min(std::max(m_conf.period_gain, 0.0), 1.0);
+
+    m_period = period;
+
+    m_nominal = 0;
+
+}
+
+void TickScheduler::set_period(double period) {
+
+    m_period = period;
+
+    m_nominal = 0;
+
+}
+
+void TickScheduler::f_restart(double t) {
+
+    m_reference = t;
+
+    m_first_sample = t;
+
+    m_last_sample = t;
+
+    m_sample_period = 0;
+
+    m_error = 0;
+
+    m_samples = 1;
+
+    m_locked = false;
+
+}
+
+void TickScheduler::sample(double t) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(m_samples == 0 || (m_sample_period > 0 &&
+        t - m_last_sample > LOCK_TIMEOUT * m_sample_period)) {
+        f_restart(t);
+        return;
+    }
+
+    // Period is first estimated as the mean interval of a few samples
+    if(m_samples < LOCK_SAMPLES) {
+        m_samples++;
+        m_sample_period = (t - m_first_sample) / (m_samples - 1);
+        m_error = m_sample_period;
+        m_reference = t;
+        m_last_sample = t;
+        return;
+    }
+
+    if(m_sample_period <= 0) {
+        f_restart(t);
+        return;
+    }
+
+    // Count the samples that were lost in between
+    auto n = std::max(std::round((t - m_reference) / m_sample_period), 1.0);
+
+    auto predicted = m_reference + n * m_sample_period;
+
+    auto error = t - predicted;
+
+    // Too early to be the next sample, most likely a burst
+    if(error < -0.5 * m_sample_period) {
+        return;
+    }
+
+    m_reference = predicted + m_conf.phase_gain * error;
+
+    m_sample_period += m_conf.period_gain * error / n;
+
+    m_error += 0.1 * (std::fabs(error) - m_error);
+
+    m_last_sample = t;
+
+    m_locked = m_error < LOCK_ERROR * m_sample_period;
+
+}
+
+double TickScheduler::next_tick(double now) {
+
+    if(m_nominal <= 0 || now - m_nominal > m_period) {
+        m_nominal = now;
+    }
+
+    m_nominal += m_period;
+
+    if(!m_conf.enabled) {
+        return std::max(m_nominal, now);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(m_locked && now - m_last_sample > LOCK_TIMEOUT * m_sample_period) {
+        m_locked = false;
+    }
+
+    if(!m_locked) {
+        m_last_tick = std::max(m_nominal, now);
+        return m_last_tick;
+    }
+
+    // The sample closest to the tick, then the margin after it
+    auto k = std::round(
+        (m_nominal - m_conf.margin - m_reference) / m_sample_period);
+
+    auto tick = m_reference + k * m_sample_period + m_conf.margin;
+
+    // Helm is faster than the controller, two ticks can't share a sample
+    if(tick <= m_last_tick) {
+        tick = m_nominal;
+    }
+
+    m_last_tick = std::max(tick, now);
+
+    return m_last_tick;
+}
+
+bool TickScheduler::locked() {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_locked;
+}
+
+double TickScheduler::get_sample_period() {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_sample_period;
+}
+
+double TickScheduler::get_phase_error() {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_error;
+}
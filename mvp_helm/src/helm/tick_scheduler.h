@@ -0,0 +1,160 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#pragma once
+
+/*******************************************************************************
+ * STD
+ */
+#include "memory"
+#include "mutex"
+
+/*******************************************************************************
+ * Helm
+ */
+#include "dictionary.h"
+
+namespace helm {
+
+    /**
+     * @brief Aligns the helm ticks to the process values of the controller
+     *
+     * Arrival times of the process values are tracked with a second order
+     * phase locked loop. It estimates the sample period of the controller and
+     * the time of the next sample. Ticks stay on the grid of the helm period,
+     * each one is moved to #alignment_configuration_t::margin after the
+     * sample closest to it. Hence the helm rate doesn't change but the age of
+     * the process values that the behaviors see is small and steady.
+     *
+     * Ticks fall back to the plain helm grid while the loop is not locked,
+     * e.g. before the controller starts or after it stops publishing.
+     *
+     * Times are in seconds of a common clock.
+     */
+    class TickScheduler {
+    private:
+
+        alignment_configuration_t m_conf;
+
+        /**
+         * @brief Helm period in seconds
+         */
+        double m_period;
+
+        //! @brief Time of the next tick on the helm grid
+        double m_nominal;
+
+        //! @brief Time of the last tick that was handed out
+        double m_last_tick;
+
+        /**
+         * @brief Guards the loop state, samples arrive from the subscriber
+         *        thread.
+         */
+        std::mutex m_mutex;
+
+        //! @brief Estimated sample period of the controller
+        double m_sample_period;
+
+        //! @brief Estimated time of the last sample
+        double m_reference;
+
+        //! @brief Arrival time of the first sample since the restart
+        double m_first_sample;
+
+        //! @brief Arrival time of the last sample
+        double m_last_sample;
+
+        //! @brief Smoothed absolute phase error in seconds
+        double m_error;
+
+        //! @brief Number of samples since the restart, up to the acquisition
+        int m_samples;
+
+        bool m_locked;
+
+        /**
+         * @brief Restarts the loop from a sample
+         */
+        void f_restart(double t);
+
+    public:
+
+        typedef std::shared_ptr<TickScheduler> Ptr;
+
+        TickScheduler();
+
+        /**
+         * @brief Configure the scheduler
+         *
+         * @param conf Alignment configuration
+         * @param period Helm period in seconds
+         */
+        void configure(const alignment_configuration_t& conf, double period);
+
+        /**
+         * @brief Change the helm period
+         *
+         * The helm grid restarts from the next tick.
+         *
+         * @param period Helm period in seconds
+         */
+        void set_period(double period);
+
+        /**
+         * @brief Feed the arrival time of a process value
+         *
+         * @param t Arrival time in seconds
+         */
+        void sample(double t);
+
+        /**
+         * @brief Time of the next tick
+         *
+         * Advances the helm grid by a period. If the helm fell behind by
+         * more than a period, the grid restarts from now like `ros::Rate`.
+         *
+         * @param now Current time in seconds
+         * @return Time of the next tick in seconds, not earlier than now
+         */
+        double next_tick(double now);
+
+        /**
+         * @brief Whether the loop follows the controller
+         */
+        bool locked();
+
+        /**
+         * @brief Estimated sample period of the controller in seconds
+         */
+        double get_sample_period();
+
+        /**
+         * @brief Smoothed absolute phase error in seconds
+         */
+        double get_phase_error();
+
+    };
+
+}
@@ -0,0 +1,258 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#include "timing_wheel.h"
+
+#include "algorithm"
+#include "cmath"
+
+using namespace helm;
+
+/**
+ * @brief Timers further than this many jiffies are parked on the last slot
+ *        that the wheels can reach, they are placed again when it cascades.
+ */
+static constexpr uint64_t MAX_DELTA = (1ULL << 32) - 1;
+
+//! @brief Largest expiry, far beyond any mission
+static constexpr double MAX_JIFFY = 4e18;
+
+constexpr int TimingWheel::LEVELS;
+constexpr int TimingWheel::SLOT_BITS;
+constexpr uint64_t TimingWheel::SLOTS;
+constexpr uint64_t TimingWheel::SLOT_MASK;
+
+TimingWheel::TimingWheel(double resolution) {
+
+    m_resolution = resolution;
+
+    m_origin = 0;
+
+    m_started = false;
+
+    m_current = 0;
+
+    m_next_id = 1;
+
+    m_level_count.fill(0);
+
+}
+
+uint64_t TimingWheel::f_to_jiffy(double t) {
+
+    if(!m_started) {
+        m_origin = t;
+        m_started = true;
+    }
+
+    auto jiffies = std::ceil((t - m_origin) / m_resolution);
+
+    if(!(jiffies > m_current)) {
+        return m_current + 1;
+    }
+
+    return static_cast<uint64_t>(std::min(jiffies, MAX_JIFFY));
+
+}
+
+void TimingWheel::f_place(slot_t& from, slot_t::iterator it) {
+
+    slot_t* slot = &m_expired;
+    int level = -1;
+
+    if(it->expires > m_current) {
+        auto expires = std::min(it->expires, m_current + MAX_DELTA);
+        auto delta = expires - m_current;
+
+        level = 0;
+        while(level < LEVELS - 1 &&
+            delta >= (1ULL << (SLOT_BITS * (level + 1)))) {
+            level++;
+        }
+
+        slot = &m_wheels[level][(expires >> (SLOT_BITS * level)) & SLOT_MASK];
+
+        m_level_count[level]++;
+    }
+
+    slot->splice(slot->end(), from, it);
+
+    m_locations[it->id] = location_t{level, slot, it};
+
+}
+
+void TimingWheel::f_step() {
+
+    m_current++;
+
+    /**
+     * Coarser wheels are cascaded first, their timers may land on the slots
+     * of the finer ones that are cascaded at the same jiffy.
+     */
+    int levels = 1;
+    while(levels < LEVELS &&
+        (m_current & ((1ULL << (SLOT_BITS * levels)) - 1)) == 0) {
+        levels++;
+    }
+
+    for(int level = levels - 1 ; level >= 0 ; level--) {
+        auto& slot = m_wheels[level][
+            (m_current >> (SLOT_BITS * level)) & SLOT_MASK];
+
+        while(!slot.empty()) {
+            m_level_count[level]--;
+            f_place(slot, slot.begin());
+        }
+    }
+
+}
+
+TimingWheel::timer_id_t TimingWheel::schedule(double now, double delay,
+                                              std::function<void()> callback,
+                                              double period) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    slot_t pending;
+    pending.push_back(entry_t{
+        m_next_id++,
+        f_to_jiffy(now + std::max(delay, 0.0)),
+        period > 0 ?
+            std::max<uint64_t>(1, std::llround(period / m_resolution)) : 0,
+        std::make_shared<const std::function<void()>>(std::move(callback))
+    });
+
+    auto id = pending.front().id;
+
+    f_place(pending, pending.begin());
+
+    return id;
+
+}
+
+bool TimingWheel::cancel(timer_id_t id) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto location = m_locations.find(id);
+    if(location == m_locations.end()) {
+        return false;
+    }
+
+    if(location->second.level >= 0) {
+        m_level_count[location->second.level]--;
+    }
+
+    location->second.slot->erase(location->second.it);
+
+    m_locations.erase(location);
+
+    return true;
+
+}
+
+size_t TimingWheel::advance(double now) {
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if(!m_started) {
+            m_origin = now;
+            m_started = true;
+        }
+
+        auto jiffies = std::floor((now - m_origin) / m_resolution);
+        uint64_t target = jiffies > 0 ? static_cast<uint64_t>(jiffies) : 0;
+
+        while(m_current < target) {
+            /**
+             * Nothing happens until the next cascade of the finest wheel
+             * that has a timer, e.g. a clock jump doesn't turn the wheels
+             * jiffy by jiffy.
+             */
+            int level = 0;
+            while(level < LEVELS && m_level_count[level] == 0) {
+                level++;
+            }
+
+            if(level == LEVELS) {
+                m_current = target;
+                break;
+            }
+
+            if(level > 0) {
+                uint64_t span = 1ULL << (SLOT_BITS * level);
+                m_current = std::min(target, (m_current / span + 1) * span - 1);
+
+                if(m_current == target) {
+                    break;
+                }
+            }
+
+            f_step();
+        }
+    }
+
+    size_t fired = 0;
+
+    while(true) {
+
+        std::shared_ptr<const std::function<void()>> callback;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if(m_expired.empty()) {
+                break;
+            }
+
+            auto it = m_expired.begin();
+
+            callback = it->callback;
+
+            if(it->period > 0) {
+                // A late periodic timer fires once, it doesn't catch up
+                it->expires = std::max(it->expires + it->period, m_current + 1);
+                f_place(m_expired, it);
+            } else {
+                m_locations.erase(it->id);
+                m_expired.erase(it);
+            }
+        }
+
+        (*callback)();
+
+        fired++;
+    }
+
+    return fired;
+
+}
+
+size_t TimingWheel::size() {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_locations.size();
+
+}
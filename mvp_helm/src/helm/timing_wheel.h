@@ -0,0 +1,181 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#pragma once
+
+/*******************************************************************************
+ * STD
+ */
+#include "array"
+#include "cstdint"
+#include "functional"
+#include "list"
+#include "memory"
+#include "mutex"
+#include "unordered_map"
+
+namespace helm {
+
+    /**
+     * @brief Hierarchical timing wheel for the behavior and the state timers
+     *
+     * Time is divided into jiffies of a fixed resolution. A timer that
+     * expires within 256 jiffies goes to a slot of the first wheel, a later
+     * one goes to a slot of a coarser wheel and moves down a level each time
+     * the finer wheel completes a turn. Scheduling, cancelling and firing are
+     * constant time, the cascades are amortized over the turns.
+     *
+     * Timers are fired from #TimingWheel::advance, which is called by the helm
+     * at the tick boundaries. Other functions may be called from any thread.
+     * Callbacks are called without holding the lock, they can schedule and
+     * cancel timers.
+     *
+     * Times are in seconds of a common clock.
+     */
+    class TimingWheel {
+    public:
+
+        typedef std::shared_ptr<TimingWheel> Ptr;
+
+        //! @brief Identifier of a timer, 0 is never used
+        typedef uint64_t timer_id_t;
+
+    private:
+
+        static constexpr int LEVELS = 4;
+
+        static constexpr int SLOT_BITS = 8;
+
+        static constexpr uint64_t SLOTS = 1 << SLOT_BITS;
+
+        static constexpr uint64_t SLOT_MASK = SLOTS - 1;
+
+        struct entry_t {
+            timer_id_t id;
+            //! @brief Expiry in jiffies since the origin
+            uint64_t expires;
+            //! @brief Period in jiffies, 0 for one shot timers
+            uint64_t period;
+            std::shared_ptr<const std::function<void()>> callback;
+        };
+
+        typedef std::list<entry_t> slot_t;
+
+        struct location_t {
+            //! @brief Level of the slot, -1 while it waits to be fired
+            int level;
+            slot_t* slot;
+            slot_t::iterator it;
+        };
+
+        //! @brief Length of a jiffy in seconds
+        double m_resolution;
+
+        //! @brief Time of the jiffy zero, set by the first call
+        double m_origin;
+
+        bool m_started;
+
+        //! @brief Jiffies since the origin that are processed
+        uint64_t m_current;
+
+        timer_id_t m_next_id;
+
+        std::array<std::array<slot_t, SLOTS>, LEVELS> m_wheels;
+
+        //! @brief Number of the timers in each level
+        std::array<size_t, LEVELS> m_level_count;
+
+        //! @brief Timers that are due, fired in the order of expiry
+        slot_t m_expired;
+
+        std::unordered_map<timer_id_t, location_t> m_locations;
+
+        std::mutex m_mutex;
+
+        /**
+         * @brief Jiffy of a time, rounded up so that timers never fire early
+         */
+        uint64_t f_to_jiffy(double t);
+
+        /**
+         * @brief Moves an entry from a list to its slot
+         */
+        void f_place(slot_t& from, slot_t::iterator it);
+
+        /**
+         * @brief Processes the next jiffy
+         */
+        void f_step();
+
+    public:
+
+        /**
+         * @brief Construct a new timing wheel
+         *
+         * @param resolution Length of a jiffy in seconds. Wheels span 2^32
+         *        jiffies, timers further away are placed again when the
+         *        wheels get close to them.
+         */
+        explicit TimingWheel(double resolution);
+
+        /**
+         * @brief Schedules a timer
+         *
+         * @param now Current time
+         * @param delay Seconds until the first firing
+         * @param callback Called at the first tick boundary after the delay
+         * @param period Seconds between the firings, 0 for a one shot timer
+         * @return Identifier of the timer
+         */
+        timer_id_t schedule(double now, double delay,
+                            std::function<void()> callback,
+                            double period = 0);
+
+        /**
+         * @brief Cancels a timer
+         *
+         * A timer that is cancelled by the callback of another timer in the
+         * same tick doesn't fire.
+         *
+         * @param id Identifier of the timer
+         * @return false if there is no such timer, e.g. it already fired
+         */
+        bool cancel(timer_id_t id);
+
+        /**
+         * @brief Fires the timers that are due
+         *
+         * @param now Current time
+         * @return Number of fired timers
+         */
+        size_t advance(double now);
+
+        /**
+         * @brief Number of the scheduled timers
+         */
+        size_t size();
+
+    };
+
+}
@@ -37,7 +37,7 @@ namespace helm {
          * @param msg
          * @return std::array<double, 12>
          */
-        std::array<double, 12> control_process_to_array(
+        inline std::array<double, 12> control_process_to_array(
             const mvp_msgs::ControlProcess& msg)
         {
             std::array<double, 12> a {};
@@ -67,7 +67,7 @@ namespace helm {
          * @param a
          * @return mvp_msgs::ControlProcess
          */
-        mvp_msgs::ControlProcess array_to_control_process_msg(
+        inline mvp_msgs::ControlProcess array_to_control_process_msg(
             const std::array<double, 12>& a)
         {
             mvp_msgs::ControlProcess msg;
@@ -0,0 +1,117 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#include "worker_pool.h"
+
+#include "ros/ros.h"
+
+#include "sys/resource.h"
+#include "sys/syscall.h"
+#include "unistd.h"
+
+using namespace helm;
+
+WorkerPool::WorkerPool(size_t threads, size_t max_queue) {
+
+    m_max_queue = max_queue;
+
+    m_stop = false;
+
+    for(size_t i = 0 ; i < threads ; i++) {
+        m_threads.emplace_back([this] { f_worker(); });
+    }
+
+}
+
+WorkerPool::~WorkerPool() {
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_cv.notify_all();
+
+    for(auto& t : m_threads) {
+        t.join();
+    }
+
+}
+
+bool WorkerPool::submit(std::function<void()> job) {
+
+    if(m_threads.empty()) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if(m_stop || m_queue.size() >= m_max_queue) {
+            return false;
+        }
+
+        m_queue.emplace_back(std::move(job));
+    }
+
+    m_cv.notify_one();
+
+    return true;
+}
+
+void WorkerPool::f_worker() {
+
+    /**
+     * Linux applies nice values per thread. Workers must never compete with
+     * the helm loop.
+     */
+    if(setpriority(PRIO_PROCESS,
+        static_cast<id_t>(syscall(SYS_gettid)), 19) != 0) {
+        ROS_WARN_STREAM("Can not lower the priority of the helm worker");
+    }
+
+    while(true) {
+        std::function<void()> job;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+
+            if(m_stop) {
+                return;
+            }
+
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        try {
+            job();
+        } catch (const std::exception& e) {
+            ROS_ERROR_STREAM("Background job failed: " << e.what());
+        }
+    }
+
+}
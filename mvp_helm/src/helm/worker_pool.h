@@ -0,0 +1,93 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#pragma once
+
+/*******************************************************************************
+ * STD
+ */
+#include "condition_variable"
+#include "deque"
+#include "functional"
+#include "memory"
+#include "mutex"
+#include "thread"
+#include "vector"
+
+namespace helm {
+
+    /**
+     * @brief A small pool of low priority threads shared by the behaviors
+     *
+     * Behaviors hand their background work to this pool through
+     * #BehaviorBase::submit_work so that they can keep refining a solution
+     * between the helm iterations. Worker threads run with a lower scheduling
+     * priority than the helm loop, so they can only use the spare time.
+     */
+    class WorkerPool {
+    private:
+
+        std::vector<std::thread> m_threads;
+
+        std::deque<std::function<void()>> m_queue;
+
+        std::mutex m_mutex;
+
+        std::condition_variable m_cv;
+
+        /**
+         * @brief Maximum number of the queued jobs
+         */
+        size_t m_max_queue;
+
+        bool m_stop;
+
+        void f_worker();
+
+    public:
+
+        typedef std::shared_ptr<WorkerPool> Ptr;
+
+        /**
+         * @brief Construct a new Worker Pool object
+         *
+         * @param threads Number of worker threads. Zero means no background
+         *                work is accepted.
+         * @param max_queue Maximum number of jobs waiting in the queue
+         */
+        WorkerPool(size_t threads, size_t max_queue);
+
+        ~WorkerPool();
+
+        /**
+         * @brief Queue a job
+         *
+         * @param job
+         * @return false if the pool has no threads or the queue is full
+         */
+        bool submit(std::function<void()> job);
+
+    };
+
+}
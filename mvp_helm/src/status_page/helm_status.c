@@ -0,0 +1,128 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#include "errno.h"
+#include "stdio.h"
+#include "string.h"
+#include "unistd.h"
+
+#include "mvp_helm/status_page.h"
+
+/**
+ * Prints the status page of a helm.
+ *
+ * Usage:
+ *   rosrun mvp_helm helm_status [-w] [name]
+ *
+ *   -w     keep printing every second
+ *   name   shared memory object, "/mvp_helm_helm" by default
+ */
+
+static const char* DOF_NAMES[HELM_STATUS_DOF_COUNT] = {
+    "x", "y", "z", "roll", "pitch", "yaw",
+    "surge", "sway", "heave", "roll_rate", "pitch_rate", "yaw_rate"
+};
+
+static void print_status(const helm_status_t* s, int result) {
+
+    printf("tick: %llu%s%s\n", (unsigned long long)s->tick,
+        result == HELM_STATUS_STOPPED ? " (helm is not running)" : "",
+        s->standby ? " (standby)" : "");
+    printf("state: %s, mode: %s\n", s->state, s->mode);
+    printf("frequency: %.2fHz, last iteration: %.3fms, overload level: %d,"
+        " aligned: %s\n", s->frequency, s->duration * 1000.0,
+        s->overload_level, s->aligned ? "yes" : "no");
+
+    printf("set point at %.3f:\n", s->set_point_stamp);
+    for(int dof = 0 ; dof < HELM_STATUS_DOF_COUNT ; dof++) {
+        int winner = s->dof_winners[dof];
+        if(winner < 0 || (uint32_t)winner >= s->behavior_count) {
+            continue;
+        }
+        printf("  %-10s %12.4f  %s\n", DOF_NAMES[dof], s->set_point[dof],
+            s->behaviors[winner].name);
+    }
+
+    printf("behaviors:\n");
+    for(uint32_t i = 0 ; i < s->behavior_count ; i++) {
+        const helm_status_behavior_t* b = &s->behaviors[i];
+        printf("  %-24s %-8s priority: %3d, result: %d, failures: %u,"
+            " %.3fms%s%s\n", b->name, b->active ? "active" : "inactive",
+            b->priority, b->result, b->failures, b->duration * 1000.0,
+            b->decimated ? ", decimated" : "",
+            b->critical ? ", critical" : "");
+        printf("  %-24s memory: %.1fKiB, high water: %.1fKiB,"
+            " reserved: %.1fKiB, allocations: %llu\n", "",
+            b->memory_in_use / 1024.0, b->memory_high_water / 1024.0,
+            b->memory_reserved / 1024.0,
+            (unsigned long long)b->memory_allocations);
+    }
+}
+
+int main(int argc, char* argv[]) {
+
+    const char* name = "/mvp_helm_helm";
+    int watch = 0;
+
+    for(int i = 1 ; i < argc ; i++) {
+        if(strcmp(argv[i], "-w") == 0) {
+            watch = 1;
+        } else if(argv[i][0] == '-') {
+            fprintf(stderr, "usage: helm_status [-w] [name]\n");
+            return 2;
+        } else {
+            name = argv[i];
+        }
+    }
+
+    helm_status_reader_t* reader = helm_status_open(name);
+    if(reader == NULL) {
+        fprintf(stderr, "%s: %s\n", name, strerror(errno));
+        return 1;
+    }
+
+    int result;
+    do {
+        helm_status_t status;
+        result = helm_status_read(reader, &status);
+
+        if(result == HELM_STATUS_INVALID) {
+            fprintf(stderr, "%s: not a status page of this version\n", name);
+        } else if(result == HELM_STATUS_BUSY) {
+            fprintf(stderr, "%s: helm is writing, try again\n", name);
+        } else {
+            print_status(&status, result);
+        }
+
+        if(watch) {
+            printf("\n");
+            fflush(stdout);
+            sleep(1);
+        }
+    } while(watch);
+
+    helm_status_close(reader);
+
+    return result == HELM_STATUS_OK || result == HELM_STATUS_STOPPED ? 0 : 1;
+}
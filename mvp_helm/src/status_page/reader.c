@@ -0,0 +1,206 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+
+#include "errno.h"
+#include "fcntl.h"
+#include "stdlib.h"
+#include "string.h"
+#include "sys/mman.h"
+#include "sys/stat.h"
+#include "unistd.h"
+
+#include "mvp_helm/status_page.h"
+
+/**
+ * @brief Number of copies attempted before giving up
+ *
+ * Helm writes the page once per iteration and a write takes a few
+ * microseconds, a retry is rarely needed.
+ */
+#define HELM_STATUS_READ_RETRIES 64
+
+struct helm_status_reader {
+    int fd;
+    const helm_status_page_t* page;
+};
+
+helm_status_reader_t* helm_status_open(const char* name) {
+
+    int fd = shm_open(name, O_RDONLY, 0);
+    if(fd < 0) {
+        return NULL;
+    }
+
+    struct stat st;
+    if(fstat(fd, &st) < 0) {
+        int e = errno;
+        close(fd);
+        errno = e;
+        return NULL;
+    }
+
+    /**
+     * Helm sizes the object before it writes the magic, a smaller object is
+     * either being created or it is not a status page.
+     */
+    if((size_t)st.st_size < sizeof(helm_status_page_t)) {
+        close(fd);
+        errno = EAGAIN;
+        return NULL;
+    }
+
+    void* addr = mmap(NULL, sizeof(helm_status_page_t), PROT_READ,
+        MAP_SHARED, fd, 0);
+    if(addr == MAP_FAILED) {
+        int e = errno;
+        close(fd);
+        errno = e;
+        return NULL;
+    }
+
+    helm_status_reader_t* reader =
+        (helm_status_reader_t*)malloc(sizeof(helm_status_reader_t));
+    if(reader == NULL) {
+        munmap(addr, sizeof(helm_status_page_t));
+        close(fd);
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    reader->fd = fd;
+    reader->page = (const helm_status_page_t*)addr;
+
+    return reader;
+}
+
+int helm_status_read(helm_status_reader_t* reader, helm_status_t* status) {
+
+    const helm_status_page_t* page = reader->page;
+
+    if(__atomic_load_n(&page->magic, __ATOMIC_ACQUIRE) != HELM_STATUS_MAGIC ||
+        page->version != HELM_STATUS_VERSION ||
+        page->size != sizeof(helm_status_page_t)) {
+        return HELM_STATUS_INVALID;
+    }
+
+    for(int i = 0 ; i < HELM_STATUS_READ_RETRIES ; i++) {
+        uint64_t begin = __atomic_load_n(&page->sequence, __ATOMIC_ACQUIRE);
+
+        if(begin & 1u) {
+            continue;
+        }
+
+        /**
+         * The copy may race with the helm, it is thrown away in that case.
+         * The fence keeps the copy before the second load of the sequence.
+         */
+        memcpy(status, &page->status, sizeof(helm_status_t));
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if(__atomic_load_n(&page->sequence, __ATOMIC_RELAXED) == begin) {
+            return __atomic_load_n(&page->pid, __ATOMIC_RELAXED) == 0 ?
+                HELM_STATUS_STOPPED : HELM_STATUS_OK;
+        }
+    }
+
+    return HELM_STATUS_BUSY;
+}
+
+uint64_t helm_status_sequence(const helm_status_reader_t* reader) {
+    return __atomic_load_n(&reader->page->sequence, __ATOMIC_ACQUIRE);
+}
+
+int helm_status_take_over(const char* name, const char* owner) {
+
+    int fd = shm_open(name, O_RDWR, 0);
+    if(fd < 0) {
+        return -1;
+    }
+
+    struct stat st;
+    if(fstat(fd, &st) < 0) {
+        int e = errno;
+        close(fd);
+        errno = e;
+        return -1;
+    }
+
+    if((size_t)st.st_size < sizeof(helm_status_page_t)) {
+        close(fd);
+        errno = EINVAL;
+        return -1;
+    }
+
+    void* addr = mmap(NULL, sizeof(helm_status_page_t),
+        PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if(addr == MAP_FAILED) {
+        int e = errno;
+        close(fd);
+        errno = e;
+        return -1;
+    }
+
+    close(fd);
+
+    helm_status_page_t* page = (helm_status_page_t*)addr;
+
+    if(__atomic_load_n(&page->magic, __ATOMIC_ACQUIRE) != HELM_STATUS_MAGIC ||
+        page->version != HELM_STATUS_VERSION ||
+        page->size != sizeof(helm_status_page_t)) {
+        munmap(addr, sizeof(helm_status_page_t));
+        errno = EINVAL;
+        return -1;
+    }
+
+    /**
+     * Helm loads the pid first, the name must be complete before it is set
+     */
+    size_t n = 0;
+    if(owner != NULL) {
+        n = strnlen(owner, HELM_STATUS_NAME_LENGTH - 1);
+        memcpy(page->owner, owner, n);
+    }
+    page->owner[n] = '\0';
+
+    __atomic_add_fetch(&page->takeovers, 1u, __ATOMIC_RELAXED);
+    __atomic_store_n(&page->owner_pid, (int32_t)getpid(), __ATOMIC_RELEASE);
+
+    munmap(addr, sizeof(helm_status_page_t));
+
+    return 0;
+}
+
+void helm_status_close(helm_status_reader_t* reader) {
+
+    if(reader == NULL) {
+        return;
+    }
+
+    munmap((void*)reader->page, sizeof(helm_status_page_t));
+
+    close(reader->fd);
+
+    free(reader);
+}
@@ -0,0 +1,133 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#pragma once
+
+/*******************************************************************************
+ * STD
+ */
+#include "map"
+#include "memory"
+#include "random"
+#include "string"
+
+/*******************************************************************************
+ * ROS
+ */
+#include "ros/ros.h"
+
+/*******************************************************************************
+ * MVP
+ */
+#include "mvp_msgs/ControlProcess.h"
+#include "mvp_msgs/GetControlModes.h"
+
+#include "stand_in_controller/vehicle_model.h"
+
+namespace helm {
+
+namespace stand_in {
+
+    /**
+     * @brief Stand-in for the low-level controller of MVP
+     *
+     * Serves "controller/get_modes", tracks the set points received on
+     * "controller/process/set_point" with a #helm::stand_in::VehicleModel
+     * and publishes "controller/process/value" at a fixed rate with
+     * measurement noise. It is enough for the helm and its behaviors to run
+     * in closed loop without the control stack, e.g. in tests and
+     * benchmarks.
+     *
+     * Parameters are read from the private namespace, see
+     * configuration/default.yaml. Vehicle is advanced by a fixed step at
+     * each publish, so a run is repeatable for a given seed and sequence of
+     * set points. With "/use_sim_time" the rate follows the simulated clock.
+     */
+    class StandInController {
+    private:
+
+        ros::NodeHandlePtr m_nh;
+
+        ros::NodeHandlePtr m_pnh;
+
+        //! @brief DOFs of each control mode, by name
+        std::map<std::string, std::vector<uint8_t>> m_modes;
+
+        std::string m_frame_id;
+
+        //! @brief Rate of the process values, in hertz
+        double m_rate;
+
+        /**
+         * @brief Vehicle coasts to a stop if no set point is received for
+         *        this many seconds, 0 disables it
+         */
+        double m_set_point_timeout;
+
+        noise_configuration_t m_noise;
+
+        std::shared_ptr<VehicleModel> m_model;
+
+        std::mt19937 m_rng;
+
+        ros::Time m_last_set_point;
+
+        bool m_coasting;
+
+        ros::ServiceServer m_get_modes_srv;
+
+        ros::Subscriber m_sub_set_point;
+
+        ros::Publisher m_pub_process_value;
+
+        ros::Timer m_timer;
+
+        void f_parse_modes();
+
+        bool f_cb_get_modes(mvp_msgs::GetControlModes::Request& req,
+                            mvp_msgs::GetControlModes::Response& resp);
+
+        void f_cb_set_point(const mvp_msgs::ControlProcess::ConstPtr& msg);
+
+        void f_cb_timer(const ros::TimerEvent& event);
+
+    public:
+
+        typedef std::shared_ptr<StandInController> Ptr;
+
+        StandInController();
+
+        /**
+         * @brief Read the parameters and start serving
+         *
+         * @throws std::runtime_error if the parameters are invalid
+         */
+        void initialize();
+
+        auto get_model() -> const decltype(m_model)& { return m_model; }
+
+    };
+
+}
+
+}
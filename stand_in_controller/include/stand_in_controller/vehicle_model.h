@@ -0,0 +1,130 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#pragma once
+
+#include "array"
+#include "cstdint"
+#include "random"
+
+namespace helm {
+
+namespace stand_in {
+
+    /**
+     * @brief Vehicle state and set points, indexed by the DOF of
+     *        mvp_msgs::ControlMode
+     *
+     * x, y, z, roll, pitch, yaw, surge, sway, heave, roll rate, pitch rate
+     * and yaw rate.
+     */
+    typedef std::array<double, 12> dof_array_t;
+
+    struct model_configuration_t {
+        //! @brief Time constant of the position response, in seconds
+        double position_time_constant;
+        //! @brief Time constant of the orientation response, in seconds
+        double orientation_time_constant;
+        //! @brief Time constant of the body velocity response, in seconds
+        double velocity_time_constant;
+        //! @brief Time constant of the angular rate response, in seconds
+        double rate_time_constant;
+        //! @brief Largest body velocity on each axis, in m/s
+        double max_velocity;
+        //! @brief Largest angular rate on each axis, in rad/s
+        double max_rate;
+    };
+
+    struct noise_configuration_t {
+        //! @brief Standard deviations of the measurement noise
+        double position;
+        double orientation;
+        double velocity;
+        double angular_rate;
+    };
+
+    /**
+     * @brief Kinematic vehicle that tracks the set points of the helm
+     *
+     * It is a stand-in for the low-level controller and the vehicle, not a
+     * model of either. Each controlled DOF reaches its set point with a first
+     * order response:
+     *
+     *  - Positions and orientations command velocities and rates
+     *    proportional to their error, over the time constant.
+     *  - Velocities and rates are commanded directly when their position or
+     *    orientation is not controlled. Position wins over velocity on the
+     *    same axis.
+     *  - Velocities and rates of the DOFs that are not controlled decay to
+     *    zero, orientations are held.
+     *
+     * Positions and velocities are in NED, velocities are in the body frame.
+     * Angular rates are the derivatives of the Euler angles, which is close
+     * enough to the body rates at small roll and pitch.
+     */
+    class VehicleModel {
+    private:
+
+        model_configuration_t m_conf;
+
+        dof_array_t m_state;
+
+        dof_array_t m_set_point;
+
+        //! @brief Bit i is set if DOF i is controlled
+        uint16_t m_controlled;
+
+    public:
+
+        VehicleModel(const model_configuration_t& conf,
+                     const dof_array_t& state);
+
+        /**
+         * @brief Set the set point
+         *
+         * @param set_point
+         * @param controlled Bit i is set if DOF i is controlled, 0 lets the
+         *        vehicle coast to a stop
+         */
+        void set_set_point(const dof_array_t& set_point, uint16_t controlled);
+
+        /**
+         * @brief Advance the vehicle
+         *
+         * @param dt Time step in seconds
+         */
+        void step(double dt);
+
+        const dof_array_t& get_state() const { return m_state; }
+
+        /**
+         * @brief State with measurement noise
+         */
+        dof_array_t measure(const noise_configuration_t& noise,
+                            std::mt19937& rng) const;
+
+    };
+
+}
+
+}
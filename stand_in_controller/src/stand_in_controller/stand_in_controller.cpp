@@ -0,0 +1,260 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#include "stand_in_controller/stand_in_controller.h"
+
+#include "algorithm"
+#include "stdexcept"
+
+using namespace helm::stand_in;
+
+namespace {
+
+    const char* DOF_NAMES[12] = {
+        "x", "y", "z", "roll", "pitch", "yaw",
+        "surge", "sway", "heave", "roll_rate", "pitch_rate", "yaw_rate"
+    };
+
+}
+
+StandInController::StandInController() {
+
+    m_nh.reset(new ros::NodeHandle());
+
+    m_pnh.reset(new ros::NodeHandle("~"));
+
+    m_coasting = true;
+
+}
+
+void StandInController::initialize() {
+
+    f_parse_modes();
+
+    m_pnh->param<std::string>("frame_id", m_frame_id, "world_ned");
+
+    m_pnh->param<double>("rate", m_rate, 20.0);
+
+    m_pnh->param<double>("set_point_timeout", m_set_point_timeout, 1.0);
+
+    if(m_rate <= 0) {
+        throw std::runtime_error("'rate' must be positive!");
+    }
+
+    model_configuration_t model;
+
+    m_pnh->param<double>("model/position_time_constant",
+        model.position_time_constant, 5.0);
+
+    m_pnh->param<double>("model/orientation_time_constant",
+        model.orientation_time_constant, 1.5);
+
+    m_pnh->param<double>("model/velocity_time_constant",
+        model.velocity_time_constant, 2.0);
+
+    m_pnh->param<double>("model/rate_time_constant",
+        model.rate_time_constant, 0.5);
+
+    m_pnh->param<double>("model/max_velocity", model.max_velocity, 2.0);
+
+    m_pnh->param<double>("model/max_rate", model.max_rate, 0.5);
+
+    if(model.position_time_constant <= 0 ||
+       model.orientation_time_constant <= 0 ||
+       model.velocity_time_constant <= 0 ||
+       model.rate_time_constant <= 0) {
+        throw std::runtime_error("time constants must be positive!");
+    }
+
+    m_pnh->param<double>("noise/position", m_noise.position, 0.0);
+
+    m_pnh->param<double>("noise/orientation", m_noise.orientation, 0.0);
+
+    m_pnh->param<double>("noise/velocity", m_noise.velocity, 0.0);
+
+    m_pnh->param<double>("noise/angular_rate", m_noise.angular_rate, 0.0);
+
+    int seed;
+    m_pnh->param<int>("seed", seed, 0);
+    m_rng.seed(static_cast<uint32_t>(seed));
+
+    dof_array_t initial;
+    initial.fill(0);
+    for(int i = 0 ; i < 6 ; i++) {
+        m_pnh->param<double>(
+            std::string("initial/") + DOF_NAMES[i], initial[i], 0.0);
+    }
+
+    m_model = std::make_shared<VehicleModel>(model, initial);
+
+    m_get_modes_srv = m_nh->advertiseService(
+        "controller/get_modes",
+        &StandInController::f_cb_get_modes,
+        this
+    );
+
+    m_sub_set_point = m_nh->subscribe(
+        "controller/process/set_point",
+        100,
+        &StandInController::f_cb_set_point,
+        this
+    );
+
+    m_pub_process_value = m_nh->advertise<mvp_msgs::ControlProcess>(
+        "controller/process/value",
+        100
+    );
+
+    m_timer = m_nh->createTimer(
+        ros::Duration(1.0 / m_rate),
+        &StandInController::f_cb_timer,
+        this
+    );
+
+}
+
+void StandInController::f_parse_modes() {
+
+    XmlRpc::XmlRpcValue modes;
+
+    if(!m_pnh->getParam("control_modes", modes) ||
+        modes.getType() != XmlRpc::XmlRpcValue::TypeStruct) {
+        throw std::runtime_error(
+            "'control_modes' must map the mode names to lists of DOFs!");
+    }
+
+    for(auto& mode : modes) {
+        if(mode.second.getType() != XmlRpc::XmlRpcValue::TypeArray) {
+            throw std::runtime_error(
+                "DOFs of the mode '" + mode.first + "' must be a list!");
+        }
+
+        std::vector<uint8_t> dofs;
+
+        for(int i = 0 ; i < mode.second.size() ; i++) {
+            auto& dof = mode.second[i];
+
+            if(dof.getType() != XmlRpc::XmlRpcValue::TypeString) {
+                throw std::runtime_error(
+                    "DOFs of the mode '" + mode.first + "' must be names!");
+            }
+
+            auto name = static_cast<std::string>(dof);
+            auto it = std::find(std::begin(DOF_NAMES), std::end(DOF_NAMES),
+                                name);
+            if(it == std::end(DOF_NAMES)) {
+                throw std::runtime_error("Unknown DOF '" + name + "' in mode '"
+                    + mode.first + "'!");
+            }
+
+            dofs.push_back(static_cast<uint8_t>(it - std::begin(DOF_NAMES)));
+        }
+
+        m_modes[mode.first] = dofs;
+    }
+
+}
+
+bool StandInController::f_cb_get_modes(
+        mvp_msgs::GetControlModes::Request& req,
+        mvp_msgs::GetControlModes::Response& resp) {
+
+    for(const auto& mode : m_modes) {
+        mvp_msgs::ControlMode m;
+        m.name = mode.first;
+        m.dofs = mode.second;
+        resp.modes.emplace_back(m);
+    }
+
+    return true;
+
+}
+
+void StandInController::f_cb_set_point(
+        const mvp_msgs::ControlProcess::ConstPtr& msg) {
+
+    auto mode = m_modes.find(msg->control_mode);
+
+    if(mode == m_modes.end()) {
+        ROS_WARN_STREAM_THROTTLE(1.0,
+            "Unknown control mode: " << msg->control_mode);
+        return;
+    }
+
+    dof_array_t set_point = {
+        msg->position.x, msg->position.y, msg->position.z,
+        msg->orientation.x, msg->orientation.y, msg->orientation.z,
+        msg->velocity.x, msg->velocity.y, msg->velocity.z,
+        msg->angular_rate.x, msg->angular_rate.y, msg->angular_rate.z
+    };
+
+    uint16_t controlled = 0;
+    for(const auto& dof : mode->second) {
+        controlled |= 1u << dof;
+    }
+
+    m_model->set_set_point(set_point, controlled);
+
+    m_last_set_point = ros::Time::now();
+
+    m_coasting = false;
+
+}
+
+void StandInController::f_cb_timer(const ros::TimerEvent& event) {
+
+    if(!m_coasting && m_set_point_timeout > 0 &&
+        (ros::Time::now() - m_last_set_point).toSec() > m_set_point_timeout) {
+        ROS_WARN_STREAM("No set point for " << m_set_point_timeout
+            << " seconds, vehicle coasts to a stop");
+
+        m_model->set_set_point(dof_array_t(), 0);
+
+        m_coasting = true;
+    }
+
+    m_model->step(1.0 / m_rate);
+
+    auto s = m_model->measure(m_noise, m_rng);
+
+    mvp_msgs::ControlProcess msg;
+
+    msg.header.stamp = ros::Time::now();
+    msg.header.frame_id = m_frame_id;
+
+    msg.position.x = s[0];
+    msg.position.y = s[1];
+    msg.position.z = s[2];
+    msg.orientation.x = s[3];
+    msg.orientation.y = s[4];
+    msg.orientation.z = s[5];
+    msg.velocity.x = s[6];
+    msg.velocity.y = s[7];
+    msg.velocity.z = s[8];
+    msg.angular_rate.x = s[9];
+    msg.angular_rate.y = s[10];
+    msg.angular_rate.z = s[11];
+
+    m_pub_process_value.publish(msg);
+
+}
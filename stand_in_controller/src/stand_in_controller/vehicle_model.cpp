@@ -0,0 +1,171 @@
+/*
+    This file is part of MVP-Mission program.
+
+    MVP-Mission is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MVP-Mission is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with MVP-Mission.  If not, see <https://www.gnu.org/licenses/>.
+
+    Author: Emir Cem Gezer
+    Email: emircem@uri.edu;emircem.gezer@gmail.com
+    Year: 2022
+
+    Copyright (C) 2022 Smart Ocean Systems Laboratory
+*/
+
+#include "stand_in_controller/vehicle_model.h"
+
+#include "algorithm"
+#include "cmath"
+
+using namespace helm::stand_in;
+
+namespace {
+
+    double clamp(double value, double limit) {
+        return std::max(-limit, std::min(limit, value));
+    }
+
+    /**
+     * @brief Rotation from the body frame to NED, ZYX Euler angles
+     */
+    void rotation(double roll, double pitch, double yaw, double r[3][3]) {
+        auto cr = std::cos(roll), sr = std::sin(roll);
+        auto cp = std::cos(pitch), sp = std::sin(pitch);
+        auto cy = std::cos(yaw), sy = std::sin(yaw);
+
+        r[0][0] = cy * cp;
+        r[0][1] = cy * sp * sr - sy * cr;
+        r[0][2] = cy * sp * cr + sy * sr;
+        r[1][0] = sy * cp;
+        r[1][1] = sy * sp * sr + cy * cr;
+        r[1][2] = sy * sp * cr - cy * sr;
+        r[2][0] = -sp;
+        r[2][1] = cp * sr;
+        r[2][2] = cp * cr;
+    }
+
+}
+
+VehicleModel::VehicleModel(const model_configuration_t& conf,
+                           const dof_array_t& state) {
+
+    m_conf = conf;
+
+    m_state = state;
+
+    m_set_point.fill(0);
+
+    m_controlled = 0;
+
+}
+
+void VehicleModel::set_set_point(const dof_array_t& set_point,
+                                 uint16_t controlled) {
+
+    m_set_point = set_point;
+
+    m_controlled = controlled;
+
+}
+
+void VehicleModel::step(double dt) {
+
+    auto& s = m_state;
+
+    auto is_controlled = [this](int dof) {
+        return (m_controlled >> dof) & 1;
+    };
+
+    /**
+     * Angular: orientation error commands a rate, else the rate set point.
+     */
+    auto k_rate = std::min(dt / m_conf.rate_time_constant, 1.0);
+
+    for(int i = 0 ; i < 3 ; i++) {
+        double desired = 0;
+        if(is_controlled(3 + i)) {
+            desired = std::remainder(m_set_point[3 + i] - s[3 + i], 2 * M_PI)
+                / m_conf.orientation_time_constant;
+        } else if(is_controlled(9 + i)) {
+            desired = m_set_point[9 + i];
+        }
+        desired = clamp(desired, m_conf.max_rate);
+
+        s[9 + i] += (desired - s[9 + i]) * k_rate;
+    }
+
+    /**
+     * Linear: body velocity set points, overridden by the position errors
+     * in NED.
+     */
+    double r[3][3];
+    rotation(s[3], s[4], s[5], r);
+
+    double body[3];
+    for(int i = 0 ; i < 3 ; i++) {
+        body[i] = is_controlled(6 + i) ? m_set_point[6 + i] : 0;
+    }
+
+    double ned[3];
+    for(int i = 0 ; i < 3 ; i++) {
+        ned[i] = r[i][0] * body[0] + r[i][1] * body[1] + r[i][2] * body[2];
+        if(is_controlled(i)) {
+            ned[i] = (m_set_point[i] - s[i]) / m_conf.position_time_constant;
+        }
+    }
+
+    auto k_velocity = std::min(dt / m_conf.velocity_time_constant, 1.0);
+
+    for(int i = 0 ; i < 3 ; i++) {
+        auto desired = clamp(
+            r[0][i] * ned[0] + r[1][i] * ned[1] + r[2][i] * ned[2],
+            m_conf.max_velocity);
+
+        s[6 + i] += (desired - s[6 + i]) * k_velocity;
+    }
+
+    /**
+     * Integrate
+     */
+    for(int i = 0 ; i < 3 ; i++) {
+        s[i] += (r[i][0] * s[6] + r[i][1] * s[7] + r[i][2] * s[8]) * dt;
+    }
+
+    s[3] = std::remainder(s[3] + s[9] * dt, 2 * M_PI);
+    s[4] = clamp(s[4] + s[10] * dt, M_PI_2);
+    s[5] = std::remainder(s[5] + s[11] * dt, 2 * M_PI);
+
+}
+
+dof_array_t VehicleModel::measure(const noise_configuration_t& noise,
+                                  std::mt19937& rng) const {
+
+    std::normal_distribution<double> normal;
+
+    const double deviation[4] = {
+        noise.position, noise.orientation, noise.velocity, noise.angular_rate
+    };
+
+    auto m = m_state;
+
+    for(size_t i = 0 ; i < m.size() ; i++) {
+        if(deviation[i / 3] > 0) {
+            m[i] += deviation[i / 3] * normal(rng);
+        }
+    }
+
+    m[3] = std::remainder(m[3], 2 * M_PI);
+    m[5] = std::remainder(m[5], 2 * M_PI);
+
+    return m;
+
+}